@@ -87,7 +87,8 @@ class AppDelegate : NSObject, NSApplicationDelegate {
 
         guard let device = MTLCreateSystemDefaultDevice(),
               let library = device.makeDefaultLibrary(),
-              let composition = Composition(device: device, bufferCount: maximumDrawableCount),
+              let composition = Composition(device: device, bufferCount: maximumDrawableCount,
+                                            asynchronous: true),
               let commandQueue = device.makeCommandQueue(),
               let renderer = Renderer(library: library, composition: composition,
                                       commandQueue: commandQueue) else {
@@ -105,6 +106,15 @@ class AppDelegate : NSObject, NSApplicationDelegate {
 
         window.contentView = contentView
 
+        // • Redraw whenever the hue worker publishes a newly solved composition
+        //
+        composition.updateHandler = { [weak contentView] in
+
+            DispatchQueue.main.async {
+                contentView?.needsDisplay = true
+            }
+        }
+
         NSLayoutConstraint.activate([
             contentView.widthAnchor.constraint(equalToConstant: 540),
             contentView.heightAnchor.constraint(equalToConstant: 598),
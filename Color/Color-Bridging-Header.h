@@ -18,3 +18,5 @@
 //
 
 #import <Composition/Composition.h>
+#import <Composition/FrameTracer.h>
+#import <Composition/HueGradientTable.h>
@@ -34,9 +34,26 @@
 - (nullable instancetype)initWithDevice:(nonnull id<MTLDevice>)device
                             bufferCount:(NSInteger)bufferCount;
 
+- (nullable instancetype)initWithDevice:(nonnull id<MTLDevice>)device
+                            bufferCount:(NSInteger)bufferCount
+                           asynchronous:(BOOL)asynchronous NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
+
 // • Properties
 //
 @property (nonatomic, readwrite) float hue;
+@property (nonatomic, readonly, getter=isAsynchronous) BOOL asynchronous;
+
+// • Hue of the buffer last returned by prepareCompositionBuffer (may lag hue
+//   in asynchronous mode)
+//
+@property (nonatomic, readonly) float preparedHue;
+
+// • Asynchronous mode: invoked on the hue worker thread whenever a newly
+//   solved composition is ready to be picked up by prepareCompositionBuffer
+//
+@property (atomic, copy, nullable) void (^updateHandler)(void);
 
 // • Methods
 //
@@ -19,9 +19,14 @@
 
 #import "Composition.h"
 #import "CompositionData.hpp"
+#import "HuePrefetcher.hpp"
+#import "HueUpdateWorker.hpp"
 
 #import <Graphics/Jzazbz.hpp>
+#import <Utilities/FrameTrace.hpp>
+#import <Utilities/Instrumentation.hpp>
 
+#import <memory>
 #import <numeric>
 
 //===------------------------------------------------------------------------===
@@ -32,9 +37,13 @@
 
 @implementation Composition
 {
-    NSArray<id<MTLBuffer>> *compositionBuffers;
-    NSInteger               compositionBufferIndex;
-    float                   nextHue;
+    NSArray<id<MTLBuffer>>          *compositionBuffers;
+    NSInteger                        compositionBufferIndex;
+    float                            nextHue;
+
+    std::unique_ptr<HuePrefetcher>   huePrefetcher;
+    std::unique_ptr<HueUpdateWorker> hueWorker;
+    uint64_t                         hueWorkerSequence;
 }
 
 //===------------------------------------------------------------------------===
@@ -44,6 +53,13 @@
 - (nullable instancetype)initWithDevice:(nonnull id<MTLDevice>)device
                             bufferCount:(NSInteger)bufferCount {
 
+    return [self initWithDevice:device bufferCount:bufferCount asynchronous:NO];
+}
+
+- (nullable instancetype)initWithDevice:(nonnull id<MTLDevice>)device
+                            bufferCount:(NSInteger)bufferCount
+                           asynchronous:(BOOL)asynchronous {
+
     self = [super init];
 
     if (nil != self) {
@@ -93,11 +109,40 @@
             memcpy( compositionBuffers[ib].contents, compositionBuffers[0].contents,
                    compositionBufferLength );
         }
+
+        // • Max-chroma colors are prefetched while the hue dial is scrubbed
+        //
+        huePrefetcher = std::make_unique<HuePrefetcher>();
+
+        // • Asynchronous mode: hue changes are solved on a worker thread
+        //
+        if (asynchronous) {
+
+            __weak Composition* weakSelf = self;
+
+            hueWorker = std::make_unique<HueUpdateWorker>( *composition, huePrefetcher.get(),
+                                                           [weakSelf]() {
+
+                if (auto updateHandler = weakSelf.updateHandler) {
+                    updateHandler();
+                }
+            });
+        }
+
+        hueWorkerSequence = 0;
     }
 
     return self;
 }
 
+- (void)dealloc {
+
+    // • The worker consults the prefetcher, so it must stop first
+    //
+    hueWorker.reset();
+    huePrefetcher.reset();
+}
+
 //===------------------------------------------------------------------------===
 #pragma mark - Properties
 //===------------------------------------------------------------------------===
@@ -107,6 +152,12 @@
     const auto reducedHue = fmodf(newHue, 360.0f);
 
     nextHue = (reducedHue < 0.0f) ? reducedHue + 360.0f : reducedHue;
+
+    huePrefetcher->observe(nextHue);
+
+    if (nullptr != hueWorker) {
+        hueWorker->request_hue( huePrefetcher->quantize(nextHue) );
+    }
 }
 
 - (float)hue {
@@ -114,6 +165,16 @@
     return nextHue;
 }
 
+- (BOOL)isAsynchronous {
+
+    return nullptr != hueWorker;
+}
+
+- (float)preparedHue {
+
+    return [self currentComposition]->hue;
+}
+
 //===------------------------------------------------------------------------===
 #pragma mark - Properties (Private)
 //===------------------------------------------------------------------------===
@@ -129,15 +190,29 @@
 
 - (nonnull id<MTLBuffer>)prepareCompositionBuffer {
 
+    INSTRUMENT_TIMER(prepare_composition);
+    TRACE_SPAN(prepare_composition);
+
+    if (nullptr != hueWorker) {
+        return [self prepareCompositionBufferFromWorker];
+    }
+
+    // • Rendered at the quantized hue, whose max chroma color is the exact
+    //   prefetched solve; the dial keeps its own continuous hue
+    //
+    const auto hue = huePrefetcher->quantize(nextHue);
+
     auto composition = [self currentComposition];
 
-    if (composition->hue != nextHue) {
+    if (composition->hue != hue) {
 
         compositionBufferIndex = (compositionBufferIndex + 1) % compositionBuffers.count;
         composition            = [self currentComposition];
 
-        composition->hue         = nextHue;
-        composition->max_c_color = jzazbz::find_max_chroma_color(nextHue);
+        composition->hue         = hue;
+        composition->max_c_color = huePrefetcher->find_max_chroma_color(hue);
+
+        INSTRUMENT_COUNT(hue_changes, 1);
     }
 
     return compositionBuffers[compositionBufferIndex];
@@ -157,4 +232,33 @@
     return CGRectMake(left, viewSize.height - bottom, right - left, bottom - top);
 }
 
+//===------------------------------------------------------------------------===
+#pragma mark - Methods (Private)
+//===------------------------------------------------------------------------===
+
+- (nonnull id<MTLBuffer>)prepareCompositionBufferFromWorker {
+
+    // • Pick up the most recently solved composition, if any, without waiting
+    //
+    const auto solved = hueWorker->acquire();
+
+    if (solved.sequence != hueWorkerSequence) {
+
+        compositionBufferIndex = (compositionBufferIndex + 1) % compositionBuffers.count;
+
+        auto composition = [self currentComposition];
+
+        composition->hue         = solved.data->hue;
+        composition->max_c_color = solved.data->max_c_color;
+
+        hueWorkerSequence = solved.sequence;
+
+        INSTRUMENT_COUNT(hue_changes, 1);
+    }
+
+    hueWorker->release(solved);
+
+    return compositionBuffers[compositionBufferIndex];
+}
+
 @end
@@ -0,0 +1,88 @@
+//
+//  DamageTracker.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/DamageTracker.hpp>
+
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    float wrapped_hue(float hue)
+    {
+        const auto wrapped = fmodf(hue, 360.0f);
+
+        return (wrapped < 0.0f) ? wrapped + 360.0f : wrapped;
+    }
+
+    bool same_layout(const CompositionData& lhs, const CompositionData& rhs)
+    {
+        return simd::all(lhs.grid_size == rhs.grid_size)
+            && lhs.jc_region       == rhs.jc_region
+            && lhs.gradient_region == rhs.gradient_region
+            && lhs.max_c_region    == rhs.max_c_region;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Update
+//===------------------------------------------------------------------------===
+
+DamageTracker::Damage DamageTracker::update(const CompositionData& composition, simd::uint2 size)
+{
+    auto damage = Damage{ .components = none, .pixels = {} };
+
+    if ( !previous_ || !simd::all(size == size_) || !same_layout(*previous_, composition) )
+    {
+        damage.components = jc | gradient | max_c | frame;
+        damage.pixels     = geometry::make_region_of_size(size);
+    }
+    else
+    {
+        const auto hue_changed   = wrapped_hue(previous_->hue) != wrapped_hue(composition.hue);
+        const auto color_changed = !simd::all(previous_->max_c_color == composition.max_c_color);
+
+        damage.components |= (hue_changed || color_changed) ? jc       : none;
+        damage.components |= (hue_changed)                  ? gradient : none;
+        damage.components |= (color_changed)                ? max_c    : none;
+
+        const auto add_region = [&](Component component, const geometry::Region rgn) {
+
+            if ( 0 != (damage.components & component) )
+            {
+                const auto rect = geometry::make_rectangle( geometry::make_device_rect(rgn, composition.grid_size), size );
+
+                damage.pixels |= geometry::make_covering_region(rect, size);
+            }
+        };
+
+        add_region(jc,       composition.jc_region);
+        add_region(gradient, composition.gradient_region);
+        add_region(max_c,    composition.max_c_region);
+    }
+
+    previous_ = composition;
+    size_     = size;
+
+    return damage;
+}
@@ -0,0 +1,77 @@
+//
+//  DamageTracker.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Composition/CompositionData.hpp>
+#include <Graphics/RegionSet.hpp>
+
+#include <optional>
+
+//===------------------------------------------------------------------------===
+//
+// • DamageTracker
+//
+//  Compares successive compositions and reports what must be redrawn. The
+//  layout is static between hue updates, so a hue change damages only the
+//  components whose inputs changed:
+//
+//  • jc_region         the hue direction of the background (hue mod 360) or
+//                      the max chroma color of the slice
+//  • gradient_region   the gradient offset (hue mod 360)
+//  • max_c_region      the max chroma color
+//
+//  Any change of grid, regions or output size damages the whole frame.
+//
+//===------------------------------------------------------------------------===
+
+class DamageTracker
+{
+public:
+
+    enum Component : uint32_t
+    {
+        none        = 0,
+        jc          = 1u << 0,
+        gradient    = 1u << 1,
+        max_c       = 1u << 2,
+        frame       = 1u << 3,  // everything, including outside the regions
+    };
+
+    struct Damage
+    {
+        uint32_t                components;
+        geometry::RegionSet     pixels;         // output pixels to redraw
+    };
+
+    // • Damage of `composition` at `size` since the previous update (the whole
+    //   frame on the first update or after invalidate())
+    //
+    Damage update(const CompositionData& composition, simd::uint2 size);
+
+    void invalidate(void) noexcept
+    {
+        previous_.reset();
+    }
+
+private:
+
+    std::optional<CompositionData>  previous_;
+    simd::uint2                     size_;
+};
@@ -0,0 +1,70 @@
+//
+//  FrameTracer.h
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+
+//===------------------------------------------------------------------------===
+//
+#pragma mark - Frame stages
+//
+//  Same values as instrumentation::Stage (Utilities/FrameTrace.hpp)
+//
+//===------------------------------------------------------------------------===
+
+typedef NS_ENUM(uint32_t, FrameStage) {
+    FrameStageFrame,
+    FrameStagePrepareComposition,
+    FrameStageVertexGeneration,
+    FrameStageTriangleSetup,
+    FrameStageShading,
+    FrameStageGPU,
+    FrameStageOutputEncoding
+};
+
+//===------------------------------------------------------------------------===
+//
+#pragma mark - FrameTracer Declaration
+//
+//  Swift access to the per-thread span rings. Recording does nothing unless
+//  the project is built with INSTRUMENTATION=1
+//
+//===------------------------------------------------------------------------===
+
+@interface FrameTracer : NSObject
+
+// • Host time in nanoseconds (mach_absolute_time, as trace_clock), the time
+//   base of Metal's gpuStartTime × 10⁹
+//
++ (uint64_t)now;
+
++ (void)recordStage:(FrameStage)stage begin:(uint64_t)begin end:(uint64_t)end
+    NS_SWIFT_NAME(record(_:begin:end:));
+
+// • Chrome trace JSON of every retained span
+//
++ (BOOL)writeChromeTraceToPath:(nonnull NSString *)path
+    NS_SWIFT_NAME(writeChromeTrace(to:));
+
+// • Count, mean, p50, p99 and max per stage, in milliseconds
+//
++ (nonnull NSString *)stageStatistics;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
+
+@end
@@ -0,0 +1,58 @@
+//
+//  FrameTracer.mm
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#import "FrameTracer.h"
+
+#import <Utilities/FrameTrace.hpp>
+
+static_assert( static_cast<uint32_t>(instrumentation::Stage::output_encoding) == FrameStageOutputEncoding,
+               "FrameStage must match instrumentation::Stage" );
+
+//===------------------------------------------------------------------------===
+//
+#pragma mark - FrameTracer Implementation
+//
+//===------------------------------------------------------------------------===
+
+@implementation FrameTracer
+
++ (uint64_t)now {
+
+    return instrumentation::trace_clock();
+}
+
++ (void)recordStage:(FrameStage)stage begin:(uint64_t)begin end:(uint64_t)end {
+
+    instrumentation::record_span(static_cast<instrumentation::Stage>(stage), begin, end);
+}
+
++ (BOOL)writeChromeTraceToPath:(nonnull NSString *)path {
+
+    return instrumentation::write_chrome_trace( path.fileSystemRepresentation, instrumentation::collect_spans() );
+}
+
++ (nonnull NSString *)stageStatistics {
+
+    const auto statistics = instrumentation::stage_statistics( instrumentation::collect_spans() );
+    const auto report     = instrumentation::format_stage_statistics(statistics);
+
+    return [NSString stringWithUTF8String:report.c_str()];
+}
+
+@end
@@ -0,0 +1,599 @@
+//
+//  HostRenderer.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/HostRenderer.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/FrameTrace.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    // • Standard 4x sample positions within a pixel
+    //
+    constexpr simd::float2 sample_positions[HostRenderer::sample_count] = {
+        { 0.375f, 0.125f },
+        { 0.875f, 0.375f },
+        { 0.125f, 0.625f },
+        { 0.625f, 0.875f }
+    };
+
+    constexpr auto clear_color = simd::float4{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+    constexpr bool contains(const geometry::Rectangle rect, simd::float2 point)
+    {
+        return rect.left <= point.x && point.x < rect.right
+            && rect.top  <= point.y && point.y < rect.bottom;
+    }
+
+    constexpr bool intersects(const geometry::Rectangle lhs, const geometry::Rectangle rhs)
+    {
+        return lhs.left < rhs.right && rhs.left < lhs.right
+            && lhs.top  < rhs.bottom && rhs.top < lhs.bottom;
+    }
+
+    float edge_function(simd::float2 a, simd::float2 b, simd::float2 p)
+    {
+        return (b.x - a.x)*(p.y - a.y) - (b.y - a.y)*(p.x - a.x);
+    }
+
+    simd::float3 barycentrics(const HostRenderer::Triangle& triangle, simd::float2 point)
+    {
+        const auto& p = triangle.position;
+
+        return simd::float3{
+            edge_function(p[1], p[2], point),
+            edge_function(p[2], p[0], point),
+            edge_function(p[0], p[1], point)
+        } * triangle.inverse_area;
+    }
+
+    bool covers(const HostRenderer::Triangle& triangle, simd::float2 point)
+    {
+        const auto l = barycentrics(triangle, point);
+
+        return 0.0f <= l[0] && 0.0f <= l[1] && 0.0f <= l[2];
+    }
+
+    // • Fragment output precision of the rgba16Float pipelines
+    //
+    simd::float4 fragment(simd::float3 lrgb)
+    {
+        return data::quantize_half( simd::float4{ lrgb[0], lrgb[1], lrgb[2], 1.0f } );
+    }
+
+    void store(simd::float4& pixel, simd::float4 color)
+    {
+        pixel = color;
+    }
+
+    void store(data::half4& pixel, simd::float4 color)
+    {
+        pixel = data::make_half4(color);
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+HostRenderer::HostRenderer(utilities::ThreadPool& pool, const Options& options)
+    : pool_        ( pool )
+    , options_     ( options )
+    , hue_gradient_( jzazbz::hue_gradient_chain_size(options.gradient.width) )
+    , slice_cache_ ( (0 < options.slice_cache.memory_budget)
+                         ? std::make_unique<jzazbz::SliceCache>(options.slice, options.slice_cache)
+                         : nullptr )
+    , frame_arena_ ( 64 * 1024 )
+{
+    // • One-time hue gradient mip chain (`generate_hue_gradient` and the
+    //   Jzazbz downsampling), stored at the precision of the rgba16Float
+    //   texture
+    //
+    jzazbz::generate_hue_gradient_mip_chain(hue_gradient_.data(), options_.gradient);
+
+    for (auto& texel : hue_gradient_)
+    {
+        texel = data::quantize_half(texel);
+    }
+
+    auto offset = size_t{ 0 };
+
+    for (uint32_t level = 0; level < jzazbz::hue_gradient_level_count(options_.gradient.width); ++level)
+    {
+        hue_gradient_levels_.push_back(offset);
+
+        offset += jzazbz::hue_gradient_level_width(options_.gradient.width, level);
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Rendering
+//===------------------------------------------------------------------------===
+
+void HostRenderer::render(const CompositionData& composition, data::ImageView<simd::float4> output)
+{
+    render_frame(composition, output);
+}
+
+void HostRenderer::render(const CompositionData& composition, data::ImageView<data::half4> output)
+{
+    render_frame(composition, output);
+}
+
+template <class Pixel_>
+void HostRenderer::render_frame(const CompositionData& composition, data::ImageView<Pixel_> output)
+{
+    TRACE_SPAN(frame);
+
+    const auto layout = make_layout( composition, output.size() );
+    const auto frame  = make_frame(composition, layout, frame_arena_);
+
+    {
+        TRACE_SPAN(shading);
+
+        pool_.parallel_for( layout.tile_count.x * layout.tile_count.y, [&](uint32_t tile) {
+
+            render_tile_pixels(layout, frame, tile, output);
+        });
+    }
+
+    frame_arena_.reset();
+}
+
+void HostRenderer::render(const CompositionData&        composition,
+                          const geometry::RegionSet&    damage,
+                          data::ImageView<simd::float4> output)
+{
+    render_damage(composition, damage, output);
+}
+
+void HostRenderer::render(const CompositionData&       composition,
+                          const geometry::RegionSet&   damage,
+                          data::ImageView<data::half4> output)
+{
+    render_damage(composition, damage, output);
+}
+
+template <class Pixel_>
+void HostRenderer::render_damage(const CompositionData&     composition,
+                                 const geometry::RegionSet& damage,
+                                 data::ImageView<Pixel_>    output)
+{
+    if ( damage.is_empty() )
+    {
+        return;
+    }
+
+    TRACE_SPAN(frame);
+
+    const auto layout = make_layout( composition, output.size() );
+    const auto frame  = make_frame(composition, layout, frame_arena_);
+
+    // • Only tiles touching the damage, clipped to each damaged rectangle
+    //
+    const auto tile_count = layout.tile_count.x * layout.tile_count.y;
+    const auto tiles      = frame_arena_.allocate<uint32_t>(tile_count);
+
+    auto damaged_count = uint32_t{ 0 };
+
+    for (uint32_t tile = 0; tile < tile_count; ++tile)
+    {
+        if ( damage.intersects( tile_region(layout, tile) ) )
+        {
+            tiles[damaged_count++] = tile;
+        }
+    }
+
+    {
+        TRACE_SPAN(shading);
+
+        pool_.parallel_for( damaged_count, [&](uint32_t it) {
+
+            const auto tile        = tiles[it];
+            const auto tile_bounds = tile_region(layout, tile);
+
+            for (const auto& rect : damage.rectangles())
+            {
+                if ( geometry::intersects(rect, tile_bounds) )
+                {
+                    render_tile_pixels(layout, frame, tile, output, 0, rect);
+                }
+            }
+        });
+    }
+
+    frame_arena_.reset();
+}
+
+void HostRenderer::render_strips(const CompositionData& composition, simd::uint2 size, const StripHandler& handler)
+{
+    TRACE_SPAN(frame);
+
+    const auto layout = make_layout(composition, size);
+    const auto frame  = make_frame(composition, layout, frame_arena_);
+
+    auto strip = data::Image<simd::float4>{ size.x, std::min(layout.tile_size, size.y) };
+
+    for (uint32_t ty = 0; ty < layout.tile_count.y; ++ty)
+    {
+        const auto top  = ty * layout.tile_size;
+        const auto rows = std::min(layout.tile_size, size.y - top);
+
+        {
+            TRACE_SPAN(shading);
+
+            pool_.parallel_for( layout.tile_count.x, [&](uint32_t tx) {
+
+                render_tile_pixels(layout, frame, ty * layout.tile_count.x + tx, strip.view(), top);
+            });
+        }
+
+        handler( top, strip.view().subview( geometry::make_region_of_size({ size.x, rows }) ) );
+    }
+
+    frame_arena_.reset();
+}
+
+//===------------------------------------------------------------------------===
+// • Layout
+//===------------------------------------------------------------------------===
+
+HostRenderer::Layout HostRenderer::make_layout(const CompositionData& composition, simd::uint2 size) const
+{
+    const auto tile_size = options_.tile_size;
+
+    // • Same device rects as the vertex functions, mapped through the viewport
+    //
+    const auto pixel_rect = [&](const geometry::Region rgn) {
+
+        return geometry::make_rectangle( geometry::make_device_rect(rgn, composition.grid_size), size );
+    };
+
+    return {
+        .size          = size,
+        .tile_count    = { (size.x + tile_size - 1) / tile_size, (size.y + tile_size - 1) / tile_size },
+        .tile_size     = tile_size,
+        .jc_rect       = pixel_rect(composition.jc_region),
+        .gradient_rect = pixel_rect(composition.gradient_region),
+        .max_c_rect    = pixel_rect(composition.max_c_region)
+    };
+}
+
+geometry::Region HostRenderer::tile_region(const Layout& layout, uint32_t tile) noexcept
+{
+    const auto tx = tile % layout.tile_count.x;
+    const auto ty = tile / layout.tile_count.x;
+
+    return {
+        .left   = tx * layout.tile_size,
+        .top    = ty * layout.tile_size,
+        .right  = std::min( (tx + 1) * layout.tile_size, layout.size.x ),
+        .bottom = std::min( (ty + 1) * layout.tile_size, layout.size.y )
+    };
+}
+
+//===------------------------------------------------------------------------===
+// • Frame
+//===------------------------------------------------------------------------===
+
+HostRenderer::Frame HostRenderer::make_frame(const CompositionData& composition,
+                                             const Layout&          layout,
+                                             data::Arena&           arena) const
+{
+    // • Gamut slice vertices (`generate_vertices`)
+    //
+    const auto& adaptive    = options_.adaptive_slice;
+    const auto  is_adaptive = 0.0f < adaptive.error_budget;
+    const auto  capacity    = is_adaptive ? jzazbz::slice_vertex_count( std::max({ adaptive.max_band_count, adaptive.initial_band_count, 1u }) )
+                                          : jzazbz::slice_vertex_count(options_.slice);
+    const auto  vertices    = arena.allocate<simd::float4>(capacity);
+
+    auto vertex_count = capacity;
+
+    {
+        TRACE_SPAN(vertex_generation);
+
+        if (is_adaptive)
+        {
+            vertex_count = jzazbz::generate_adaptive_slice_vertices(composition.max_c_color, vertices, adaptive, options_.slice);
+        }
+        else if (slice_cache_)
+        {
+            slice_cache_->find_slice_vertices(composition.hue, composition.max_c_color, vertices);
+        }
+        else
+        {
+            jzazbz::generate_slice_vertices(composition.max_c_color, vertices, options_.slice);
+        }
+    }
+
+    TRACE_SPAN(triangle_setup);
+
+    // • Vertex positions (`foreground_vertex`)
+    //
+    constexpr auto y_max = 0.16717463103478347f;
+    constexpr auto c_max = 0.1796875f;
+    constexpr auto dcy   = 0.5f * (c_max - y_max);
+
+    const auto& jc_rect  = layout.jc_rect;
+    const auto positions = arena.allocate<simd::float2>(vertex_count);
+
+    for (uint32_t iv = 0; iv < vertex_count; ++iv)
+    {
+        const auto v = vertices[iv];
+        const auto y = (v[0] + dcy) / c_max;
+        const auto C = sqrtf(v[1]*v[1] + v[2]*v[2]) / c_max;
+
+        positions[iv] = simd::float2{
+            jc_rect.left   + C*(jc_rect.right - jc_rect.left),
+            jc_rect.bottom + y*(jc_rect.top   - jc_rect.bottom)
+        };
+    }
+
+    // • Triangle strip, dropping degenerate triangles
+    //
+    const auto triangles      = arena.allocate<Triangle>(vertex_count - 2);
+    auto       triangle_count = uint32_t{ 0 };
+
+    for (uint32_t it = 0; it + 2 < vertex_count; ++it)
+    {
+        const simd::float2 p[3] = { positions[it], positions[it+1], positions[it+2] };
+
+        const auto area = edge_function(p[0], p[1], p[2]);
+
+        if (fabsf(area) < 1.0e-6f)
+        {
+            continue;
+        }
+
+        auto& triangle = triangles[triangle_count++];
+
+        for (auto ic = 0; ic < 3; ++ic)
+        {
+            triangle.position[ic] = p[ic];
+            triangle.jab[ic]      = vertices[it + ic].xyz;
+        }
+
+        triangle.bounds = {
+            .left   = std::min({ p[0].x, p[1].x, p[2].x }),
+            .top    = std::min({ p[0].y, p[1].y, p[2].y }),
+            .right  = std::max({ p[0].x, p[1].x, p[2].x }) + 1.0f,
+            .bottom = std::max({ p[0].y, p[1].y, p[2].y }) + 1.0f
+        };
+
+        triangle.inverse_area = 1.0f / area;
+    }
+
+    // • Bin triangles by tile
+    //
+    const auto tile_count  = layout.tile_count.x * layout.tile_count.y;
+    const auto bin_offsets = arena.allocate<uint32_t>(tile_count + 1);
+
+    auto bin_count = uint32_t{ 0 };
+
+    for (uint32_t tile = 0; tile < tile_count; ++tile)
+    {
+        const auto tile_rect = geometry::make_rectangle( tile_region(layout, tile) );
+
+        bin_offsets[tile] = bin_count;
+
+        for (uint32_t it = 0; it < triangle_count; ++it)
+        {
+            bin_count += intersects(triangles[it].bounds, tile_rect) ? 1 : 0;
+        }
+    }
+
+    bin_offsets[tile_count] = bin_count;
+
+    const auto bins = arena.allocate<uint16_t>( std::max(bin_count, 1u) );
+
+    for (uint32_t tile = 0, ib = 0; tile < tile_count; ++tile)
+    {
+        const auto tile_rect = geometry::make_rectangle( tile_region(layout, tile) );
+
+        for (uint32_t it = 0; it < triangle_count; ++it)
+        {
+            if ( intersects(triangles[it].bounds, tile_rect) )
+            {
+                bins[ib++] = static_cast<uint16_t>(it);
+            }
+        }
+    }
+
+    // • Max chroma swatch color (`max_c_vertex`)
+    //
+    const auto hue_radians = composition.hue * static_cast<float>(M_PI) / 180.0f;
+
+    return {
+        .hue            = composition.hue,
+        .max_c_color    = fragment( jzazbz::convert_to_linear_display_P3(composition.max_c_color) ),
+        .chroma_scale   = { cosf(hue_radians), sinf(hue_radians) },
+        .triangles      = triangles,
+        .triangle_count = triangle_count,
+        .bin_offsets    = bin_offsets,
+        .bins           = bins
+    };
+}
+
+//===------------------------------------------------------------------------===
+// • Tiles
+//===------------------------------------------------------------------------===
+
+void HostRenderer::render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                               data::ImageView<simd::float4> output) const
+{
+    render_tile_pixels(layout, frame, tile, output);
+}
+
+void HostRenderer::render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                               data::ImageView<data::half4> output) const
+{
+    render_tile_pixels(layout, frame, tile, output);
+}
+
+void HostRenderer::render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                               geometry::Region clip, data::ImageView<simd::float4> output) const
+{
+    render_tile_pixels(layout, frame, tile, output, 0, clip);
+}
+
+void HostRenderer::render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                               geometry::Region clip, data::ImageView<data::half4> output) const
+{
+    render_tile_pixels(layout, frame, tile, output, 0, clip);
+}
+
+template <class Pixel_>
+void HostRenderer::render_tile_pixels(const Layout& layout, const Frame& frame, uint32_t tile,
+                                      data::ImageView<Pixel_> output, uint32_t top,
+                                      geometry::Region clip) const
+{
+    const auto region    = geometry::intersection( tile_region(layout, tile), clip );
+    const auto bin_begin = frame.bin_offsets[tile];
+    const auto bin_end   = frame.bin_offsets[tile + 1];
+
+    for (auto y = region.top; y < region.bottom; ++y)
+    {
+        auto row = output.row(y - top);
+
+        for (auto x = region.left; x < region.right; ++x)
+        {
+            const auto pixel  = geometry::make_float2( simd::uint2{ x, y } );
+            const auto center = pixel + 0.5f;
+
+            // • Fragments are shaded once per pixel and primitive, at the pixel
+            //   center; depth order is foreground, gradient, then background
+            //   and the max chroma swatch
+            //
+            auto shaded_triangle = uint32_t{ 0xffff'ffffu };
+            auto shaded_color    = clear_color;
+            auto sum             = simd::float4{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+            for (const auto offset : sample_positions)
+            {
+                const auto sample = pixel + offset;
+                auto       color  = clear_color;
+                auto       hit    = false;
+
+                for (auto ib = bin_begin; ib < bin_end && !hit; ++ib)
+                {
+                    const auto  it       = frame.bins[ib];
+                    const auto& triangle = frame.triangles[it];
+
+                    if ( !covers(triangle, sample) )
+                    {
+                        continue;
+                    }
+
+                    if (it != shaded_triangle)
+                    {
+                        // • `foreground_fragment`
+                        //
+                        const auto l   = barycentrics(triangle, center);
+                        const auto jab = l[0]*triangle.jab[0] + l[1]*triangle.jab[1] + l[2]*triangle.jab[2];
+
+                        shaded_triangle = it;
+                        shaded_color    = fragment( jzazbz::convert_to_linear_display_P3(jab) );
+                    }
+
+                    color = shaded_color;
+                    hit   = true;
+                }
+
+                if (!hit && contains(layout.gradient_rect, sample))
+                {
+                    // • `hue_gradient_vertex` / `hue_gradient_fragment`
+                    //
+                    const auto& rect      = layout.gradient_rect;
+                    const auto  xu        = (center.x - rect.left) / (rect.right - rect.left);
+                    const auto  tex_coord = fmodf(frame.hue, 360.0f) * (1.0f/360.0f) + (xu - 0.5f);
+                    const auto  lod       = log2f( static_cast<float>(options_.gradient.width) / (rect.right - rect.left) );
+
+                    color = sample_hue_gradient(tex_coord, lod);
+                }
+                else if (!hit && contains(layout.jc_rect, sample))
+                {
+                    // • `background_vertex` / `background_fragment`
+                    //
+                    constexpr auto Cmin = 0.024f/3.0f;
+
+                    const auto& rect = layout.jc_rect;
+                    const auto  xu   = (center.x - rect.left) / (rect.right - rect.left);
+                    const auto  yu   = (rect.bottom - center.y) / (rect.bottom - rect.top);
+                    const auto  Jz   = 0.032608401221558024f + yu*(0.12133886641726202f - 0.032608401221558024f);
+                    const auto  Cd   = (0.024f + yu*(0.058f - 0.024f)) - Cmin;
+                    const auto  a    = Cmin + Cd * frame.chroma_scale.x * xu;
+                    const auto  b    = Cmin + Cd * frame.chroma_scale.y * xu;
+
+                    color = fragment( jzazbz::convert_to_linear_display_P3({ Jz, a, b }) );
+                }
+                else if (!hit && contains(layout.max_c_rect, sample))
+                {
+                    color = frame.max_c_color;
+                }
+
+                sum += color;
+            }
+
+            // • Multisample resolve into the rgba16Float target
+            //
+            store( row[x], data::quantize_half(sum / static_cast<float>(sample_count)) );
+        }
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Hue gradient sampling (normalized, repeat, linear, linear mip filter)
+//===------------------------------------------------------------------------===
+
+simd::float4 HostRenderer::sample_hue_gradient(float tex_coord, float lod) const noexcept
+{
+    const auto max_level = static_cast<float>(hue_gradient_levels_.size() - 1);
+    const auto clamped   = std::clamp(lod, 0.0f, max_level);
+    const auto level     = static_cast<uint32_t>(clamped);
+    const auto t         = clamped - static_cast<float>(level);
+    const auto upper     = sample_hue_gradient_level(tex_coord, level);
+
+    if (0.0f == t)
+    {
+        return upper;
+    }
+
+    return upper + t*(sample_hue_gradient_level(tex_coord, level + 1) - upper);
+}
+
+simd::float4 HostRenderer::sample_hue_gradient_level(float tex_coord, uint32_t level) const noexcept
+{
+    const auto texels = hue_gradient_.data() + hue_gradient_levels_[level];
+    const auto width  = static_cast<int32_t>( jzazbz::hue_gradient_level_width(options_.gradient.width, level) );
+    const auto u      = tex_coord * static_cast<float>(width) - 0.5f;
+    const auto u0     = floorf(u);
+    const auto t      = u - u0;
+    const auto i0     = ( (static_cast<int32_t>(u0) % width) + width ) % width;
+    const auto i1     = (i0 + 1) % width;
+
+    return texels[i0] + t*(texels[i1] - texels[i0]);
+}
@@ -0,0 +1,253 @@
+//
+//  HostRenderer.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Composition/CompositionData.hpp>
+#include <Data/Arena.hpp>
+#include <Data/Half.hpp>
+#include <Data/Image.hpp>
+#include <Graphics/GamutSlice.hpp>
+#include <Graphics/Geometry.hpp>
+#include <Graphics/HueGradient.hpp>
+#include <Graphics/RegionSet.hpp>
+#include <Graphics/SliceCache.hpp>
+#include <Utilities/ThreadPool.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • HostRenderer
+//
+//  Headless CPU counterpart of Renderer.draw: the background Jz/Cz plane, the
+//  foreground gamut slice, the hue gradient strip and the max-chroma swatch,
+//  with 4x multisampling and rgba16Float precision, into linear Display P3
+//  images of any size. Tiles are rendered in parallel.
+//
+//  Rendering is split into hue-independent state (the hue gradient table,
+//  owned by the renderer, and the Layout for an output size) and per-hue
+//  state (the Frame), so that callers rendering many hues can share the
+//  former.
+//
+//===------------------------------------------------------------------------===
+
+class HostRenderer
+{
+public:
+
+    struct Options
+    {
+        uint32_t                        tile_size;
+        jzazbz::SliceParameters         slice;
+        jzazbz::HueGradientParameters   gradient;
+
+        // • Adaptive slice bands when error_budget is positive; uniform bands
+        //   (as `generate_vertices`) otherwise. Off by default so that the
+        //   output matches the GPU, which has no adaptive path
+        //
+        jzazbz::AdaptiveSliceParameters adaptive_slice;
+
+        // • Uniform slices come from a SliceCache keyed by composition hue
+        //   when memory_budget is positive
+        //
+        jzazbz::SliceCache::Parameters  slice_cache;
+    };
+
+    static constexpr Options default_options = {
+        .tile_size      = 64,
+        .slice          = jzazbz::default_slice_parameters,
+        .gradient       = jzazbz::default_hue_gradient_parameters,
+        .adaptive_slice = { .error_budget = 0.0f, .initial_band_count = 0, .max_band_count = 0 },
+        .slice_cache    = { .step = 0.25f, .memory_budget = 0, .interpolate = true }
+    };
+
+    enum : uint32_t
+    {
+        sample_count = 4
+    };
+
+    //===--------------------------------------------------------------------===
+    // • Layout (hue-independent, per output size)
+    //===--------------------------------------------------------------------===
+
+    struct Layout
+    {
+        simd::uint2             size;
+        simd::uint2             tile_count;
+        uint32_t                tile_size;
+
+        // • Pixel-space rectangles (top-down)
+        //
+        geometry::Rectangle     jc_rect;
+        geometry::Rectangle     gradient_rect;
+        geometry::Rectangle     max_c_rect;
+    };
+
+    //===--------------------------------------------------------------------===
+    // • Frame (per hue)
+    //===--------------------------------------------------------------------===
+
+    struct Triangle
+    {
+        simd::float2            position[3];    // pixel space
+        simd::float3            jab[3];
+        geometry::Rectangle     bounds;
+        float                   inverse_area;   // signed
+    };
+
+    struct Frame
+    {
+        float                   hue;
+        simd::float4            max_c_color;    // resolved swatch color
+        simd::float2            chroma_scale;   // (cospi, sinpi) of the hue
+
+        const Triangle*         triangles;
+        uint32_t                triangle_count;
+
+        // • Per-tile triangle lists: tile t uses bins[bin_offsets[t] ..< bin_offsets[t+1]]
+        //
+        const uint32_t*         bin_offsets;
+        const uint16_t*         bins;
+    };
+
+    //===--------------------------------------------------------------------===
+    // • Initialization
+    //===--------------------------------------------------------------------===
+
+    explicit HostRenderer(utilities::ThreadPool& pool    = utilities::ThreadPool::shared(),
+                          const Options&         options = default_options);
+
+    HostRenderer(const HostRenderer&) = delete;
+    HostRenderer& operator = (const HostRenderer&) = delete;
+
+    //===--------------------------------------------------------------------===
+    // • Rendering
+    //===--------------------------------------------------------------------===
+
+    void render(const CompositionData& composition, data::ImageView<simd::float4> output);
+    void render(const CompositionData& composition, data::ImageView<data::half4>  output);
+
+    // • Redraw only the pixels of `damage`, leaving the rest of `output` as is
+    //
+    void render(const CompositionData& composition, const geometry::RegionSet& damage,
+                data::ImageView<simd::float4> output);
+
+    void render(const CompositionData& composition, const geometry::RegionSet& damage,
+                data::ImageView<data::half4> output);
+
+    // • Render an image of `size` one row of tiles at a time, handing each
+    //   strip to `handler` (top to bottom, on the calling thread) without
+    //   holding the full image. The strip is only valid during the call
+    //
+    using StripHandler = std::function<void (uint32_t top, data::ImageView<simd::float4> strip)>;
+
+    void render_strips(const CompositionData& composition, simd::uint2 size, const StripHandler& handler);
+
+    //===--------------------------------------------------------------------===
+    // • Rendering stages
+    //===--------------------------------------------------------------------===
+
+    Layout make_layout(const CompositionData& composition, simd::uint2 size) const;
+
+    // • Frame storage is allocated from `arena` and valid until its next reset
+    //
+    Frame make_frame(const CompositionData& composition,
+                     const Layout&          layout,
+                     data::Arena&           arena) const;
+
+    void render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                     data::ImageView<simd::float4> output) const;
+
+    void render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                     data::ImageView<data::half4> output) const;
+
+    // • Only the pixels of `tile` within `clip`
+    //
+    void render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                     geometry::Region clip, data::ImageView<simd::float4> output) const;
+
+    void render_tile(const Layout& layout, const Frame& frame, uint32_t tile,
+                     geometry::Region clip, data::ImageView<data::half4> output) const;
+
+    // • Tile region in output pixels
+    //
+    static geometry::Region tile_region(const Layout& layout, uint32_t tile) noexcept;
+
+    //===--------------------------------------------------------------------===
+    // • Properties
+    //===--------------------------------------------------------------------===
+
+    const Options& options(void) const noexcept
+    {
+        return options_;
+    }
+
+    utilities::ThreadPool& pool(void) const noexcept
+    {
+        return pool_;
+    }
+
+    // • nullptr unless enabled by Options::slice_cache
+    //
+    const jzazbz::SliceCache* slice_cache(void) const noexcept
+    {
+        return slice_cache_.get();
+    }
+
+private:
+
+    template <class Pixel_>
+    void render_frame(const CompositionData& composition, data::ImageView<Pixel_> output);
+
+    template <class Pixel_>
+    void render_damage(const CompositionData& composition, const geometry::RegionSet& damage,
+                       data::ImageView<Pixel_> output);
+
+    // • `output` rows start at layout row `top`
+    //
+    template <class Pixel_>
+    void render_tile_pixels(const Layout& layout, const Frame& frame, uint32_t tile,
+                            data::ImageView<Pixel_> output, uint32_t top = 0,
+                            geometry::Region clip = unclipped) const;
+
+    static constexpr geometry::Region unclipped = {
+        .left = 0, .top = 0, .right = UINT32_MAX, .bottom = UINT32_MAX
+    };
+
+    // • Trilinear, as the mipmapped texture: `lod` is log2 of texels per pixel
+    //
+    simd::float4 sample_hue_gradient(float tex_coord, float lod) const noexcept;
+    simd::float4 sample_hue_gradient_level(float tex_coord, uint32_t level) const noexcept;
+
+    utilities::ThreadPool&      pool_;
+    const Options               options_;
+
+    // • Hue gradient mip chain, rounded to half precision, and the offset of
+    //   each level
+    //
+    std::vector<simd::float4>   hue_gradient_;
+    std::vector<size_t>         hue_gradient_levels_;
+
+    std::unique_ptr<jzazbz::SliceCache> slice_cache_;
+
+    data::Arena                 frame_arena_;
+};
@@ -0,0 +1,48 @@
+//
+//  HueGradientTable.h
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
+
+//===------------------------------------------------------------------------===
+//
+#pragma mark - HueGradientTable Declaration
+//
+//  Host-generated hue gradient mip chain: the max-chroma color at every
+//  texel of level 0 and coarser levels filtered in Jzazbz (Graphics/
+//  HueGradient.hpp), for a 2D rgba16Float texture one texel high
+//
+//===------------------------------------------------------------------------===
+
+@interface HueGradientTable : NSObject
+
+// • Full chain down to one texel, as Metal allocates mip levels
+//
++ (NSUInteger)levelCountForWidth:(NSUInteger)width
+    NS_SWIFT_NAME(levelCount(forWidth:));
+
+// • Generate the chain for texture.width and replace every level the texture
+//   has. The texture must be rgba16Float and CPU-accessible
+//
++ (BOOL)fillTexture:(nonnull id<MTLTexture>)texture accuracy:(float)accuracy
+    NS_SWIFT_NAME(fill(_:accuracy:));
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
+
+@end
@@ -0,0 +1,84 @@
+//
+//  HueGradientTable.mm
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#import "HueGradientTable.h"
+
+#import <Data/Half.hpp>
+#import <Graphics/HueGradient.hpp>
+
+#import <vector>
+
+//===------------------------------------------------------------------------===
+//
+#pragma mark - HueGradientTable Implementation
+//
+//===------------------------------------------------------------------------===
+
+@implementation HueGradientTable
+
++ (NSUInteger)levelCountForWidth:(NSUInteger)width {
+
+    return jzazbz::hue_gradient_level_count( static_cast<uint32_t>(width) );
+}
+
++ (BOOL)fillTexture:(nonnull id<MTLTexture>)texture accuracy:(float)accuracy {
+
+    if (MTLPixelFormatRGBA16Float != texture.pixelFormat || MTLStorageModePrivate == texture.storageMode)
+    {
+        return NO;
+    }
+
+    auto parameters = jzazbz::default_hue_gradient_parameters;
+
+    parameters.width    = static_cast<uint32_t>(texture.width);
+    parameters.accuracy = accuracy;
+
+    auto texels = std::vector<simd::float4>( jzazbz::hue_gradient_chain_size(parameters.width) );
+
+    jzazbz::generate_hue_gradient_mip_chain(texels.data(), parameters);
+
+    // • Level by level at half precision
+    //
+    const auto level_count = std::min( static_cast<uint32_t>(texture.mipmapLevelCount),
+                                       jzazbz::hue_gradient_level_count(parameters.width) );
+
+    auto row    = std::vector<data::half4>(parameters.width);
+    auto source = texels.data();
+
+    for (uint32_t level = 0; level < level_count; ++level)
+    {
+        const auto width = jzazbz::hue_gradient_level_width(parameters.width, level);
+
+        for (uint32_t i = 0; i < width; ++i)
+        {
+            row[i] = data::make_half4(source[i]);
+        }
+
+        [texture replaceRegion:MTLRegionMake2D(0, 0, width, 1)
+                   mipmapLevel:level
+                     withBytes:row.data()
+                   bytesPerRow:width * sizeof(data::half4)];
+
+        source += width;
+    }
+
+    return YES;
+}
+
+@end
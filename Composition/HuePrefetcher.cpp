@@ -0,0 +1,314 @@
+//
+//  HuePrefetcher.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/HuePrefetcher.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/Instrumentation.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    float reduce_hue(float hue)
+    {
+        const auto reduced = fmodf(hue, 360.0f);
+
+        return (reduced < 0.0f) ? reduced + 360.0f : reduced;
+    }
+
+    float hue_delta(float from, float to)
+    {
+        // • Shortest signed angular distance in [-180, 180)
+        //
+        return reduce_hue(to - from + 180.0f) - 180.0f;
+    }
+
+    float edge_key(float hue)
+    {
+        // • Display P3 gamut edge along which `hue` lies (hue of its lower corner)
+        //
+        const auto reduced    = reduce_hue(hue);
+        const auto target_hue = (reduced < 180.0f) ? reduced : reduced - 360.0f;
+
+        return jzazbz::find_max_chroma_edge_P3(target_hue).lower.w;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+HuePrefetcher::HuePrefetcher(const Parameters& parameters)
+    : parameters_( parameters )
+    , last_hue_  ( 0.0f )
+    , last_time_ ()
+    , hue_       ( 0.0f )
+    , velocity_  ( 0.0f )
+    , generation_( 0 )
+    , stopping_  ( false )
+{
+    for (auto& entry : entries_)
+    {
+        entry.version.store(0, std::memory_order_relaxed);
+        entry.tag.store(empty_tag, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread( [this] { run(); } );
+}
+
+HuePrefetcher::~HuePrefetcher()
+{
+    stopping_.store(true, std::memory_order_relaxed);
+
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_one();
+
+    thread_.join();
+}
+
+//===------------------------------------------------------------------------===
+// • Observation
+//===------------------------------------------------------------------------===
+
+void HuePrefetcher::observe(float hue) noexcept
+{
+    const auto now      = Clock::now();
+    const auto reduced  = reduce_hue(hue);
+    const auto interval = std::chrono::duration<float>(now - last_time_).count();
+
+    auto velocity = velocity_.load(std::memory_order_relaxed);
+
+    if (parameters_.idle_interval < interval)
+    {
+        // • A new drag: no motion history yet
+        //
+        velocity = 0.0f;
+    }
+    else if (0.0f < interval)
+    {
+        // • Exponentially smoothed instantaneous velocity
+        //
+        const auto instantaneous = hue_delta(last_hue_, reduced) / interval;
+
+        velocity = 0.5f * (velocity + instantaneous);
+    }
+
+    last_hue_  = reduced;
+    last_time_ = now;
+
+    hue_.store(reduced, std::memory_order_relaxed);
+    velocity_.store(velocity, std::memory_order_relaxed);
+
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_one();
+}
+
+//===------------------------------------------------------------------------===
+// • Lookup
+//===------------------------------------------------------------------------===
+
+float HuePrefetcher::quantize(float hue) const noexcept
+{
+    const auto index = static_cast<uint32_t>( lroundf(reduce_hue(hue) / parameters_.step) ) % quantized_count();
+
+    return static_cast<float>(index) * parameters_.step;
+}
+
+std::optional<simd::float3> HuePrefetcher::lookup(float hue) const noexcept
+{
+    const auto count   = quantized_count();
+    const auto reduced = reduce_hue(hue);
+
+    // • On a quantized hue: the cached solve itself
+    //
+    const auto nearest = static_cast<uint32_t>( lroundf(reduced / parameters_.step) ) % count;
+
+    if ( static_cast<float>(nearest) * parameters_.step == reduced )
+    {
+        auto color = simd::float3{};
+
+        if ( !load(nearest, color) )
+        {
+            return std::nullopt;
+        }
+
+        return color;
+    }
+
+    if (!parameters_.interpolate)
+    {
+        return std::nullopt;
+    }
+
+    const auto x       = reduced / parameters_.step;
+    const auto lower_x = floorf(x);
+    const auto t       = x - lower_x;
+    const auto i0      = static_cast<uint32_t>(lower_x) % count;
+    const auto i1      = (i0 + 1) % count;
+
+    // • Interpolation is only valid along a single gamut edge
+    //
+    const auto lower_hue = static_cast<float>(i0) * parameters_.step;
+
+    if ( edge_key(lower_hue) != edge_key(lower_hue + parameters_.step) )
+    {
+        return std::nullopt;
+    }
+
+    auto lower = simd::float3{};
+    auto upper = simd::float3{};
+
+    if ( !load(i0, lower) || !load(i1, upper) )
+    {
+        return std::nullopt;
+    }
+
+    return lower + t*(upper - lower);
+}
+
+simd::float3 HuePrefetcher::find_max_chroma_color(float hue) const
+{
+    if (const auto cached = lookup(hue))
+    {
+        INSTRUMENT_COUNT(prefetch_hits, 1);
+
+        return *cached;
+    }
+
+    INSTRUMENT_COUNT(prefetch_misses, 1);
+
+    return jzazbz::find_max_chroma_color( reduce_hue(hue) );
+}
+
+//===------------------------------------------------------------------------===
+// • Cache
+//===------------------------------------------------------------------------===
+
+uint32_t HuePrefetcher::quantized_count(void) const noexcept
+{
+    return static_cast<uint32_t>( lroundf(360.0f / parameters_.step) );
+}
+
+bool HuePrefetcher::load(uint32_t index, simd::float3& color) const noexcept
+{
+    const auto& entry = entries_[index % capacity];
+
+    const auto version = entry.version.load(std::memory_order_acquire);
+
+    if (0 != (version & 1))
+    {
+        return false;
+    }
+
+    const auto tag = entry.tag.load(std::memory_order_relaxed);
+
+    color = {
+        entry.color[0].load(std::memory_order_relaxed),
+        entry.color[1].load(std::memory_order_relaxed),
+        entry.color[2].load(std::memory_order_relaxed)
+    };
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return tag == index && version == entry.version.load(std::memory_order_relaxed);
+}
+
+void HuePrefetcher::store(uint32_t index, simd::float3 color) noexcept
+{
+    // • Single writer (prefetch thread)
+    //
+    auto& entry = entries_[index % capacity];
+
+    const auto version = entry.version.load(std::memory_order_relaxed);
+
+    entry.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.tag.store(index, std::memory_order_relaxed);
+    entry.color[0].store(color[0], std::memory_order_relaxed);
+    entry.color[1].store(color[1], std::memory_order_relaxed);
+    entry.color[2].store(color[2], std::memory_order_relaxed);
+
+    entry.version.store(version + 2, std::memory_order_release);
+}
+
+//===------------------------------------------------------------------------===
+// • Prefetch thread
+//===------------------------------------------------------------------------===
+
+void HuePrefetcher::run(void)
+{
+    const auto count = static_cast<int32_t>( quantized_count() );
+
+    auto seen_generation = uint32_t{ 0 };
+
+    for (;;)
+    {
+        generation_.wait(seen_generation, std::memory_order_acquire);
+
+        if ( stopping_.load(std::memory_order_relaxed) )
+        {
+            return;
+        }
+
+        seen_generation = generation_.load(std::memory_order_acquire);
+
+        // • Quantized hues from the current bracket to the predicted hue, in
+        //   the direction of motion
+        //
+        const auto hue       = hue_.load(std::memory_order_relaxed);
+        const auto velocity  = velocity_.load(std::memory_order_relaxed);
+        const auto predicted = hue + velocity * parameters_.lookahead;
+
+        const auto first     = static_cast<int32_t>( floorf(hue / parameters_.step) );
+        const auto last      = static_cast<int32_t>( floorf(predicted / parameters_.step) );
+        const auto direction = (last < first) ? -1 : 1;
+        const auto span      = std::min( std::abs(last - first) + 2,
+                                         static_cast<int32_t>(max_prefetches) );
+
+        for (auto ip = 0; ip < span; ++ip)
+        {
+            // • Start over from the newest observation as soon as there is one
+            //
+            if ( seen_generation != generation_.load(std::memory_order_relaxed) )
+            {
+                break;
+            }
+
+            // • The bracket around the current hue comes first (first, first+1),
+            //   then onward in the direction of motion
+            //
+            const auto offset = (ip < 2 || 0 < direction) ? ip : 1 - ip;
+            const auto index  = static_cast<uint32_t>( ((first + offset) % count + count) % count );
+
+            auto cached = simd::float3{};
+
+            if ( !load(index, cached) )
+            {
+                store( index, jzazbz::find_max_chroma_color(static_cast<float>(index) * parameters_.step) );
+            }
+        }
+    }
+}
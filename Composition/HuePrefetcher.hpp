@@ -0,0 +1,141 @@
+//
+//  HuePrefetcher.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <simd/simd.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+//===------------------------------------------------------------------------===
+//
+// • HuePrefetcher
+//
+//  Predicts where the hue dial is heading while it is being scrubbed and
+//  solves the max-chroma color ahead of time on a background thread.
+//
+//  Results are stored at quantized hues (`step` degrees apart) in a small
+//  direct-mapped cache. Callers quantize the hue they render (quantize) and
+//  get back the exact solve at it. With `interpolate` set, a lookup between
+//  quantized hues also succeeds when both bracketing hues are cached and lie
+//  on the same Display P3 gamut edge, blending the two; the blend is not
+//  covered by the golden reference bounds, so it is off by default.
+//
+//===------------------------------------------------------------------------===
+
+class HuePrefetcher
+{
+public:
+
+    struct Parameters
+    {
+        float   step;           // quantization step in degrees
+        float   lookahead;      // prediction horizon in seconds (a few frames)
+        float   idle_interval;  // gap in seconds after which velocity resets
+        bool    interpolate;    // blend solves between quantized hues
+    };
+
+    static constexpr Parameters default_parameters = {
+        .step          = 0.25f,
+        .lookahead     = 4.0f / 60.0f,
+        .idle_interval = 0.1f,
+        .interpolate   = false
+    };
+
+    // • Initialization
+    //
+    explicit HuePrefetcher(const Parameters& parameters = default_parameters);
+    ~HuePrefetcher();
+
+    HuePrefetcher(const HuePrefetcher&) = delete;
+    HuePrefetcher& operator = (const HuePrefetcher&) = delete;
+
+    // • Record a hue change (dial event). Updates the velocity estimate and
+    //   wakes the prefetch thread
+    //
+    void observe(float hue) noexcept;
+
+    // • Nearest quantized hue, in [0, 360)
+    //
+    float quantize(float hue) const noexcept;
+
+    // • Cached max-chroma color at `hue`, if available: exact at a quantized
+    //   hue, interpolated between them only when enabled
+    //
+    std::optional<simd::float3> lookup(float hue) const noexcept;
+
+    // • Cached when available, otherwise solved on the calling thread
+    //
+    simd::float3 find_max_chroma_color(float hue) const;
+
+    // • Current estimate in degrees per second
+    //
+    float velocity(void) const noexcept
+    {
+        return velocity_.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    enum : uint32_t
+    {
+        capacity       = 256,
+        max_prefetches = capacity / 2,
+        empty_tag      = 0xffff'ffffu
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    // • Seqlock-protected entry: `version` is odd while being written
+    //
+    struct Entry
+    {
+        std::atomic<uint32_t>   version;
+        std::atomic<uint32_t>   tag;
+        std::atomic<float>      color[3];
+    };
+
+    uint32_t quantized_count(void) const noexcept;
+
+    bool load(uint32_t index, simd::float3& color) const noexcept;
+    void store(uint32_t index, simd::float3 color) noexcept;
+
+    void run(void);
+
+    const Parameters        parameters_;
+
+    Entry                   entries_[capacity];
+
+    // • Observation state (observer thread only)
+    //
+    float                   last_hue_;
+    Clock::time_point       last_time_;
+
+    // • Shared with the prefetch thread
+    //
+    std::atomic<float>      hue_;
+    std::atomic<float>      velocity_;
+    std::atomic<uint32_t>   generation_;
+    std::atomic<bool>       stopping_;
+
+    std::thread             thread_;
+};
@@ -0,0 +1,130 @@
+//
+//  HueSweepRenderer.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/HueSweepRenderer.hpp>
+#include <Graphics/HueGradient.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+HueSweepRenderer::HueSweepRenderer(HostRenderer&          renderer,
+                                   const CompositionData& composition,
+                                   simd::uint2            size)
+    : renderer_   ( renderer )
+    , composition_( composition )
+    , layout_     ( renderer.make_layout(composition, size) )
+{
+    const auto slot_count = renderer.pool().concurrency();
+
+    slots_.reserve(slot_count);
+
+    for (uint32_t is = 0; is < slot_count; ++is)
+    {
+        slots_.emplace_back( new Slot{
+            .arena = data::Arena{ 64 * 1024 },
+            .image = data::Image<data::half4>{ size.x, size.y }
+        });
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Rendering
+//===------------------------------------------------------------------------===
+
+void HueSweepRenderer::render(const Sweep& sweep, const FrameHandler& handler)
+{
+    const auto slot_count = frames_in_flight();
+
+    for (uint32_t first = 0; first < sweep.frame_count; first += slot_count)
+    {
+        const auto batch_count = std::min(slot_count, sweep.frame_count - first);
+
+        // • One slot per frame of the batch; slots are never shared between
+        //   frames in flight, so a thread that picks up another frame while
+        //   helping with tiles cannot reset an arena still in use
+        //
+        renderer_.pool().parallel_for( batch_count, [&](uint32_t ib) {
+
+            auto& slot = *slots_[ib];
+
+            render_frame( hue(sweep, first + ib), slot.arena, slot.image.view() );
+        });
+
+        for (uint32_t ib = 0; ib < batch_count; ++ib)
+        {
+            handler( first + ib, hue(sweep, first + ib), slots_[ib]->image.view() );
+        }
+    }
+}
+
+void HueSweepRenderer::render_contact_sheet(const Sweep&                 sweep,
+                                            uint32_t                     columns,
+                                            data::ImageView<data::half4> sheet)
+{
+    assert( 0 < columns );
+
+    const auto rows = (sweep.frame_count + columns - 1) / columns;
+
+    assert( columns * layout_.size.x <= sheet.width && rows * layout_.size.y <= sheet.height );
+    (void)rows;
+
+    const auto slot_count = frames_in_flight();
+
+    for (uint32_t first = 0; first < sweep.frame_count; first += slot_count)
+    {
+        const auto batch_count = std::min(slot_count, sweep.frame_count - first);
+
+        renderer_.pool().parallel_for( batch_count, [&](uint32_t ib) {
+
+            const auto frame = first + ib;
+            const auto cell  = geometry::make_region( simd::uint2{ frame % columns, frame / columns } * layout_.size,
+                                                      layout_.size );
+
+            render_frame( hue(sweep, frame), slots_[ib]->arena, sheet.subview(cell) );
+        });
+    }
+}
+
+void HueSweepRenderer::render_frame(float                        hue,
+                                    data::Arena&                 arena,
+                                    data::ImageView<data::half4> output)
+{
+    // • Solved as the renderer's hue gradient table is, so that the swatch
+    //   matches the gradient at the dial
+    //
+    const auto& gradient = renderer_.options().gradient;
+
+    auto composition = composition_;
+
+    composition.hue         = hue;
+    composition.max_c_color = jzazbz::find_max_chroma_color(hue, gradient.lane_count, gradient.accuracy);
+
+    const auto state = renderer_.make_frame(composition, layout_, arena);
+
+    renderer_.pool().parallel_for( layout_.tile_count.x * layout_.tile_count.y, [&](uint32_t tile) {
+
+        renderer_.render_tile(layout_, state, tile, output);
+    });
+
+    arena.reset();
+}
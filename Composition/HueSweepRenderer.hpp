@@ -0,0 +1,115 @@
+//
+//  HueSweepRenderer.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Composition/HostRenderer.hpp>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • HueSweepRenderer
+//
+//  Renders one composition image per hue of a sweep (animation frames or a
+//  contact sheet). The layout and the renderer's hue gradient table are built
+//  once for the whole sweep; only the max chroma color (at the renderer's
+//  gradient lane count and accuracy) and the slice frame are computed per
+//  hue. Frames render in parallel, each splitting its tiles over the same
+//  pool.
+//
+//===------------------------------------------------------------------------===
+
+class HueSweepRenderer
+{
+public:
+
+    struct Sweep
+    {
+        float       first_hue;
+        float       hue_step;
+        uint32_t    frame_count;
+    };
+
+    // • Frames are delivered in order, on the calling thread. The view is only
+    //   valid for the duration of the call
+    //
+    using FrameHandler = std::function<void (uint32_t frame, float hue, data::ImageView<data::half4> image)>;
+
+    // • Initialization. `composition` supplies the regions; its hue is ignored
+    //
+    HueSweepRenderer(HostRenderer& renderer, const CompositionData& composition, simd::uint2 size);
+
+    HueSweepRenderer(const HueSweepRenderer&) = delete;
+    HueSweepRenderer& operator = (const HueSweepRenderer&) = delete;
+
+    // • Render every frame of `sweep`, at most frames_in_flight() at a time
+    //
+    void render(const Sweep& sweep, const FrameHandler& handler);
+
+    // • Render every frame of `sweep` into a grid of `columns` cells of
+    //   `sheet`, row-major. The sheet must hold every cell
+    //
+    void render_contact_sheet(const Sweep& sweep, uint32_t columns, data::ImageView<data::half4> sheet);
+
+    // • Properties
+    //
+    const HostRenderer::Layout& layout(void) const noexcept
+    {
+        return layout_;
+    }
+
+    uint32_t frames_in_flight(void) const noexcept
+    {
+        return static_cast<uint32_t>( slots_.size() );
+    }
+
+    // • Reduced to [0, 360), as Composition's setHue:
+    //
+    static float hue(const Sweep& sweep, uint32_t frame) noexcept
+    {
+        const auto reduced = std::fmod(sweep.first_hue + sweep.hue_step * static_cast<float>(frame), 360.0f);
+        const auto wrapped = (reduced < 0.0f) ? reduced + 360.0f : reduced;
+
+        // • A tiny negative remainder rounds up to 360
+        //
+        return (wrapped < 360.0f) ? wrapped : 0.0f;
+    }
+
+private:
+
+    // • Per in-flight frame storage
+    //
+    struct Slot
+    {
+        data::Arena                 arena;
+        data::Image<data::half4>    image;
+    };
+
+    void render_frame(float hue, data::Arena& arena, data::ImageView<data::half4> output);
+
+    HostRenderer&                       renderer_;
+    const CompositionData               composition_;
+    const HostRenderer::Layout          layout_;
+
+    std::vector<std::unique_ptr<Slot>>  slots_;
+};
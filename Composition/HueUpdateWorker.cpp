@@ -0,0 +1,124 @@
+//
+//  HueUpdateWorker.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/HueUpdateWorker.hpp>
+#include <Graphics/Jzazbz.hpp>
+
+#include <bit>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+HueUpdateWorker::HueUpdateWorker(const CompositionData& initial,
+                                 const HuePrefetcher*   prefetcher,
+                                 PublishHandler         on_publish)
+    : ring_         ( initial )
+    , prefetcher_   ( prefetcher )
+    , on_publish_   ( std::move(on_publish) )
+    , requested_hue_( std::bit_cast<uint32_t>(initial.hue) )
+    , generation_   ( 0 )
+    , stopping_     ( false )
+{
+    thread_ = std::thread( [this] { run(); } );
+}
+
+HueUpdateWorker::~HueUpdateWorker()
+{
+    stopping_.store(true, std::memory_order_relaxed);
+
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_one();
+
+    thread_.join();
+}
+
+//===------------------------------------------------------------------------===
+// • Producer side
+//===------------------------------------------------------------------------===
+
+void HueUpdateWorker::request_hue(float hue) noexcept
+{
+    requested_hue_.store(std::bit_cast<uint32_t>(hue), std::memory_order_relaxed);
+
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_one();
+}
+
+//===------------------------------------------------------------------------===
+// • Worker thread
+//===------------------------------------------------------------------------===
+
+void HueUpdateWorker::run(void)
+{
+    auto seen_generation = uint32_t{ 0 };
+    auto solved_hue      = std::bit_cast<float>( requested_hue_.load(std::memory_order_relaxed) );
+
+    for (;;)
+    {
+        generation_.wait(seen_generation, std::memory_order_acquire);
+
+        if ( stopping_.load(std::memory_order_relaxed) )
+        {
+            return;
+        }
+
+        // • Coalesce: only the newest request is solved, anything arriving
+        //   during the solve is picked up by the next iteration
+        //
+        seen_generation = generation_.load(std::memory_order_acquire);
+
+        const auto hue = std::bit_cast<float>( requested_hue_.load(std::memory_order_relaxed) );
+
+        if (hue == solved_hue)
+        {
+            continue;
+        }
+
+        const auto max_c_color = (nullptr != prefetcher_)
+                               ? prefetcher_->find_max_chroma_color(hue)
+                               : jzazbz::find_max_chroma_color(hue);
+
+        // • Wait for a slot only if every one is held by the render thread
+        //
+        auto composition = ring_.begin_write();
+
+        while (nullptr == composition)
+        {
+            if ( stopping_.load(std::memory_order_relaxed) )
+            {
+                return;
+            }
+
+            std::this_thread::yield();
+            composition = ring_.begin_write();
+        }
+
+        composition->hue         = hue;
+        composition->max_c_color = max_c_color;
+
+        ring_.publish();
+        solved_hue = hue;
+
+        if (nullptr != on_publish_)
+        {
+            on_publish_();
+        }
+    }
+}
@@ -0,0 +1,93 @@
+//
+//  HueUpdateWorker.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Composition/CompositionData.hpp>
+#include <Composition/HuePrefetcher.hpp>
+#include <Data/FrameRing.hpp>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+//===------------------------------------------------------------------------===
+//
+// • HueUpdateWorker
+//
+//  Solves CompositionData for new hues on a dedicated thread. Requests are
+//  coalesced (only the newest pending hue is solved) and each result is
+//  published to a FrameRing, so the render thread only picks up finished
+//  compositions and never waits on the max-chroma search. When a prefetcher is
+//  supplied, prefetched results are used instead of solving.
+//
+//===------------------------------------------------------------------------===
+
+class HueUpdateWorker
+{
+public:
+
+    using Ring           = data::FrameRing<CompositionData, 4>;
+    using Token          = Ring::Token;
+    using PublishHandler = std::function<void (void)>;
+
+    // • Initialization. `on_publish` is invoked on the worker thread after
+    //   each result is published. The prefetcher, if any, must outlive the
+    //   worker
+    //
+    explicit HueUpdateWorker(const CompositionData& initial,
+                             const HuePrefetcher*   prefetcher = nullptr,
+                             PublishHandler         on_publish = nullptr);
+    ~HueUpdateWorker();
+
+    HueUpdateWorker(const HueUpdateWorker&) = delete;
+    HueUpdateWorker& operator = (const HueUpdateWorker&) = delete;
+
+    // • Producer side (any thread): latest request wins
+    //
+    void request_hue(float hue) noexcept;
+
+    // • Consumer side (render thread): never blocks
+    //
+    Token acquire(void) noexcept
+    {
+        return ring_.acquire();
+    }
+
+    void release(const Token& token) noexcept
+    {
+        ring_.release(token);
+    }
+
+private:
+
+    void run(void);
+
+    Ring                    ring_;
+    const HuePrefetcher*    prefetcher_;
+    PublishHandler          on_publish_;
+
+    // • Pending request: hue bits and a generation counter the worker waits on
+    //
+    std::atomic<uint32_t>   requested_hue_;
+    std::atomic<uint32_t>   generation_;
+    std::atomic<bool>       stopping_;
+
+    std::thread             thread_;
+};
@@ -0,0 +1,56 @@
+//
+//  MultiSliceData.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Composition/CompositionData.hpp>
+
+//===------------------------------------------------------------------------===
+//
+// • MultiSliceData
+//
+//  Small-multiples composition: one frame-wide grid holding columns × rows
+//  panels, each a copy of a single-slice composition at its own hue. Panel
+//  regions are in the frame grid, so every panel maps through the same
+//  grid_size as a CompositionData would.
+//
+//===------------------------------------------------------------------------===
+
+struct SliceInstance
+{
+    geometry::Region    cell;               // the panel's grid cell
+    geometry::Region    jc_region;
+    geometry::Region    gradient_region;
+    geometry::Region    max_c_region;
+
+    float               hue;
+    simd::float3        max_c_color;
+};
+
+struct MultiSliceData
+{
+    simd::uint2         grid_size;          // frame grid
+    simd::uint2         panel_grid;         // columns, rows
+    uint32_t            instance_count;
+};
+
+#if !defined ( __METAL_VERSION__ )
+static_assert( data::is_trivial_layout<SliceInstance>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<MultiSliceData>(), "Unexpected layout" );
+#endif
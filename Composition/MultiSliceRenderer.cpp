@@ -0,0 +1,207 @@
+//
+//  MultiSliceRenderer.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/MultiSliceRenderer.hpp>
+#include <Graphics/Jzazbz.hpp>
+
+#include <algorithm>
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void clear(data::ImageView<simd::float4> output, const geometry::Region rgn)
+    {
+        for (auto y = rgn.top; y < rgn.bottom; ++y)
+        {
+            std::fill( output.row(y) + rgn.left, output.row(y) + rgn.right, simd::float4{ 0.0f, 0.0f, 0.0f, 1.0f } );
+        }
+    }
+
+    void clear(data::ImageView<data::half4> output, const geometry::Region rgn)
+    {
+        const auto value = data::make_half4( simd::float4{ 0.0f, 0.0f, 0.0f, 1.0f } );
+
+        for (auto y = rgn.top; y < rgn.bottom; ++y)
+        {
+            std::fill( output.row(y) + rgn.left, output.row(y) + rgn.right, value );
+        }
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Layout
+//===------------------------------------------------------------------------===
+
+MultiSliceData MultiSliceRenderer::solve_layout(uint32_t panel_count, simd::uint2 panel_grid_size, simd::uint2 size)
+{
+    const auto count = std::max(panel_count, 1u);
+
+    auto best_columns = 1u;
+    auto best_scale   = 0.0f;
+    auto best_empty   = UINT32_MAX;
+
+    for (uint32_t columns = 1; columns <= count; ++columns)
+    {
+        const auto rows  = (count + columns - 1) / columns;
+        const auto sx    = static_cast<float>(size.x) / static_cast<float>(columns * panel_grid_size.x);
+        const auto sy    = static_cast<float>(size.y) / static_cast<float>(rows    * panel_grid_size.y);
+        const auto scale = std::min(sx, sy);
+        const auto empty = columns * rows - count;
+
+        if ( best_scale < scale || (best_scale == scale && empty < best_empty) )
+        {
+            best_columns = columns;
+            best_scale   = scale;
+            best_empty   = empty;
+        }
+    }
+
+    const auto best_rows = (count + best_columns - 1) / best_columns;
+
+    return {
+        .grid_size      = { best_columns * panel_grid_size.x, best_rows * panel_grid_size.y },
+        .panel_grid     = { best_columns, best_rows },
+        .instance_count = panel_count
+    };
+}
+
+std::vector<SliceInstance> MultiSliceRenderer::make_instances(const MultiSliceData&  data,
+                                                              const CompositionData& panel,
+                                                              const float*           hues)
+{
+    auto instances = std::vector<SliceInstance>{};
+
+    instances.reserve(data.instance_count);
+
+    for (uint32_t ip = 0; ip < data.instance_count; ++ip)
+    {
+        const auto column = ip % data.panel_grid.x;
+        const auto row    = ip / data.panel_grid.x;
+        const auto offset = simd::int2{ static_cast<int32_t>(column * panel.grid_size.x),
+                                        static_cast<int32_t>(row    * panel.grid_size.y) };
+
+        instances.push_back({
+            .cell            = geometry::make_region_of_size(panel.grid_size) + offset,
+            .jc_region       = panel.jc_region       + offset,
+            .gradient_region = panel.gradient_region + offset,
+            .max_c_region    = panel.max_c_region    + offset,
+            .hue             = hues[ip],
+            .max_c_color     = jzazbz::find_max_chroma_color(hues[ip])
+        });
+    }
+
+    return instances;
+}
+
+CompositionData MultiSliceRenderer::make_composition(const MultiSliceData& data, const SliceInstance& instance)
+{
+    return {
+        .grid_size       = data.grid_size,
+        .jc_region       = instance.jc_region,
+        .gradient_region = instance.gradient_region,
+        .max_c_region    = instance.max_c_region,
+        .hue             = instance.hue,
+        .max_c_color     = instance.max_c_color
+    };
+}
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+MultiSliceRenderer::MultiSliceRenderer(HostRenderer& renderer)
+    : renderer_( renderer )
+    , arena_   ( 256 * 1024 )
+{
+}
+
+//===------------------------------------------------------------------------===
+// • Rendering
+//===------------------------------------------------------------------------===
+
+void MultiSliceRenderer::render(const MultiSliceData& data, const SliceInstance* instances,
+                                data::ImageView<simd::float4> output)
+{
+    render_instances(data, instances, output);
+}
+
+void MultiSliceRenderer::render(const MultiSliceData& data, const SliceInstance* instances,
+                                data::ImageView<data::half4> output)
+{
+    render_instances(data, instances, output);
+}
+
+template <class Pixel_>
+void MultiSliceRenderer::render_instances(const MultiSliceData&   data,
+                                          const SliceInstance*    instances,
+                                          data::ImageView<Pixel_> output)
+{
+    // • Per-instance layouts, frames and pixel cells. Layouts share the
+    //   output size, and so the tile grid
+    //
+    const auto count   = data.instance_count;
+    const auto layouts = arena_.allocate<HostRenderer::Layout>( std::max(count, 1u) );
+    const auto frames  = arena_.allocate<HostRenderer::Frame>( std::max(count, 1u) );
+    const auto cells   = arena_.allocate<geometry::Region>( std::max(count, 1u) );
+
+    for (uint32_t ii = 0; ii < count; ++ii)
+    {
+        const auto composition = make_composition(data, instances[ii]);
+        const auto cell_rect   = geometry::make_rectangle( geometry::make_device_rect(instances[ii].cell, data.grid_size),
+                                                           output.size() );
+
+        layouts[ii] = renderer_.make_layout( composition, output.size() );
+        frames[ii]  = renderer_.make_frame(composition, layouts[ii], arena_);
+        cells[ii]   = geometry::make_covering_region( cell_rect, output.size() );
+    }
+
+    // • Only the grid size matters to the tiling of the whole output
+    //
+    const auto whole = CompositionData{
+        .grid_size       = data.grid_size,
+        .jc_region       = {},
+        .gradient_region = {},
+        .max_c_region    = {},
+        .hue             = 0.0f,
+        .max_c_color     = {}
+    };
+
+    const auto tiles = renderer_.make_layout(whole, output.size());
+
+    renderer_.pool().parallel_for( tiles.tile_count.x * tiles.tile_count.y, [&](uint32_t tile) {
+
+        const auto tile_region = HostRenderer::tile_region(tiles, tile);
+
+        clear(output, tile_region);
+
+        for (uint32_t ii = 0; ii < count; ++ii)
+        {
+            if ( geometry::intersects(cells[ii], tile_region) )
+            {
+                renderer_.render_tile(layouts[ii], frames[ii], tile, cells[ii], output);
+            }
+        }
+    });
+
+    arena_.reset();
+}
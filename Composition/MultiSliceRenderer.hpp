@@ -0,0 +1,84 @@
+//
+//  MultiSliceRenderer.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Composition/HostRenderer.hpp>
+#include <Composition/MultiSliceData.hpp>
+
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • MultiSliceRenderer
+//
+//  Renders every panel of a MultiSliceData in a single tile pass: each tile
+//  is cleared once, then shaded by every instance whose cell overlaps it, as
+//  an instanced draw would. Panel frames (slice triangles and tile bins) are
+//  built up front from the instance array.
+//
+//===------------------------------------------------------------------------===
+
+class MultiSliceRenderer
+{
+public:
+
+    //===--------------------------------------------------------------------===
+    // • Layout
+    //===--------------------------------------------------------------------===
+
+    // • The columns × rows arrangement of `panel_count` cells of
+    //   `panel_grid_size` giving the largest panels in an output of `size`;
+    //   ties go to the arrangement with fewer empty cells
+    //
+    static MultiSliceData solve_layout(uint32_t panel_count, simd::uint2 panel_grid_size, simd::uint2 size);
+
+    // • One instance per hue, row-major, each copying the regions of `panel`
+    //   (a single-slice composition) into its cell
+    //
+    static std::vector<SliceInstance> make_instances(const MultiSliceData&  data,
+                                                     const CompositionData& panel,
+                                                     const float*           hues);
+
+    static CompositionData make_composition(const MultiSliceData& data, const SliceInstance& instance);
+
+    //===--------------------------------------------------------------------===
+    // • Initialization
+    //===--------------------------------------------------------------------===
+
+    explicit MultiSliceRenderer(HostRenderer& renderer);
+
+    MultiSliceRenderer(const MultiSliceRenderer&) = delete;
+    MultiSliceRenderer& operator = (const MultiSliceRenderer&) = delete;
+
+    //===--------------------------------------------------------------------===
+    // • Rendering
+    //===--------------------------------------------------------------------===
+
+    void render(const MultiSliceData& data, const SliceInstance* instances, data::ImageView<simd::float4> output);
+    void render(const MultiSliceData& data, const SliceInstance* instances, data::ImageView<data::half4>  output);
+
+private:
+
+    template <class Pixel_>
+    void render_instances(const MultiSliceData& data, const SliceInstance* instances, data::ImageView<Pixel_> output);
+
+    HostRenderer&   renderer_;
+    data::Arena     arena_;
+};
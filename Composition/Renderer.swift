@@ -38,6 +38,16 @@ class Renderer {
     let device      : MTLDevice
     let composition : Composition
 
+    //===--------------------------------------------------------------------===
+    // MARK: • Properties
+    //
+    // • Target accuracy of the slice bracket search in Jzazbz units; the
+    //   kernel derives its iteration count from it and the thread execution
+    //   width. The hue gradient is generated once, at initialization, on the
+    //   host with its full mip chain (see hueGradientAccuracy)
+    //
+    var sliceAccuracy : Float = 1.0e-6
+
     //===--------------------------------------------------------------------===
     // MARK: • Properties (Private)
     //
@@ -51,6 +61,11 @@ class Renderer {
     private let depthState                    : MTLDepthStencilState
     private var textures                      : (multisample: MTLTexture, depth: MTLTexture)?
 
+    // • Hue and accuracy of the slice in vertexBuffer, which persists between
+    //   frames; nil until generated
+    //
+    private var generatedSlice                : (hue: Float, accuracy: Float)?
+
     //===--------------------------------------------------------------------===
     // MARK: • Constants (Private)
     //
@@ -59,7 +74,8 @@ class Renderer {
     //===--------------------------------------------------------------------===
     // MARK: • Initilization
     //
-    init?(library: MTLLibrary, composition: Composition, commandQueue: MTLCommandQueue) {
+    init?(library: MTLLibrary, composition: Composition, commandQueue: MTLCommandQueue,
+          hueGradientWidth: Int = 1024, hueGradientAccuracy: Float = 1.0e-6) {
 
         self.device      = library.device
         self.composition = composition
@@ -171,15 +187,17 @@ class Renderer {
             return nil
         }
 
-        // • Hue gradient texture
+        // • Hue gradient texture: 2D, one texel high, so that it can have mip
+        //   levels (1D textures cannot)
         //
         let hueGradientTextureDescriptor = MTLTextureDescriptor()
-        hueGradientTextureDescriptor.pixelFormat = self.pixelFormat
-        hueGradientTextureDescriptor.textureType = .type1D
-        hueGradientTextureDescriptor.width       = 1024
-        hueGradientTextureDescriptor.height      = 1
-        hueGradientTextureDescriptor.sampleCount = 1
-        hueGradientTextureDescriptor.usage       = [.shaderRead, .shaderWrite]
+        hueGradientTextureDescriptor.pixelFormat      = self.pixelFormat
+        hueGradientTextureDescriptor.textureType      = .type2D
+        hueGradientTextureDescriptor.width            = hueGradientWidth
+        hueGradientTextureDescriptor.height           = 1
+        hueGradientTextureDescriptor.mipmapLevelCount = HueGradientTable.levelCount(forWidth: hueGradientWidth)
+        hueGradientTextureDescriptor.sampleCount      = 1
+        hueGradientTextureDescriptor.usage            = [.shaderRead]
 
         guard let hueGradientTexture =
                 device.makeTexture(descriptor: hueGradientTextureDescriptor) else {
@@ -211,9 +229,9 @@ class Renderer {
         self.hueGradientTexture            = hueGradientTexture
         self.depthState                    = depthState
 
-        // • Create one-time GPU-rendered resources
+        // • Create one-time resources
         //
-        guard initializeResources(with: library, commandQueue: commandQueue) else {
+        guard HueGradientTable.fill(hueGradientTexture, accuracy: hueGradientAccuracy) else {
             return nil
         }
     }
@@ -224,6 +242,22 @@ class Renderer {
     @discardableResult
     func draw(to outputTexture: MTLTexture, with commandBuffer: MTLCommandBuffer) -> Bool {
 
+        // • Frame spans: CPU encoding here, GPU execution once the command
+        //   buffer completes. Individual passes are not traced: their CPU
+        //   encoding time says nothing of their GPU cost, and Metal only
+        //   samples GPU counters at draw boundaries on some GPUs
+        //
+        let frameBegin = FrameTracer.now()
+
+        defer {
+            FrameTracer.record(.frame, begin: frameBegin, end: FrameTracer.now())
+        }
+
+        commandBuffer.addCompletedHandler { commandBuffer in
+            FrameTracer.record(.gpu, begin: UInt64(commandBuffer.gpuStartTime * 1.0e9),
+                                     end:   UInt64(commandBuffer.gpuEndTime   * 1.0e9))
+        }
+
         // • Memoryless multi-sample and depth textures
         //
         guard let (multisampleTexture, depthTexture) = intermediateTextures(for: outputTexture) else {
@@ -234,26 +268,36 @@ class Renderer {
         //
         let compositionBuffer = composition.prepareBuffer()
 
-        // • Generate Jzazbz volume slice vertices at the current hue
+        // • Generate Jzazbz volume slice vertices at the current hue, unless
+        //   vertexBuffer already holds them
         //
-        guard let computeEncoder = commandBuffer.makeComputeCommandEncoder() else {
-            return false
-        }
+        let slice          = (hue: composition.preparedHue, accuracy: sliceAccuracy)
+        let isSliceCurrent = generatedSlice.map { $0 == slice } ?? false
+
+        if !isSliceCurrent {
+
+            guard let computeEncoder = commandBuffer.makeComputeCommandEncoder() else {
+                return false
+            }
 
-        computeEncoder.setComputePipelineState(generateVerticesPipelineState)
-        computeEncoder.setBuffer(compositionBuffer, offset: 0, index: 0)
-        computeEncoder.setBuffer(vertexBuffer, offset: 0, index: 1)
+            computeEncoder.setComputePipelineState(generateVerticesPipelineState)
+            computeEncoder.setBuffer(compositionBuffer, offset: 0, index: 0)
+            computeEncoder.setBuffer(vertexBuffer, offset: 0, index: 1)
+            computeEncoder.setBytes(&sliceAccuracy, length: MemoryLayout<Float>.size, index: 2)
 
-        let threadsWidth  = generateVerticesPipelineState.threadExecutionWidth
-        let threadsHeight = generateVerticesPipelineState.maxTotalThreadsPerThreadgroup / threadsWidth
+            let threadsWidth  = generateVerticesPipelineState.threadExecutionWidth
+            let threadsHeight = generateVerticesPipelineState.maxTotalThreadsPerThreadgroup / threadsWidth
 
-        let threadsPerThreadgroup = MTLSize(width: threadsWidth, height: threadsHeight, depth: 1)
+            let threadsPerThreadgroup = MTLSize(width: threadsWidth, height: threadsHeight, depth: 1)
 
-        computeEncoder.dispatchThreads( .init(width:  threadsWidth,
-                                              height: vertexCount / 2,
-                                              depth:  1),
-                                        threadsPerThreadgroup: threadsPerThreadgroup )
-        computeEncoder.endEncoding()
+            computeEncoder.dispatchThreads( .init(width:  threadsWidth,
+                                                  height: vertexCount / 2,
+                                                  depth:  1),
+                                            threadsPerThreadgroup: threadsPerThreadgroup )
+            computeEncoder.endEncoding()
+
+            generatedSlice = slice
+        }
 
         // • Render pass
         //
@@ -310,36 +354,6 @@ class Renderer {
     //===--------------------------------------------------------------------===
     // MARK: • Private Methods
     //
-    private func initializeResources(with library: MTLLibrary, commandQueue: MTLCommandQueue) -> Bool {
-
-        // • Generate hue gradient texture
-        //
-        guard let generateHueGradient = library.makeFunction(name: "generate_hue_gradient"),
-              let generateHueGradientPipeline =
-                try? device.makeComputePipelineState(function: generateHueGradient),
-              let commandBuffer = commandQueue.makeCommandBuffer(),
-              let computeEncoder = commandBuffer.makeComputeCommandEncoder() else {
-
-            return false
-        }
-
-        computeEncoder.setComputePipelineState(generateHueGradientPipeline)
-        computeEncoder.setTexture(hueGradientTexture, index: 0)
-
-        let threadsWidth  = generateHueGradientPipeline.threadExecutionWidth
-        let threadsHeight = generateHueGradientPipeline.maxTotalThreadsPerThreadgroup / threadsWidth
-
-        let threadsPerThreadGroup = MTLSize(width: threadsWidth, height: threadsHeight, depth: 1)
-        let threads = MTLSize(width: threadsWidth, height: hueGradientTexture.width, depth: 1)
-
-        computeEncoder.dispatchThreads(threads, threadsPerThreadgroup: threadsPerThreadGroup)
-        computeEncoder.endEncoding()
-
-        commandBuffer.commit()
-
-        return true
-    }
-
     private func intermediateTextures(for outputTexture: MTLTexture) -> (MTLTexture, MTLTexture)? {
 
         if let textures,
@@ -23,70 +23,6 @@
 
 using namespace metal;
 
-//===------------------------------------------------------------------------===
-// • Local functions
-//===------------------------------------------------------------------------===
-
-namespace
-{
-    float3 find_max_chroma_color(float lane_t, float height, float hue)
-    {
-        // • Find the Display P3 max chroma edge for the given hue
-        //
-        const auto target_hue     = (hue < 180.0f) ? hue : hue - 360.0f;
-        const auto target_radians = target_hue * M_PI_F / 180.0f;
-        const auto edges          = jzazbz::find_max_chroma_edge_P3(target_hue);
-
-        // • Perform binary search along edge to find the target hue
-        //
-        auto lower = edges.lower;
-        auto upper = edges.upper;
-
-        for (auto i = 0; i < 4; i++)
-        {
-            const auto val      = mix(lower, upper, lane_t);
-            const auto jab      = jzazbz::from_LMS(val.xyz);
-            const auto test_hue = atan2(jab[2], jab[1]);
-
-            const auto test      = (test_hue <= target_radians) ? lane_t : -1.0;
-            const auto low_t     = max(0.0f, simd_max(test));
-            const auto new_lower = mix(lower, upper, low_t);
-            const auto new_upper = mix(lower, upper, low_t + 1.0f/height);
-
-            lower = new_lower;
-            upper = new_upper;
-        }
-
-        return jzazbz::from_LMS(lower.xyz);
-    }
-
-} // namespace <anonymout>
-
-//===------------------------------------------------------------------------===
-// Generate hue gradient
-//===------------------------------------------------------------------------===
-
-[[kernel]] void generate_hue_gradient
-(
-    texture1d<half,access::write> output    [[ texture(0)              ]],
-    ushort2                       gid       [[ thread_position_in_grid ]],
-    ushort2                       grid_size [[ threads_per_grid        ]]
-)
-{
-    const auto height    = static_cast<float>(grid_size.x);
-    const auto lane_t    = static_cast<float>(gid.x) / height;
-    const auto hue_t     = (static_cast<float>(gid.y) + 0.5f) / static_cast<float>(grid_size.y);
-    const auto hue       = mix(-180.0f, 180.0f, hue_t);
-    const auto max_c_jab = find_max_chroma_color(lane_t, height, hue);
-
-    if (0 == gid.x)
-    {
-        const auto lrgb = half3( jzazbz::convert_to_linear_display_P3(max_c_jab) );
-
-        output.write( half4(lrgb, 1.0h), gid.y );
-    }
-}
-
 //===------------------------------------------------------------------------===
 // HueGradientVertex
 //===------------------------------------------------------------------------===
@@ -102,11 +38,14 @@ struct HueGradientVertex
 //===------------------------------------------------------------------------===
 
 [[fragment]] half4 hue_gradient_fragment(HueGradientVertex               in      [[ stage_in  ]],
-                                         texture1d<half, access::sample> texture [[ texture(0)]])
+                                         texture2d<half, access::sample> texture [[ texture(0)]])
 {
-    constexpr auto s = sampler{ coord::normalized, address::repeat, filter::linear };
+    // • One texel high; the level follows the on-screen texel density
+    //
+    constexpr auto s = sampler{ coord::normalized, s_address::repeat, t_address::clamp_to_edge,
+                                filter::linear, mip_filter::linear };
 
-    return texture.sample(s, in.tex_coord);
+    return texture.sample(s, float2(in.tex_coord, 0.5f));
 }
 
 [[vertex]] HueGradientVertex hue_gradient_vertex(constant CompositionData& composition [[ buffer(0) ]],
@@ -143,6 +82,7 @@ struct HueGradientVertex
 
 [[kernel]] void generate_vertices(constant CompositionData& composition [[ buffer(0)               ]],
                                   device float4*            output      [[ buffer(1)               ]],
+                                  constant float&           accuracy    [[ buffer(2)               ]],
                                   ushort2                   gid         [[ thread_position_in_grid ]],
                                   ushort2                   grid_size   [[ threads_per_grid        ]])
 {
@@ -168,7 +108,11 @@ struct HueGradientVertex
     constexpr auto max_lrgb = float3(1.0f);
     constexpr auto min_lrgb = float3(0.0f);
 
-    for (auto i = 0; i < 4; i++)
+    // • Iterations to reach `accuracy` (Jzazbz units) with the lane width
+    //
+    const auto iteration_count = jzazbz::slice_iteration_count(accuracy, grid_size.x);
+
+    for (auto i = 0u; i < iteration_count; i++)
     {
         const auto upper_jab     = mix(inner_high, outer_high, lane_t);
         const auto upper_lrgb    = jzazbz::convert_to_linear_display_P3(upper_jab);
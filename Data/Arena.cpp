@@ -0,0 +1,177 @@
+//
+//  Arena.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/Arena.hpp>
+
+#include <algorithm>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    uint8_t* allocate_block(uint32_t capacity)
+    {
+        return static_cast<uint8_t*>(
+                    ::operator new( capacity, std::align_val_t{ alignment } ) );
+    }
+
+    void free_block(uint8_t* block)
+    {
+        ::operator delete( block, std::align_val_t{ alignment } );
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • OverflowBlock
+//===------------------------------------------------------------------------===
+
+struct Arena::OverflowBlock
+{
+    OverflowBlock*  next;
+    uint8_t*        memory;
+    uint32_t        capacity;
+    uint32_t        used;
+};
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+Arena::Arena(uint32_t capacity)
+    : block_            ( nullptr )
+    , capacity_         ( aligned_size(std::max(capacity, uint32_t{ alignment })) )
+    , used_             ( 0 )
+    , overflow_         ( nullptr )
+    , overflow_used_    ( 0 )
+    , frame_peak_       ( 0 )
+    , peak_             ( 0 )
+    , allocation_count_ ( 0 )
+    , overflow_count_   ( 0 )
+    , reset_count_      ( 0 )
+{
+    block_ = allocate_block(capacity_);
+}
+
+Arena::~Arena()
+{
+    reset();
+    free_block(block_);
+}
+
+//===------------------------------------------------------------------------===
+// • Allocation
+//===------------------------------------------------------------------------===
+
+void* Arena::allocate_overflow(uint32_t length)
+{
+    overflow_count_ += 1;
+    overflow_used_  += length;
+
+    if (nullptr == overflow_ || overflow_->capacity - overflow_->used < length)
+    {
+        // • Overflow blocks are at least as large as the primary block
+        //
+        const auto capacity = std::max(length, capacity_);
+
+        overflow_ = new OverflowBlock {
+            .next     = overflow_,
+            .memory   = allocate_block(capacity),
+            .capacity = capacity,
+            .used     = 0
+        };
+    }
+
+    auto memory      = overflow_->memory + overflow_->used;
+    overflow_->used += length;
+
+    return memory;
+}
+
+void Arena::reset(void)
+{
+    const auto frame_used = used();
+
+    frame_peak_   = frame_used;
+    peak_         = std::max(peak_, frame_used);
+    reset_count_ += 1;
+
+    if (nullptr != overflow_)
+    {
+        // • Release overflow blocks and grow the primary block to the peak so
+        //   the next frame of the same size is served by the fast path
+        //
+        while (nullptr != overflow_)
+        {
+            auto next = overflow_->next;
+
+            free_block(overflow_->memory);
+            delete overflow_;
+
+            overflow_ = next;
+        }
+
+        free_block(block_);
+
+        capacity_ = aligned_size(peak_);
+        block_    = allocate_block(capacity_);
+    }
+
+    used_          = 0;
+    overflow_used_ = 0;
+}
+
+//===------------------------------------------------------------------------===
+// • Properties
+//===------------------------------------------------------------------------===
+
+ArenaStatistics Arena::statistics(void) const noexcept
+{
+    return {
+        .capacity         = capacity_,
+        .used             = used(),
+        .frame_peak       = frame_peak_,
+        .peak             = std::max(peak_, used()),
+        .allocation_count = allocation_count_,
+        .overflow_count   = overflow_count_,
+        .reset_count      = reset_count_
+    };
+}
+
+//===------------------------------------------------------------------------===
+// • Thread-local arena
+//===------------------------------------------------------------------------===
+
+Arena& thread_arena(void)
+{
+    thread_local Arena arena{ default_thread_arena_capacity };
+
+    return arena;
+}
+
+} // namespace data
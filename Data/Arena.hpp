@@ -0,0 +1,195 @@
+//
+//  Arena.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Arena (Host only)
+//
+//  Bump allocator for transient, trivially-laid-out data. Every allocation is
+//  aligned to data::alignment and is released all at once by reset(), usually
+//  at the end of a frame or batch job. Allocations that do not fit in the
+//  primary block spill into overflow blocks; the next reset() grows the
+//  primary block to the observed peak so that steady-state frames never touch
+//  the heap.
+//
+//===------------------------------------------------------------------------===
+
+//===------------------------------------------------------------------------===
+// • ArenaStatistics
+//===------------------------------------------------------------------------===
+
+struct ArenaStatistics
+{
+    uint32_t    capacity;           // primary block capacity in bytes
+    uint32_t    used;               // bytes allocated since the last reset
+    uint32_t    frame_peak;         // peak bytes of the previous frame
+    uint32_t    peak;               // peak bytes of any frame
+    uint64_t    allocation_count;   // allocations since creation
+    uint64_t    overflow_count;     // allocations that spilled out of the primary block
+    uint64_t    reset_count;        // frames
+};
+
+static_assert( data::is_trivial_layout<ArenaStatistics>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+// • Arena
+//===------------------------------------------------------------------------===
+
+class Arena
+{
+public:
+
+    // • Initialization
+    //
+    explicit Arena(uint32_t capacity);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator = (const Arena&) = delete;
+
+    // • Allocation (aligned to data::alignment)
+    //
+    void* allocate(uint32_t size)
+    {
+        const auto length = aligned_size(size);
+
+        allocation_count_ += 1;
+
+        if (length <= capacity_ - used_)
+        {
+            // • Fast path: bump within the primary block
+            //
+            auto memory = block_ + used_;
+            used_      += length;
+
+            return memory;
+        }
+
+        return allocate_overflow(length);
+    }
+
+    template <TrivialLayout Type_>
+    Type_* allocate(uint32_t count = 1)
+    {
+        static_assert( alignof(Type_) <= alignment, "Unsupported alignment" );
+
+        return static_cast<Type_*>( allocate( aligned_size<Type_>(count) ) );
+    }
+
+    // • Release every allocation (end of frame)
+    //
+    void reset(void);
+
+    // • Properties
+    //
+    uint32_t used(void) const noexcept
+    {
+        return used_ + overflow_used_;
+    }
+
+    uint32_t capacity(void) const noexcept
+    {
+        return capacity_;
+    }
+
+    ArenaStatistics statistics(void) const noexcept;
+
+private:
+
+    struct OverflowBlock;
+
+    void* allocate_overflow(uint32_t length);
+
+    uint8_t*        block_;
+    uint32_t        capacity_;
+    uint32_t        used_;
+
+    OverflowBlock*  overflow_;
+    uint32_t        overflow_used_;
+
+    uint32_t        frame_peak_;
+    uint32_t        peak_;
+    uint64_t        allocation_count_;
+    uint64_t        overflow_count_;
+    uint64_t        reset_count_;
+};
+
+//===------------------------------------------------------------------------===
+// • Thread-local arena
+//
+//  Each thread owns a lazily-created arena, so allocation from it requires no
+//  synchronization. The owner of the thread's frame loop calls reset().
+//===------------------------------------------------------------------------===
+
+enum : uint32_t
+{
+    default_thread_arena_capacity = 256 * 1024
+};
+
+Arena& thread_arena(void);
+
+//===------------------------------------------------------------------------===
+// • ArenaFrame
+//
+//  Scoped frame: resets the arena when the frame goes out of scope
+//===------------------------------------------------------------------------===
+
+class ArenaFrame
+{
+public:
+
+    explicit ArenaFrame(Arena& arena = thread_arena()) noexcept
+        : arena_(arena)
+    {
+    }
+
+    ~ArenaFrame()
+    {
+        arena_.reset();
+    }
+
+    ArenaFrame(const ArenaFrame&) = delete;
+    ArenaFrame& operator = (const ArenaFrame&) = delete;
+
+    Arena& arena(void) const noexcept
+    {
+        return arena_;
+    }
+
+private:
+
+    Arena& arena_;
+};
+
+} // namespace data
@@ -0,0 +1,251 @@
+//
+//  FrameRing.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • FrameRing (Host only)
+//
+//  Lock-free N-buffered frame data shared by a single producer and any number
+//  of consumers.
+//
+//  • The producer claims a slot with begin_write(), which never returns the
+//    latest published slot or a slot still held by a consumer, fills it and
+//    makes it the latest with publish() (release).
+//  • A consumer takes the latest published slot with acquire() (acquire) and
+//    returns it with release() once it has completed using it, e.g. from a
+//    command buffer completion handler. Until then the producer cannot reuse
+//    the slot.
+//
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Type_, uint32_t Count_>
+class FrameRing
+{
+    static_assert( 2 <= Count_, "At least two slots are required" );
+
+public:
+
+    using value_type = Type_;
+
+    //===--------------------------------------------------------------------===
+    // • Token (consumer completion token)
+    //===--------------------------------------------------------------------===
+
+    struct Token
+    {
+        const Type_*    data;
+        uint64_t        sequence;
+        uint32_t        slot;
+
+        explicit operator bool (void) const noexcept
+        {
+            return nullptr != data;
+        }
+    };
+
+    //===--------------------------------------------------------------------===
+    // • Initialization
+    //===--------------------------------------------------------------------===
+
+    explicit FrameRing(const Type_& initial) noexcept
+        : latest_    ( 0 )
+        , published_ ( 0 )
+        , write_slot_( invalid_slot )
+    {
+        for (uint32_t is = 0; is < Count_; ++is)
+        {
+            slots_[is].value    = initial;
+            slots_[is].sequence = 0;
+            slots_[is].state.store(0, std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator = (const FrameRing&) = delete;
+
+    //===--------------------------------------------------------------------===
+    // • Producer
+    //===--------------------------------------------------------------------===
+
+    // • Claim a free slot, initialized with a copy of the latest value. Returns
+    //   nullptr when every other slot is still held by a consumer
+    //
+    Type_* begin_write(void) noexcept
+    {
+        if (invalid_slot != write_slot_)
+        {
+            return &slots_[write_slot_].value;
+        }
+
+        const auto latest = latest_.load(std::memory_order_relaxed);
+
+        for (uint32_t ic = 1; ic < Count_; ++ic)
+        {
+            const auto slot     = (latest + ic) % Count_;
+            auto       expected = uint32_t{ 0 };
+
+            if ( slots_[slot].state.compare_exchange_strong(expected, writing,
+                                                            std::memory_order_acquire,
+                                                            std::memory_order_relaxed) )
+            {
+                write_slot_ = slot;
+
+                std::memcpy( &slots_[slot].value, &slots_[latest].value, sizeof(Type_) );
+
+                return &slots_[slot].value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // • Make the slot claimed by begin_write() the latest
+    //
+    void publish(void) noexcept
+    {
+        if (invalid_slot == write_slot_)
+        {
+            return;
+        }
+
+        const auto slot     = write_slot_;
+        const auto sequence = published_.load(std::memory_order_relaxed) + 1;
+
+        slots_[slot].sequence = sequence;
+
+        // • Clear only the flag: a consumer that loaded this slot from latest_
+        //   before it was claimed may still hold a transient count, which it
+        //   drops when it sees `writing`
+        //
+        slots_[slot].state.fetch_and(~writing, std::memory_order_release);
+        latest_.store(slot, std::memory_order_release);
+        published_.store(sequence, std::memory_order_release);
+
+        write_slot_ = invalid_slot;
+    }
+
+    // • Abandon the slot claimed by begin_write()
+    //
+    void cancel_write(void) noexcept
+    {
+        if (invalid_slot != write_slot_)
+        {
+            slots_[write_slot_].state.fetch_and(~writing, std::memory_order_release);
+            write_slot_ = invalid_slot;
+        }
+    }
+
+    //===--------------------------------------------------------------------===
+    // • Consumer
+    //===--------------------------------------------------------------------===
+
+    // • Hold the latest published slot until release()
+    //
+    Token acquire(void) noexcept
+    {
+        for (;;)
+        {
+            const auto slot  = latest_.load(std::memory_order_acquire);
+            const auto state = slots_[slot].state.fetch_add(1, std::memory_order_acquire);
+
+            if (0 == (state & writing))
+            {
+                return {
+                    .data     = &slots_[slot].value,
+                    .sequence = slots_[slot].sequence,
+                    .slot     = slot
+                };
+            }
+
+            // • The producer reclaimed the slot after a newer publish: retry
+            //   with the newer slot
+            //
+            slots_[slot].state.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // • Signal consumer completion, allowing the producer to reuse the slot
+    //
+    void release(const Token& token) noexcept
+    {
+        if (token)
+        {
+            slots_[token.slot].state.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    //===--------------------------------------------------------------------===
+    // • Properties
+    //===--------------------------------------------------------------------===
+
+    static constexpr uint32_t count(void) noexcept
+    {
+        return Count_;
+    }
+
+    uint64_t latest_sequence(void) const noexcept
+    {
+        return published_.load(std::memory_order_acquire);
+    }
+
+private:
+
+    enum : uint32_t
+    {
+        writing      = 0x8000'0000u,
+        invalid_slot = 0xffff'ffffu
+    };
+
+    // • state: consumer hold count, plus `writing` while claimed by the
+    //   producer (a consumer racing the claim counts itself in briefly)
+    //
+    struct alignas(64) Slot
+    {
+        Type_                   value;
+        uint64_t                sequence;
+        std::atomic<uint32_t>   state;
+    };
+
+    Slot                    slots_[Count_];
+    std::atomic<uint32_t>   latest_;
+    std::atomic<uint64_t>   published_;
+
+    // • Producer-only
+    //
+    uint32_t                write_slot_;
+};
+
+} // namespace data
@@ -0,0 +1,180 @@
+//
+//  Half.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+#include <simd/simd.h>
+
+#include <bit>
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • IEEE 754 binary16 storage (Host only)
+//
+//  Portable conversions for host code that reads or writes half-float pixel
+//  data (rgba16Float textures, EXR-style output) without relying on compiler
+//  support for a native half type.
+//
+//===------------------------------------------------------------------------===
+
+struct half4
+{
+    uint16_t    x;
+    uint16_t    y;
+    uint16_t    z;
+    uint16_t    w;
+};
+
+static_assert(  8 ==  sizeof(half4), "Unexpected size" );
+static_assert(  2 == alignof(half4), "Unexpected alignment" );
+static_assert( data::is_trivial_layout<half4>(), "Unexpected layout" );
+
+//===------------------------------------------------------------------------===
+// • Scalar conversion
+//===------------------------------------------------------------------------===
+
+// • Round to nearest even; overflow to infinity, NaN preserved
+//
+constexpr uint16_t float_to_half(float value) noexcept
+{
+    const auto bits     = std::bit_cast<uint32_t>(value);
+    const auto sign     = static_cast<uint16_t>( (bits >> 16) & 0x8000u );
+    const auto exponent = static_cast<int32_t>( (bits >> 23) & 0xffu );
+    const auto mantissa = bits & 0x007f'ffffu;
+
+    if (0xff == exponent)
+    {
+        // • Infinity or NaN
+        //
+        return sign | 0x7c00u | ( (0 != mantissa) ? 0x0200u : 0u );
+    }
+
+    const auto half_exponent = exponent - 127 + 15;
+
+    if (31 <= half_exponent)
+    {
+        return sign | 0x7c00u;
+    }
+
+    if (half_exponent <= 0)
+    {
+        // • Subnormal or zero
+        //
+        if (half_exponent < -10)
+        {
+            return sign;
+        }
+
+        const auto full_mantissa = mantissa | 0x0080'0000u;
+        const auto shift         = static_cast<uint32_t>(14 - half_exponent);
+        const auto half_mantissa = full_mantissa >> shift;
+        const auto remainder     = full_mantissa & ((1u << shift) - 1u);
+        const auto halfway       = 1u << (shift - 1u);
+        const auto round_up      = (halfway < remainder)
+                                || (halfway == remainder && 0 != (half_mantissa & 1u));
+
+        return static_cast<uint16_t>( sign | (half_mantissa + (round_up ? 1u : 0u)) );
+    }
+
+    const auto half_bits = (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+    const auto remainder = mantissa & 0x1fffu;
+    const auto round_up  = (0x1000u < remainder) || (0x1000u == remainder && 0 != (half_bits & 1u));
+
+    // • A carry out of the mantissa correctly increments the exponent (and
+    //   rounds to infinity at the top of the range)
+    //
+    return static_cast<uint16_t>( sign | (half_bits + (round_up ? 1u : 0u)) );
+}
+
+constexpr float half_to_float(uint16_t half) noexcept
+{
+    const auto sign     = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const auto exponent = static_cast<uint32_t>(half >> 10) & 0x1fu;
+    const auto mantissa = static_cast<uint32_t>(half) & 0x03ffu;
+
+    if (0 == exponent)
+    {
+        if (0 == mantissa)
+        {
+            return std::bit_cast<float>(sign);
+        }
+
+        // • Subnormal: normalize
+        //
+        auto e = uint32_t{ 113 };
+        auto m = mantissa;
+
+        while (0 == (m & 0x0400u))
+        {
+            m <<= 1;
+            e  -= 1;
+        }
+
+        return std::bit_cast<float>( sign | (e << 23) | ((m & 0x03ffu) << 13) );
+    }
+
+    if (0x1f == exponent)
+    {
+        return std::bit_cast<float>( sign | 0x7f80'0000u | (mantissa << 13) );
+    }
+
+    return std::bit_cast<float>( sign | ((exponent + 112) << 23) | (mantissa << 13) );
+}
+
+//===------------------------------------------------------------------------===
+// • Vector conversion
+//===------------------------------------------------------------------------===
+
+inline half4 make_half4(simd::float4 value) noexcept
+{
+    return {
+        .x = float_to_half(value[0]),
+        .y = float_to_half(value[1]),
+        .z = float_to_half(value[2]),
+        .w = float_to_half(value[3])
+    };
+}
+
+inline simd::float4 make_float4(half4 value) noexcept
+{
+    return {
+        half_to_float(value.x),
+        half_to_float(value.y),
+        half_to_float(value.z),
+        half_to_float(value.w)
+    };
+}
+
+// • Round through half precision, as when writing to an rgba16Float target
+//
+inline simd::float4 quantize_half(simd::float4 value) noexcept
+{
+    return make_float4( make_half4(value) );
+}
+
+} // namespace data
@@ -0,0 +1,167 @@
+//
+//  Image.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+#include <Graphics/Geometry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+//===------------------------------------------------------------------------===
+// • namespace data
+//===------------------------------------------------------------------------===
+
+namespace data
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Images (Host only)
+//
+//  Row-major pixel storage, top row first (as Metal textures). Row strides
+//  are in pixels and every row starts on a data::alignment boundary.
+//
+//===------------------------------------------------------------------------===
+
+//===------------------------------------------------------------------------===
+// • ImageView (non-owning)
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Pixel_>
+struct ImageView
+{
+    Pixel_*     pixels;
+    uint32_t    width;
+    uint32_t    height;
+    uint32_t    stride;
+
+    Pixel_* row(uint32_t y) const noexcept
+    {
+        return pixels + static_cast<size_t>(y) * stride;
+    }
+
+    Pixel_& operator () (uint32_t x, uint32_t y) const noexcept
+    {
+        return row(y)[x];
+    }
+
+    simd::uint2 size(void) const noexcept
+    {
+        return { width, height };
+    }
+
+    geometry::Region bounds(void) const noexcept
+    {
+        return geometry::make_region_of_size( size() );
+    }
+
+    // • Sub-image sharing storage with this view
+    //
+    ImageView subview(const geometry::Region rgn) const noexcept
+    {
+        return {
+            .pixels = row(rgn.top) + rgn.left,
+            .width  = geometry::width(rgn),
+            .height = geometry::height(rgn),
+            .stride = stride
+        };
+    }
+};
+
+template <TrivialLayout Pixel_>
+constexpr uint32_t aligned_stride(uint32_t width) noexcept
+{
+    return aligned_size<Pixel_>(width) / static_cast<uint32_t>( sizeof(Pixel_) );
+}
+
+//===------------------------------------------------------------------------===
+// • Image (owning)
+//===------------------------------------------------------------------------===
+
+template <TrivialLayout Pixel_>
+class Image
+{
+    static_assert( 0 == alignment % sizeof(Pixel_) || 0 == sizeof(Pixel_) % alignment,
+                   "Rows cannot be aligned for this pixel size" );
+
+public:
+
+    using pixel_type = Pixel_;
+
+    Image(uint32_t width, uint32_t height)
+        : view_{
+            .pixels = nullptr,
+            .width  = width,
+            .height = height,
+            .stride = aligned_stride<Pixel_>(width)
+          }
+    {
+        view_.pixels = static_cast<Pixel_*>(
+                            ::operator new( size_in_bytes(), std::align_val_t{ alignment } ) );
+    }
+
+    ~Image()
+    {
+        ::operator delete( view_.pixels, std::align_val_t{ alignment } );
+    }
+
+    Image(const Image&) = delete;
+    Image& operator = (const Image&) = delete;
+
+    Image(Image&& other) noexcept
+        : view_( other.view_ )
+    {
+        other.view_.pixels = nullptr;
+    }
+
+    // • Properties
+    //
+    uint32_t width(void) const noexcept  { return view_.width;  }
+    uint32_t height(void) const noexcept { return view_.height; }
+    uint32_t stride(void) const noexcept { return view_.stride; }
+
+    size_t size_in_bytes(void) const noexcept
+    {
+        return static_cast<size_t>(view_.stride) * view_.height * sizeof(Pixel_);
+    }
+
+    ImageView<Pixel_> view(void) const noexcept
+    {
+        return view_;
+    }
+
+    Pixel_* row(uint32_t y) const noexcept
+    {
+        return view_.row(y);
+    }
+
+    Pixel_& operator () (uint32_t x, uint32_t y) const noexcept
+    {
+        return view_(x, y);
+    }
+
+private:
+
+    ImageView<Pixel_> view_;
+};
+
+} // namespace data
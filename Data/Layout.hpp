@@ -20,6 +20,7 @@
 #pragma once
 
 #if !defined ( __METAL_VERSION__ )
+#include <cstdint>
 #include <type_traits>
 #endif
 
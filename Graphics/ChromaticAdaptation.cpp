@@ -0,0 +1,183 @@
+//
+//  ChromaticAdaptation.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/ChromaticAdaptation.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    // • XYZ to cone response, rows as published
+    //
+    simd::double3x3 cone_matrix(AdaptationMethod method)
+    {
+        switch (method)
+        {
+            case AdaptationMethod::bradford:
+                return simd::transpose( simd::double3x3 {
+                    simd::double3{  0.8951,  0.2664, -0.1614 },
+                    simd::double3{ -0.7502,  1.7135,  0.0367 },
+                    simd::double3{  0.0389, -0.0685,  1.0296 }
+                });
+
+            case AdaptationMethod::cat16:
+                return simd::transpose( simd::double3x3 {
+                    simd::double3{  0.401288, 0.650173, -0.051461 },
+                    simd::double3{ -0.250268, 1.204414,  0.045854 },
+                    simd::double3{ -0.002079, 0.048952,  0.953127 }
+                });
+
+            case AdaptationMethod::none:
+                break;
+        }
+
+        return simd::double3x3(1.0);
+    }
+
+    simd::double3x3 diagonal(simd::double3 d)
+    {
+        return simd::double3x3 {
+            simd::double3{ d.x, 0.0, 0.0 },
+            simd::double3{ 0.0, d.y, 0.0 },
+            simd::double3{ 0.0, 0.0, d.z }
+        };
+    }
+
+    simd::float3x3 to_float(const simd::double3x3& m)
+    {
+        const auto column = [&](int i) {
+            return simd::float3{ static_cast<float>(m.columns[i].x),
+                                 static_cast<float>(m.columns[i].y),
+                                 static_cast<float>(m.columns[i].z) };
+        };
+
+        return simd::float3x3{ column(0), column(1), column(2) };
+    }
+
+    // • XYZ (D65) to the LMS of convert_to_LMS, through Display P3 so that
+    //   D65 conversions agree with linear_display_P3_to_LMS
+    //
+    simd::double3x3 XYZ_D65_to_LMS(void)
+    {
+        const auto M_LinearP3ToLMS = simd::double3x3 {
+            simd::double3{ 0.41569922342211657,  0.24199222690861918,  0.07453493016949878  },
+            simd::double3{ 0.4417746176493501,   0.5550591123439756,   0.17001346708806345  },
+            simd::double3{ 0.11431238432553265,  0.17519605565166835,  0.7282635337867523   },
+        };
+
+        return M_LinearP3ToLMS * simd::inverse( RGB_to_XYZ_matrix(display_P3_primaries) );
+    }
+
+    AdaptedConversion make_conversion(const simd::double3x3& to_LMS)
+    {
+        return {
+            .to_LMS   = to_float(to_LMS),
+            .from_LMS = to_float( simd::inverse(to_LMS) )
+        };
+    }
+
+    template <typename Convert_>
+    void convert_pixels(const float* source, float* target, size_t count, Convert_ convert)
+    {
+        for (size_t i = 0; i < count; ++i, source += 3, target += 3)
+        {
+            const auto value = convert( simd::float3{ source[0], source[1], source[2] } );
+
+            target[0] = value[0];
+            target[1] = value[1];
+            target[2] = value[2];
+        }
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Setup
+//===------------------------------------------------------------------------===
+
+simd::double3 white_point_XYZ(simd::float2 white)
+{
+    const auto x = static_cast<double>(white.x);
+    const auto y = static_cast<double>(white.y);
+
+    return simd::double3{ x / y, 1.0, (1.0 - x - y) / y };
+}
+
+simd::double3x3 adaptation_matrix(simd::float2 source_white, simd::float2 target_white, AdaptationMethod method)
+{
+    const auto M_cone = cone_matrix(method);
+    const auto source = M_cone * white_point_XYZ(source_white);
+    const auto target = M_cone * white_point_XYZ(target_white);
+
+    return simd::inverse(M_cone) * diagonal(target / source) * M_cone;
+}
+
+simd::double3x3 RGB_to_XYZ_matrix(const RGBPrimaries& primaries)
+{
+    // • Columns are the primaries' XYZ, scaled so that RGB 1 is the white
+    //
+    const auto M_xyz = simd::double3x3 {
+        white_point_XYZ(primaries.red),
+        white_point_XYZ(primaries.green),
+        white_point_XYZ(primaries.blue)
+    };
+
+    return M_xyz * diagonal( simd::inverse(M_xyz) * white_point_XYZ(primaries.white) );
+}
+
+AdaptedConversion make_XYZ_conversion(simd::float2 white, AdaptationMethod method)
+{
+    return make_conversion( XYZ_D65_to_LMS() * adaptation_matrix(white, white_point::D65, method) );
+}
+
+AdaptedConversion make_RGB_conversion(const RGBPrimaries& primaries, AdaptationMethod method)
+{
+    return make_conversion( XYZ_D65_to_LMS()
+                          * adaptation_matrix(primaries.white, white_point::D65, method)
+                          * RGB_to_XYZ_matrix(primaries) );
+}
+
+//===------------------------------------------------------------------------===
+// • Batch conversion
+//===------------------------------------------------------------------------===
+
+void convert_pixels_from_adapted(const float* source, float* jab, size_t count, const AdaptedConversion& conversion)
+{
+    convert_pixels( source, jab, count, [&](simd::float3 value) {
+        return convert_from_adapted(value, conversion);
+    });
+}
+
+void convert_pixels_to_adapted(const float* jab, float* target, size_t count, const AdaptedConversion& conversion)
+{
+    convert_pixels( jab, target, count, [&](simd::float3 value) {
+        return convert_to_adapted(value, conversion);
+    });
+}
+
+} // namespace jzazbz
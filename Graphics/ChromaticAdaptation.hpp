@@ -0,0 +1,163 @@
+//
+//  ChromaticAdaptation.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Jzazbz.hpp>
+#include <simd/simd.h>
+
+#include <cstddef>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Chromatic Adaptation (Host only)
+//
+//  Jzazbz is defined for D65. Colors relative to another white (D50 print
+//  data, ICC PCS values, ProPhoto RGB) are adapted with a von Kries scaling
+//  in the cone space of Bradford or CAT16. The adaptation, the RGB to XYZ
+//  matrix if any, and XYZ to the LMS of convert_to_LMS are folded into one
+//  matrix per direction when the conversion is made, so a pixel costs what
+//  convert_from_linear_display_P3 does.
+//
+//  XYZ is relative: Y = 1 is linear 1.0, 100 cd/m² in absolute Jzazbz.
+//
+//===------------------------------------------------------------------------===
+
+enum class AdaptationMethod
+{
+    none,       // scaling in XYZ itself
+    bradford,
+    cat16
+};
+
+// • White points, CIE 1931 xy
+//
+namespace white_point
+{
+    constexpr auto D50 = simd::float2{ 0.3457f,  0.3585f  };
+    constexpr auto D55 = simd::float2{ 0.3324f,  0.3474f  };
+    constexpr auto D60 = simd::float2{ 0.32168f, 0.33767f };   // ACES
+    constexpr auto D65 = simd::float2{ 0.3127f,  0.3290f  };
+    constexpr auto DCI = simd::float2{ 0.314f,   0.351f   };
+    constexpr auto A   = simd::float2{ 0.44757f, 0.40745f };
+    constexpr auto E   = simd::float2{ 1.0f/3.0f, 1.0f/3.0f };
+
+} // namespace white_point
+
+// • Primaries and white of an RGB space, CIE 1931 xy
+//
+struct RGBPrimaries
+{
+    simd::float2    red;
+    simd::float2    green;
+    simd::float2    blue;
+    simd::float2    white;
+};
+
+constexpr RGBPrimaries display_P3_primaries = {
+    .red   = { 0.680f, 0.320f },
+    .green = { 0.265f, 0.690f },
+    .blue  = { 0.150f, 0.060f },
+    .white = white_point::D65
+};
+
+constexpr RGBPrimaries rec2020_primaries = {
+    .red   = { 0.708f, 0.292f },
+    .green = { 0.170f, 0.797f },
+    .blue  = { 0.131f, 0.046f },
+    .white = white_point::D65
+};
+
+constexpr RGBPrimaries prophoto_primaries = {
+    .red   = { 0.734699f, 0.265301f },
+    .green = { 0.159597f, 0.840403f },
+    .blue  = { 0.036598f, 0.000105f },
+    .white = white_point::D50
+};
+
+constexpr RGBPrimaries adobe_rgb_primaries = {
+    .red   = { 0.64f, 0.33f },
+    .green = { 0.21f, 0.71f },
+    .blue  = { 0.15f, 0.06f },
+    .white = white_point::D65
+};
+
+//===------------------------------------------------------------------------===
+// • Setup (double precision)
+//===------------------------------------------------------------------------===
+
+// • XYZ with Y = 1 of a white
+//
+simd::double3 white_point_XYZ(simd::float2 white);
+
+// • XYZ relative to source_white to XYZ relative to target_white
+//
+simd::double3x3 adaptation_matrix(simd::float2     source_white,
+                                  simd::float2     target_white,
+                                  AdaptationMethod method = AdaptationMethod::bradford);
+
+// • Linear RGB to XYZ relative to the space's own white
+//
+simd::double3x3 RGB_to_XYZ_matrix(const RGBPrimaries& primaries);
+
+//===------------------------------------------------------------------------===
+// • AdaptedConversion
+//
+//  Folded matrices between a source space and the (D65) LMS of Jzazbz.
+//===------------------------------------------------------------------------===
+
+struct AdaptedConversion
+{
+    simd::float3x3  to_LMS;
+    simd::float3x3  from_LMS;
+};
+
+AdaptedConversion make_XYZ_conversion(simd::float2     white,
+                                      AdaptationMethod method = AdaptationMethod::bradford);
+
+AdaptedConversion make_RGB_conversion(const RGBPrimaries& primaries,
+                                      AdaptationMethod    method = AdaptationMethod::bradford);
+
+inline simd::float3 convert_from_adapted(simd::float3 value, const AdaptedConversion& conversion)
+{
+    return from_LMS( conversion.to_LMS * value );
+}
+
+inline simd::float3 convert_to_adapted(simd::float3 jab, const AdaptedConversion& conversion)
+{
+    return conversion.from_LMS * convert_to_LMS(jab);
+}
+
+// • Interleaved triplets, as JzazbzBatch; source and target may be the
+//   same buffer
+//
+void convert_pixels_from_adapted(const float* source, float* jab, size_t count,
+                                 const AdaptedConversion& conversion);
+
+void convert_pixels_to_adapted(const float* jab, float* target, size_t count,
+                               const AdaptedConversion& conversion);
+
+} // namespace jzazbz
@@ -0,0 +1,312 @@
+//
+//  GamutMesh.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/GamutMesh.hpp>
+#include <Graphics/GamutSlice.hpp>
+#include <Graphics/Jzazbz.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    float mix(float x, float y, float t)
+    {
+        return x + t*(y - x);
+    }
+
+    simd::float4 make_vertex(simd::float3 jab)
+    {
+        return simd::float4{ jab[0], jab[1], jab[2], 0.0f };
+    }
+
+    float hue_of_profile(uint32_t profile, uint32_t hue_count)
+    {
+        return 360.0f * static_cast<float>(profile) / static_cast<float>(hue_count) - 180.0f;
+    }
+
+    // • Jz of the lower and upper boundaries of one profile at chroma fraction
+    //   `t` in [0, 1], bands interpolated linearly
+    //
+    simd::float2 boundary_Jz(const simd::float4* vertices, uint32_t band_count, uint32_t profile, float t)
+    {
+        const auto profile_size = gamut_mesh_profile_size(band_count);
+        const auto ring         = vertices + 2 + profile*profile_size;
+
+        const auto bounds = [&](uint32_t band) {
+
+            if (0 == band)
+            {
+                return simd::float2{ vertices[0][0], vertices[1][0] };
+            }
+
+            return simd::float2{ ring[band - 1][0], ring[profile_size - band][0] };
+        };
+
+        const auto position = std::min( t*static_cast<float>(band_count), static_cast<float>(band_count) );
+        const auto band     = std::min( static_cast<uint32_t>(position), band_count - 1 );
+        const auto fraction = position - static_cast<float>(band);
+        const auto lower    = bounds(band);
+        const auto upper    = bounds(band + 1);
+
+        return lower + fraction*(upper - lower);
+    }
+
+    bool is_within(const GamutMeshData& mesh, uint64_t offset, uint64_t size)
+    {
+        return data::is_aligned( static_cast<uint32_t>(offset) ) && offset + size <= mesh.size;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+GamutMesh::GamutMesh(const GamutMeshParameters& parameters, utilities::ThreadPool& pool)
+{
+    const auto level_count  = std::max(parameters.level_count, 1u);
+    const auto hue_count    = std::max(parameters.hue_count, 3u)  << (level_count - 1);
+    const auto band_count   = std::max(parameters.band_count, 1u) << (level_count - 1);
+    const auto profile_size = gamut_mesh_profile_size(band_count);
+
+    const auto slice = SliceParameters{
+        .band_count      = band_count,
+        .lane_count      = parameters.lane_count,
+        .accuracy        = parameters.accuracy
+    };
+
+    // • Finest profiles, one hue per task; band 0 lies on the neutral axis
+    //   and becomes the poles
+    //
+    auto profiles = std::vector<simd::float4>( hue_count * profile_size );
+
+    pool.parallel_for( hue_count, [&](uint32_t ih) {
+
+        const auto max_c_jab = find_max_chroma_color( hue_of_profile(ih, hue_count) );
+        const auto profile   = profiles.data() + ih*profile_size;
+
+        for (uint32_t band = 1; band < band_count; ++band)
+        {
+            const auto solved = solve_slice_band( max_c_jab,
+                                                  static_cast<float>(band) / static_cast<float>(band_count),
+                                                  slice );
+
+            profile[band - 1]            = make_vertex(solved.low);
+            profile[profile_size - band] = make_vertex(solved.high);
+        }
+
+        profile[band_count - 1] = make_vertex(max_c_jab);
+    });
+
+    const auto poles = solve_slice_band( find_max_chroma_color(0.0f), 0.0f, slice );
+
+    // • Layout: header, levels, then vertices and indices level by level
+    //
+    auto levels = std::vector<GamutMeshLevel>(level_count);
+    auto offset = data::aligned_size<GamutMeshData>() + data::aligned_size<GamutMeshLevel>(level_count);
+
+    for (uint32_t il = 0; il < level_count; ++il)
+    {
+        auto& level = levels[il];
+
+        level.hue_count    = hue_count  >> il;
+        level.band_count   = band_count >> il;
+        level.vertex_count = gamut_mesh_vertex_count(level.hue_count, level.band_count);
+        level.index_count  = gamut_mesh_index_count(level.hue_count, level.band_count);
+        level.vertices     = offset;
+        offset            += data::aligned_size<simd::float4>(level.vertex_count);
+        level.indices      = offset;
+        offset            += data::aligned_size<uint32_t>(level.index_count);
+    }
+
+    storage_.resize( offset / sizeof(simd::float4) );
+
+    auto& mesh = *reinterpret_cast<GamutMeshData*>( storage_.data() );
+
+    mesh.size        = offset;
+    mesh.level_count = level_count;
+    mesh.levels      = data::aligned_size<GamutMeshData>();
+
+    std::copy( levels.begin(), levels.end(), data::offset_by<GamutMeshLevel>(&mesh, mesh.levels) );
+
+    // • Levels; level il keeps every (1 << il)th hue and band of the finest
+    //
+    pool.parallel_for( level_count, [&](uint32_t il) {
+
+        const auto& level         = levels[il];
+        const auto  stride        = 1u << il;
+        const auto  level_profile = gamut_mesh_profile_size(level.band_count);
+
+        auto vertices = data::offset_by<simd::float4>(&mesh, level.vertices);
+        auto indices  = data::offset_by<uint32_t>(&mesh, level.indices);
+
+        *vertices++ = make_vertex(poles.low);
+        *vertices++ = make_vertex(poles.high);
+
+        for (uint32_t ih = 0; ih < level.hue_count; ++ih)
+        {
+            const auto profile = profiles.data() + ih*stride*profile_size;
+
+            for (uint32_t j = 0; j < level_profile; ++j)
+            {
+                *vertices++ = (j < level.band_count) ? profile[(j + 1)*stride - 1]
+                                                     : profile[profile_size - (level_profile - j)*stride];
+            }
+        }
+
+        // • Counter-clockwise from outside: black fan, bands, white fan
+        //
+        const auto ring = [&](uint32_t ih, uint32_t j) {
+            return 2 + (ih % level.hue_count)*level_profile + j;
+        };
+
+        for (uint32_t ih = 0; ih < level.hue_count; ++ih)
+        {
+            *indices++ = 0;
+            *indices++ = ring(ih + 1, 0);
+            *indices++ = ring(ih, 0);
+
+            for (uint32_t j = 0; j + 1 < level_profile; ++j)
+            {
+                *indices++ = ring(ih, j);
+                *indices++ = ring(ih + 1, j);
+                *indices++ = ring(ih + 1, j + 1);
+
+                *indices++ = ring(ih, j);
+                *indices++ = ring(ih + 1, j + 1);
+                *indices++ = ring(ih, j + 1);
+            }
+
+            *indices++ = 1;
+            *indices++ = ring(ih, level_profile - 1);
+            *indices++ = ring(ih + 1, level_profile - 1);
+        }
+    });
+}
+
+//===------------------------------------------------------------------------===
+// • Access
+//===------------------------------------------------------------------------===
+
+const GamutMeshLevel& gamut_mesh_level(const GamutMeshData& mesh, uint32_t level)
+{
+    return data::offset_by<GamutMeshLevel>(&mesh, mesh.levels)[ std::min(level, mesh.level_count - 1) ];
+}
+
+const simd::float4* gamut_mesh_vertices(const GamutMeshData& mesh, const GamutMeshLevel& level)
+{
+    return data::offset_by<simd::float4>(&mesh, level.vertices);
+}
+
+const uint32_t* gamut_mesh_indices(const GamutMeshData& mesh, const GamutMeshLevel& level)
+{
+    return data::offset_by<uint32_t>(&mesh, level.indices);
+}
+
+//===------------------------------------------------------------------------===
+// • view_gamut_mesh
+//===------------------------------------------------------------------------===
+
+const GamutMeshData* view_gamut_mesh(const void* bytes, size_t size)
+{
+    if ( nullptr == bytes || !data::is_aligned(bytes) || size < sizeof(GamutMeshData) )
+    {
+        return nullptr;
+    }
+
+    const auto mesh = static_cast<const GamutMeshData*>(bytes);
+
+    if ( size < mesh->size || 0 == mesh->level_count
+        || !is_within(*mesh, mesh->levels, uint64_t{ mesh->level_count } * sizeof(GamutMeshLevel)) )
+    {
+        return nullptr;
+    }
+
+    for (uint32_t il = 0; il < mesh->level_count; ++il)
+    {
+        const auto& level = gamut_mesh_level(*mesh, il);
+
+        if (   level.hue_count < 3 || 0 == level.band_count
+            || level.vertex_count != gamut_mesh_vertex_count(level.hue_count, level.band_count)
+            || level.index_count  != gamut_mesh_index_count(level.hue_count, level.band_count)
+            || !is_within(*mesh, level.vertices, uint64_t{ level.vertex_count } * sizeof(simd::float4))
+            || !is_within(*mesh, level.indices,  uint64_t{ level.index_count }  * sizeof(uint32_t)) )
+        {
+            return nullptr;
+        }
+    }
+
+    return mesh;
+}
+
+//===------------------------------------------------------------------------===
+// • is_inside_gamut_mesh
+//===------------------------------------------------------------------------===
+
+bool is_inside_gamut_mesh(const GamutMeshData& mesh, simd::float3 jab, uint32_t level_index)
+{
+    const auto& level    = gamut_mesh_level(mesh, level_index);
+    const auto  vertices = gamut_mesh_vertices(mesh, level);
+
+    // • Adjacent profiles around the hue of `jab`
+    //
+    const auto hue      = atan2f(jab[2], jab[1]) * 180.0f / static_cast<float>(M_PI);
+    const auto position = (hue + 180.0f) * static_cast<float>(level.hue_count) / 360.0f;
+    const auto lower    = static_cast<uint32_t>( std::max(position, 0.0f) ) % level.hue_count;
+    const auto upper    = (lower + 1) % level.hue_count;
+    const auto fraction = position - floorf(position);
+
+    const auto cusp_chroma = [&](uint32_t profile) {
+
+        const auto cusp = vertices[2 + profile*gamut_mesh_profile_size(level.band_count) + level.band_count - 1];
+
+        return sqrtf(cusp[1]*cusp[1] + cusp[2]*cusp[2]);
+    };
+
+    const auto chroma     = sqrtf(jab[1]*jab[1] + jab[2]*jab[2]);
+    const auto max_chroma = mix( cusp_chroma(lower), cusp_chroma(upper), fraction );
+
+    if (max_chroma <= chroma)
+    {
+        return false;
+    }
+
+    // • Boundaries at the chroma fraction of `jab`
+    //
+    const auto t      = chroma / max_chroma;
+    const auto bounds = boundary_Jz(vertices, level.band_count, lower, t)
+                      + fraction*( boundary_Jz(vertices, level.band_count, upper, t)
+                                 - boundary_Jz(vertices, level.band_count, lower, t) );
+
+    return bounds[0] <= jab[0] && jab[0] <= bounds[1];
+}
+
+} // namespace jzazbz
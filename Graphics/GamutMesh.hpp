@@ -0,0 +1,125 @@
+//
+//  GamutMesh.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/GamutMeshData.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/ThreadPool.hpp>
+
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • Display P3 gamut solid mesh (Host)
+//
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Mesh parameters
+//
+//  Hue and band counts are those of the coarsest level; each finer level
+//  doubles both. Boundary points are solved as in `generate_vertices`
+//===------------------------------------------------------------------------===
+
+struct GamutMeshParameters
+{
+    uint32_t    hue_count;
+    uint32_t    band_count;
+    uint32_t    level_count;
+    uint32_t    lane_count;
+    float       accuracy;
+};
+
+constexpr GamutMeshParameters default_gamut_mesh_parameters = {
+    .hue_count       = 12,
+    .band_count      = 4,
+    .level_count     = 4,
+    .lane_count      = 32,
+    .accuracy        = default_search_accuracy
+};
+
+//===------------------------------------------------------------------------===
+// • GamutMesh
+//
+//  Owns a GamutMeshData block. The finest level's profiles are solved in
+//  parallel, one hue per task; coarser levels take every other hue and band
+//  of the level below. bytes() and size() are the serialized form
+//===------------------------------------------------------------------------===
+
+class GamutMesh
+{
+public:
+
+    explicit GamutMesh(const GamutMeshParameters& parameters = default_gamut_mesh_parameters,
+                       utilities::ThreadPool&     pool       = utilities::ThreadPool::shared());
+
+    const GamutMeshData& data(void) const noexcept
+    {
+        return *reinterpret_cast<const GamutMeshData*>( storage_.data() );
+    }
+
+    const void* bytes(void) const noexcept
+    {
+        return storage_.data();
+    }
+
+    uint32_t size(void) const noexcept
+    {
+        return data().size;
+    }
+
+private:
+
+    std::vector<simd::float4>   storage_;   // 16-byte aligned
+};
+
+//===------------------------------------------------------------------------===
+// • Access
+//===------------------------------------------------------------------------===
+
+const GamutMeshLevel& gamut_mesh_level(const GamutMeshData& mesh, uint32_t level);
+const simd::float4*   gamut_mesh_vertices(const GamutMeshData& mesh, const GamutMeshLevel& level);
+const uint32_t*       gamut_mesh_indices(const GamutMeshData& mesh, const GamutMeshLevel& level);
+
+//===------------------------------------------------------------------------===
+// • view_gamut_mesh
+//
+//  Zero-copy load: `bytes` (16-byte aligned) viewed as a mesh if its header,
+//  levels and offsets are consistent and within `size`, nullptr otherwise.
+//  Index values are not checked
+//===------------------------------------------------------------------------===
+
+const GamutMeshData* view_gamut_mesh(const void* bytes, size_t size);
+
+//===------------------------------------------------------------------------===
+// • is_inside_gamut_mesh
+//
+//  Constant-time inside/outside test against the surface through a level's
+//  vertices, bilinear in hue and chroma fraction between adjacent profiles
+//  and bands: `jab` is inside if its Jz lies between the lower and upper
+//  boundaries at its hue and chroma
+//===------------------------------------------------------------------------===
+
+bool is_inside_gamut_mesh(const GamutMeshData& mesh, simd::float3 jab, uint32_t level = 0);
+
+} // namespace jzazbz
@@ -0,0 +1,81 @@
+//
+//  GamutMeshData.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Layout.hpp>
+#include <simd/simd.h>
+
+//===------------------------------------------------------------------------===
+//
+// • GamutMeshData
+//
+//  Closed Display P3 gamut surface in Jzazbz as one relocatable block: the
+//  header, then a GamutMeshLevel per level of detail, then each level's
+//  vertices and triangle indices. Offsets are in bytes from the header and
+//  16-byte aligned, so a block mapped or copied as is (a file, an MTLBuffer)
+//  is usable without fix-ups.
+//
+//  Level 0 is the finest. A level's vertices (jab, w = 0) are the black and
+//  white poles followed by one profile of 2 × band_count - 1 vertices per
+//  hue, from black up the lower boundary to the cusp and back down the upper
+//  boundary toward white. Hue i is at 360 × i / hue_count - 180 degrees and
+//  band k at chroma k / band_count of the hue's cusp, as in the slice strip.
+//  Triangles are wound counter-clockwise seen from outside.
+//
+//===------------------------------------------------------------------------===
+
+struct GamutMeshLevel
+{
+    uint32_t    hue_count;
+    uint32_t    band_count;
+    uint32_t    vertices;           // offset of vertex_count simd::float4
+    uint32_t    vertex_count;
+    uint32_t    indices;            // offset of index_count uint32_t
+    uint32_t    index_count;
+};
+
+struct GamutMeshData
+{
+    uint32_t    size;               // bytes, including the header
+    uint32_t    level_count;
+    uint32_t    levels;             // offset of level_count GamutMeshLevel
+};
+
+constexpr uint32_t gamut_mesh_profile_size(uint32_t band_count)
+{
+    return 2*band_count - 1;
+}
+
+constexpr uint32_t gamut_mesh_vertex_count(uint32_t hue_count, uint32_t band_count)
+{
+    return 2 + hue_count*gamut_mesh_profile_size(band_count);
+}
+
+constexpr uint32_t gamut_mesh_index_count(uint32_t hue_count, uint32_t band_count)
+{
+    // • Two pole fans and the quads between adjacent profiles
+    //
+    return 6*hue_count*gamut_mesh_profile_size(band_count);
+}
+
+#if !defined ( __METAL_VERSION__ )
+static_assert( data::is_trivial_layout<GamutMeshLevel>(), "Unexpected layout" );
+static_assert( data::is_trivial_layout<GamutMeshData>(), "Unexpected layout" );
+#endif
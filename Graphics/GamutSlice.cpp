@@ -0,0 +1,254 @@
+//
+//  GamutSlice.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/GamutSlice.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/Instrumentation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    simd::float3 mix(simd::float3 x, simd::float3 y, float t)
+    {
+        return x + t*(y - x);
+    }
+
+    bool is_in_gamut(simd::float3 jab)
+    {
+        const auto lrgb    = jzazbz::convert_to_linear_display_P3(jab);
+        const auto clamped = simd::clamp( lrgb, simd::float3(0.0f), simd::float3(1.0f) );
+
+        return simd::all(lrgb == clamped);
+    }
+
+    // • Distance from `point` to the chord (a, b), in the plane of Jz and
+    //   chroma in which the slice is drawn
+    //
+    float chord_distance(simd::float3 point, simd::float3 a, simd::float3 b)
+    {
+        const auto plane = [](simd::float3 jab) {
+            return simd::float2{ jab[0], sqrtf(jab[1]*jab[1] + jab[2]*jab[2]) };
+        };
+
+        const auto p  = plane(point);
+        const auto pa = plane(a);
+        const auto ab = plane(b) - pa;
+        const auto dd = simd::dot(ab, ab);
+        const auto t  = (0.0f < dd) ? std::clamp(simd::dot(p - pa, ab) / dd, 0.0f, 1.0f) : 0.0f;
+
+        return simd::length( p - (pa + t*ab) );
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • generate_slice_vertices
+//===------------------------------------------------------------------------===
+
+SliceBand solve_slice_band(simd::float3 max_c_jab, float band_t, const SliceParameters& parameters)
+{
+    INSTRUMENT_TIMER(slice_band);
+
+    constexpr auto white_Jz = 0.16717463103478347f;
+
+    const auto height          = static_cast<float>(parameters.lane_count);
+    const auto iteration_count = slice_iteration_count(parameters.accuracy, parameters.lane_count);
+
+    INSTRUMENT_COUNT(slice_band_solves, 1);
+    INSTRUMENT_COUNT(slice_band_iterations, iteration_count);
+
+    // • Find the top and bottom intersections with the in-gamut Jzazbz solid
+    //
+    auto outer_high = mix( simd::float3{ white_Jz *  1.33f, 0.0f, 0.0f }, max_c_jab, band_t );
+    auto inner_high = mix( simd::float3{ white_Jz *  0.67f, 0.0f, 0.0f }, max_c_jab, band_t );
+    auto inner_low  = mix( simd::float3{ white_Jz *  0.25f, 0.0f, 0.0f }, max_c_jab, band_t );
+    auto outer_low  = mix( simd::float3{ white_Jz * -0.67f, 0.0f, 0.0f }, max_c_jab, band_t );
+
+    for (uint32_t i = 0; i < iteration_count; ++i)
+    {
+        // • simd_max over the lanes that pass
+        //
+        auto upper_t = -1.0f;
+        auto lower_t = -1.0f;
+
+        for (uint32_t lane = 0; lane < parameters.lane_count; ++lane)
+        {
+            const auto lane_t    = static_cast<float>(lane) / height;
+            const auto upper_jab = mix(inner_high, outer_high, lane_t);
+            const auto lower_jab = mix(inner_low, outer_low, lane_t);
+
+            if ( is_in_gamut(upper_jab) )
+            {
+                upper_t = std::max(upper_t, lane_t);
+            }
+
+            if ( 0.0f <= lower_jab[0] && is_in_gamut(lower_jab) )
+            {
+                lower_t = std::max(lower_t, lane_t);
+            }
+        }
+
+        const auto new_outer_high = mix(inner_high, outer_high, upper_t + 1.0f/height);
+        const auto new_inner_high = mix(inner_high, outer_high, upper_t);
+        const auto new_inner_low  = mix(inner_low, outer_low, lower_t);
+        const auto new_outer_low  = mix(inner_low, outer_low, lower_t + 1.0f/height);
+
+        outer_high = new_outer_high;
+        inner_high = new_inner_high;
+        inner_low  = new_inner_low;
+        outer_low  = new_outer_low;
+    }
+
+    return { .low = inner_low, .high = inner_high };
+}
+
+void generate_slice_vertices(simd::float3            max_c_jab,
+                             simd::float4*           vertices,
+                             const SliceParameters&  parameters)
+{
+    const auto width = static_cast<float>(parameters.band_count);
+
+    for (uint32_t band = 0; band < parameters.band_count; ++band)
+    {
+        const auto solved = solve_slice_band( max_c_jab, static_cast<float>(band) / width, parameters );
+
+        vertices[2*band]   = simd::float4{ solved.low[0],  solved.low[1],  solved.low[2],  0.0f };
+        vertices[2*band+1] = simd::float4{ solved.high[0], solved.high[1], solved.high[2], 0.0f };
+    }
+
+    vertices[2*parameters.band_count] = simd::float4{ max_c_jab[0], max_c_jab[1], max_c_jab[2], 0.0f };
+}
+
+//===------------------------------------------------------------------------===
+// • generate_adaptive_slice_vertices
+//===------------------------------------------------------------------------===
+
+uint32_t generate_adaptive_slice_vertices(simd::float3                      max_c_jab,
+                                          simd::float4*                     vertices,
+                                          const AdaptiveSliceParameters&    adaptive,
+                                          const SliceParameters&            parameters)
+{
+    const auto initial_band_count = std::max(adaptive.initial_band_count, 1u);
+    const auto max_band_count     = std::max(adaptive.max_band_count, initial_band_count);
+
+    // • Boundary samples; t = 1 is the cusp, where both boundaries meet
+    //
+    struct Sample
+    {
+        float       t;
+        SliceBand   band;
+    };
+
+    const auto sample = [&](float t) {
+
+        return Sample{
+            .t    = t,
+            .band = (t < 1.0f) ? solve_slice_band(max_c_jab, t, parameters)
+                               : SliceBand{ .low = max_c_jab, .high = max_c_jab }
+        };
+    };
+
+    // • Intervals between adjacent samples, with the midpoint sample and its
+    //   distance from the chords of both boundaries in the Jz/Cz plane
+    //
+    struct Interval
+    {
+        Sample      lower;
+        Sample      upper;
+        Sample      middle;
+        float       error;
+    };
+
+    const auto make_interval = [&](const Sample& lower, const Sample& upper) {
+
+        const auto middle = sample( 0.5f*(lower.t + upper.t) );
+        const auto error  = std::max( chord_distance(middle.band.low,  lower.band.low,  upper.band.low),
+                                      chord_distance(middle.band.high, lower.band.high, upper.band.high) );
+
+        return Interval{ .lower = lower, .upper = upper, .middle = middle, .error = error };
+    };
+
+    const auto by_error = [](const Interval& lhs, const Interval& rhs) {
+        return lhs.error < rhs.error;
+    };
+
+    auto intervals = std::vector<Interval>{};
+    auto previous  = sample(0.0f);
+
+    for (uint32_t band = 1; band <= initial_band_count; ++band)
+    {
+        const auto next = sample( static_cast<float>(band) / static_cast<float>(initial_band_count) );
+
+        intervals.push_back( make_interval(previous, next) );
+        previous = next;
+    }
+
+    std::make_heap(intervals.begin(), intervals.end(), by_error);
+
+    // • Split the worst interval until every chord is within budget
+    //
+    while ( intervals.size() < max_band_count && adaptive.error_budget < intervals.front().error )
+    {
+        std::pop_heap(intervals.begin(), intervals.end(), by_error);
+
+        const auto worst = intervals.back();
+
+        intervals.back() = make_interval(worst.lower, worst.middle);
+        std::push_heap(intervals.begin(), intervals.end(), by_error);
+
+        intervals.push_back( make_interval(worst.middle, worst.upper) );
+        std::push_heap(intervals.begin(), intervals.end(), by_error);
+    }
+
+    // • Strip in band order, ending at the cusp
+    //
+    std::sort( intervals.begin(), intervals.end(), [](const Interval& lhs, const Interval& rhs) {
+        return lhs.lower.t < rhs.lower.t;
+    });
+
+    auto vertex = vertices;
+
+    for (const auto& interval : intervals)
+    {
+        const auto& band = interval.lower.band;
+
+        *vertex++ = simd::float4{ band.low[0],  band.low[1],  band.low[2],  0.0f };
+        *vertex++ = simd::float4{ band.high[0], band.high[1], band.high[2], 0.0f };
+    }
+
+    *vertex++ = simd::float4{ max_c_jab[0], max_c_jab[1], max_c_jab[2], 0.0f };
+
+    return static_cast<uint32_t>(vertex - vertices);
+}
+
+} // namespace jzazbz
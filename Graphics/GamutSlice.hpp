@@ -0,0 +1,130 @@
+//
+//  GamutSlice.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Jzazbz.hpp>
+#include <simd/simd.h>
+
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+//
+// • Display P3 gamut slice at constant hue (Host)
+//
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Slice parameters
+//
+//  Mirrors the `generate_vertices` dispatch: one band per threadgroup row and
+//  `lane_count` lanes (thread execution width) subdividing each bracket until
+//  it is within `accuracy` (Jzazbz units)
+//===------------------------------------------------------------------------===
+
+struct SliceParameters
+{
+    uint32_t    band_count;
+    uint32_t    lane_count;
+    float       accuracy;
+};
+
+constexpr SliceParameters default_slice_parameters = {
+    .band_count      = 64,
+    .lane_count      = 32,
+    .accuracy        = default_search_accuracy
+};
+
+constexpr uint32_t slice_vertex_count(uint32_t band_count)
+{
+    return 2*band_count + 1;
+}
+
+constexpr uint32_t slice_vertex_count(const SliceParameters& parameters)
+{
+    return slice_vertex_count(parameters.band_count);
+}
+
+//===------------------------------------------------------------------------===
+// • generate_slice_vertices
+//
+//  Host counterpart of the `generate_vertices` kernel. Writes the triangle
+//  strip (inner_low, inner_high) for each band from neutral toward
+//  `max_c_jab`, followed by `max_c_jab` itself; w is 0
+//===------------------------------------------------------------------------===
+
+void generate_slice_vertices(simd::float3            max_c_jab,
+                             simd::float4*           vertices,
+                             const SliceParameters&  parameters = default_slice_parameters);
+
+//===------------------------------------------------------------------------===
+// • solve_slice_band
+//
+//  One band of `generate_vertices`: the lower and upper boundary points at
+//  `band_t` in [0, 1) along the way from neutral to `max_c_jab`
+//===------------------------------------------------------------------------===
+
+struct SliceBand
+{
+    simd::float3    low;
+    simd::float3    high;
+};
+
+SliceBand solve_slice_band(simd::float3            max_c_jab,
+                           float                   band_t,
+                           const SliceParameters&  parameters = default_slice_parameters);
+
+//===------------------------------------------------------------------------===
+// • generate_adaptive_slice_vertices
+//
+//  Same strip layout as generate_slice_vertices, with bands placed where the
+//  boundary bends. Starting from `initial_band_count` uniform bands, the
+//  interval whose midpoint lies farthest from the chords of the upper or
+//  lower boundary (in the Jz/Cz plane, Jzazbz units) is split until every
+//  midpoint is within `error_budget` or `max_band_count` is reached. Bands
+//  crowd toward the cusp, where the curvature is. `vertices` must hold
+//  slice_vertex_count(max_band_count); returns the vertex count.
+//
+//  Host only: the `generate_vertices` kernel dispatches one threadgroup row
+//  per uniform band into a fixed 129-vertex strip, so the app does not use
+//  this. Tools/SliceBenchmark measures both placements at equal vertex count
+//===------------------------------------------------------------------------===
+
+struct AdaptiveSliceParameters
+{
+    float       error_budget;
+    uint32_t    initial_band_count;
+    uint32_t    max_band_count;
+};
+
+constexpr AdaptiveSliceParameters default_adaptive_slice_parameters = {
+    .error_budget       = 5.0e-5f,
+    .initial_band_count = 8,
+    .max_band_count     = 128
+};
+
+uint32_t generate_adaptive_slice_vertices(simd::float3                      max_c_jab,
+                                          simd::float4*                     vertices,
+                                          const AdaptiveSliceParameters&    adaptive   = default_adaptive_slice_parameters,
+                                          const SliceParameters&            parameters = default_slice_parameters);
+
+} // namespace jzazbz
@@ -82,6 +82,34 @@ constexpr bool contains(const Region rgn, simd::uint2 point)
         && rgn.top  <= point.y && point.y < rgn.bottom;
 }
 
+constexpr bool is_empty(const Region rgn)
+{
+    return rgn.right <= rgn.left || rgn.bottom <= rgn.top;
+}
+
+constexpr bool intersects(const Region lhs, const Region rhs)
+{
+    return lhs.left < rhs.right && rhs.left < lhs.right
+        && lhs.top  < rhs.bottom && rhs.top < lhs.bottom;
+}
+
+// • Empty regions keep a valid (non-inverted) shape
+//
+constexpr Region intersection(const Region lhs, const Region rhs)
+{
+    const auto left   = (lhs.left   < rhs.left)   ? rhs.left   : lhs.left;
+    const auto top    = (lhs.top    < rhs.top)    ? rhs.top    : lhs.top;
+    const auto right  = (lhs.right  < rhs.right)  ? lhs.right  : rhs.right;
+    const auto bottom = (lhs.bottom < rhs.bottom) ? lhs.bottom : rhs.bottom;
+
+    return {
+        .left   = left,
+        .top    = top,
+        .right  = (left < right)  ? right  : left,
+        .bottom = (top  < bottom) ? bottom : top
+    };
+}
+
 constexpr bool operator == (const Region lhs, const Region rhs)
 {
     return lhs.left   == rhs.left
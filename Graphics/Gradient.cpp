@@ -0,0 +1,377 @@
+//
+//  Gradient.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/Gradient.hpp>
+#include <Graphics/JzazbzBatch.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    // • Below this Cz the hue is noise (Display P3 neutrals reach 1.7e-4)
+    //
+    constexpr float achromatic_Cz = 5.0e-4f;
+
+    // • Display P3 gamut test, with room for the round trip of neutrals
+    //
+    bool is_inside_P3(simd::float3 jab)
+    {
+        constexpr auto tolerance = 1.0e-4f;
+
+        const auto lrgb = convert_to_linear_display_P3(jab);
+
+        return -tolerance <= simd::reduce_min(lrgb) && simd::reduce_max(lrgb) <= 1.0f + tolerance;
+    }
+
+    float wrap_radians(float angle)
+    {
+        constexpr auto pi = static_cast<float>(M_PI);
+
+        return angle - 2.0f*pi * floorf( (angle + pi) / (2.0f*pi) );
+    }
+
+    // • Four texels at a time; the tail is padded with the last color
+    //
+    template <typename Store_>
+    void evaluate_texels(const Gradient& gradient, uint32_t width, Store_ store)
+    {
+        const auto scale = 1.0f / static_cast<float>(width);
+
+        for (uint32_t first = 0; first < width; first += 4)
+        {
+            auto jab = Colors4{};
+
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                const auto texel = std::min(first + lane, width - 1);
+                const auto value = gradient.evaluate( (static_cast<float>(texel) + 0.5f) * scale );
+
+                jab.x[lane] = value[0];
+                jab.y[lane] = value[1];
+                jab.z[lane] = value[2];
+            }
+
+            const auto lrgb  = convert_to_linear_display_P3(jab);
+            const auto count = std::min(4u, width - first);
+
+            for (uint32_t lane = 0; lane < count; ++lane)
+            {
+                const auto texel = simd::float4{ lrgb.x[lane], lrgb.y[lane], lrgb.z[lane], 1.0f };
+
+                store( first + lane, simd::clamp( texel, simd::float4(0.0f), simd::float4(1.0f) ) );
+            }
+        }
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Gamut mapping
+//===------------------------------------------------------------------------===
+
+simd::float3 map_into_gamut(simd::float3 jab, float accuracy)
+{
+    static const auto white_Jz = convert_from_linear_display_P3( simd::float3(1.0f) )[0];
+
+    const auto mapped = simd::float3{ std::clamp(jab[0], 0.0f, white_Jz), jab[1], jab[2] };
+
+    if ( is_inside_P3(mapped) )
+    {
+        return mapped;
+    }
+
+    // • Bisect the chroma scale, keeping the inside end
+    //
+    const auto Cz = sqrtf(jab[1]*jab[1] + jab[2]*jab[2]);
+
+    auto lower = 0.0f;
+    auto upper = 1.0f;
+
+    while ( accuracy < (upper - lower) * Cz )
+    {
+        const auto middle = 0.5f * (lower + upper);
+
+        if ( is_inside_P3( simd::float3{ mapped[0], middle * mapped[1], middle * mapped[2] } ) )
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+
+    return simd::float3{ mapped[0], lower * mapped[1], lower * mapped[2] };
+}
+
+//===------------------------------------------------------------------------===
+// • Gradient
+//===------------------------------------------------------------------------===
+
+Gradient::Gradient(const GradientStop* stops, uint32_t count, GradientInterpolation interpolation)
+    : interpolation_( interpolation )
+    , stops_        ( stops, stops + count )
+{
+    for (auto& stop : stops_)
+    {
+        stop.position = std::clamp(stop.position, 0.0f, 1.0f);
+        stop.jab      = map_into_gamut(stop.jab);
+    }
+
+    std::stable_sort( stops_.begin(), stops_.end(), [](const GradientStop& a, const GradientStop& b) {
+        return a.position < b.position;
+    });
+
+    for (size_t i = 1; i < stops_.size(); ++i)
+    {
+        const auto start = stops_[i - 1].jab;
+        const auto end   = stops_[i].jab;
+
+        if (GradientInterpolation::linear == interpolation_)
+        {
+            coordinates_.push_back(start);
+            coordinates_.push_back(end);
+            continue;
+        }
+
+        const auto start_Cz = sqrtf(start[1]*start[1] + start[2]*start[2]);
+        const auto end_Cz   = sqrtf(end[1]*end[1] + end[2]*end[2]);
+
+        // • An achromatic end takes the other's hue
+        //
+        auto start_hz = atan2f(start[2], start[1]);
+        auto end_hz   = atan2f(end[2], end[1]);
+
+        if (start_Cz < achromatic_Cz)
+        {
+            start_hz = end_hz;
+        }
+        else if (end_Cz < achromatic_Cz)
+        {
+            end_hz = start_hz;
+        }
+
+        coordinates_.push_back( simd::float3{ start[0], start_Cz, start_hz } );
+        coordinates_.push_back( simd::float3{ end[0], end_Cz, start_hz + wrap_radians(end_hz - start_hz) } );
+    }
+}
+
+simd::float3 Gradient::interpolate(uint32_t segment, float t) const noexcept
+{
+    const auto start = coordinates_[2*segment];
+    const auto end   = coordinates_[2*segment + 1];
+    const auto value = start + t*(end - start);
+
+    if (GradientInterpolation::linear == interpolation_)
+    {
+        return value;
+    }
+
+    return simd::float3{ value[0], value[1] * cosf(value[2]), value[1] * sinf(value[2]) };
+}
+
+simd::float3 Gradient::evaluate(float t) const noexcept
+{
+    if ( stops_.empty() )
+    {
+        return simd::float3(0.0f);
+    }
+
+    if (t <= stops_.front().position)
+    {
+        return stops_.front().jab;
+    }
+
+    if (stops_.back().position <= t)
+    {
+        return stops_.back().jab;
+    }
+
+    // • First stop past t: the segment ends there and has positive length
+    //
+    const auto upper = std::upper_bound( stops_.begin(), stops_.end(), t, [](float value, const GradientStop& stop) {
+        return value < stop.position;
+    });
+
+    const auto segment = static_cast<uint32_t>( upper - stops_.begin() ) - 1;
+    const auto start   = stops_[segment].position;
+    const auto end     = upper->position;
+
+    return interpolate( segment, (t - start) / (end - start) );
+}
+
+void Gradient::evaluate(simd::float4* texels, uint32_t width) const
+{
+    evaluate_texels( *this, width, [=](uint32_t texel, simd::float4 value) {
+        texels[texel] = value;
+    });
+}
+
+void Gradient::evaluate(data::half4* texels, uint32_t width) const
+{
+    evaluate_texels( *this, width, [=](uint32_t texel, simd::float4 value) {
+        texels[texel] = data::make_half4(value);
+    });
+}
+
+//===------------------------------------------------------------------------===
+// • GradientCache
+//===------------------------------------------------------------------------===
+
+GradientCache::GradientCache(const Parameters& parameters)
+    : parameters_( parameters )
+    , statistics_( {} )
+{
+}
+
+size_t GradientCache::KeyHash::operator () (const Key& key) const noexcept
+{
+    // • FNV-1a over the words
+    //
+    auto hash = uint64_t{ 14695981039346656037ull };
+
+    for (const auto word : key)
+    {
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+
+    return static_cast<size_t>(hash);
+}
+
+size_t GradientCache::entry_size(const Entry& entry) noexcept
+{
+    return entry.key.size() * sizeof(uint32_t) + entry.texels->size() * sizeof(simd::float4);
+}
+
+GradientCache::Texels GradientCache::find(const GradientStop*   stops,
+                                          uint32_t              count,
+                                          GradientInterpolation interpolation,
+                                          uint32_t              width)
+{
+    auto key = Key{};
+
+    key.reserve(4*count + 2);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        key.push_back( std::bit_cast<uint32_t>(stops[i].position) );
+        key.push_back( std::bit_cast<uint32_t>(stops[i].jab[0]) );
+        key.push_back( std::bit_cast<uint32_t>(stops[i].jab[1]) );
+        key.push_back( std::bit_cast<uint32_t>(stops[i].jab[2]) );
+    }
+
+    key.push_back( static_cast<uint32_t>(interpolation) );
+    key.push_back(width);
+
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+        if ( const auto found = lookup_.find(key); lookup_.end() != found )
+        {
+            entries_.splice(entries_.begin(), entries_, found->second);
+
+            ++statistics_.hit_count;
+
+            return found->second->texels;
+        }
+
+        ++statistics_.miss_count;
+    }
+
+    // • Evaluate outside the lock
+    //
+    auto evaluated = std::make_shared<std::vector<simd::float4>>(width);
+
+    Gradient(stops, count, interpolation).evaluate(evaluated->data(), width);
+
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    // • Another thread may have evaluated the same gradient meanwhile
+    //
+    if ( const auto found = lookup_.find(key); lookup_.end() != found )
+    {
+        return found->second->texels;
+    }
+
+    entries_.push_front( Entry{ .key = std::move(key), .texels = evaluated } );
+    lookup_.emplace(entries_.front().key, entries_.begin());
+
+    statistics_.size += entry_size( entries_.front() );
+
+    // • Evict down to the budget (the caller keeps its own reference)
+    //
+    while ( parameters_.memory_budget < statistics_.size && !entries_.empty() )
+    {
+        statistics_.size -= entry_size( entries_.back() );
+        ++statistics_.eviction_count;
+
+        lookup_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+
+    statistics_.entry_count = static_cast<uint32_t>( entries_.size() );
+
+    return evaluated;
+}
+
+//===------------------------------------------------------------------------===
+// • Maintenance
+//===------------------------------------------------------------------------===
+
+GradientCache::Statistics GradientCache::statistics(void) const
+{
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    return statistics_;
+}
+
+void GradientCache::reset_statistics(void)
+{
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    statistics_.hit_count      = 0;
+    statistics_.miss_count     = 0;
+    statistics_.eviction_count = 0;
+}
+
+void GradientCache::clear(void)
+{
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    entries_.clear();
+    lookup_.clear();
+
+    statistics_.entry_count = 0;
+    statistics_.size        = 0;
+}
+
+} // namespace jzazbz
@@ -0,0 +1,214 @@
+//
+//  Gradient.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Half.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <simd/simd.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Gamut mapping
+//
+//  Jz clamped to [0, white], then chroma reduced at constant Jz and hue
+//  until the color is inside Display P3, to within `accuracy` in Cz
+//===------------------------------------------------------------------------===
+
+simd::float3 map_into_gamut(simd::float3 jab, float accuracy = default_search_accuracy);
+
+//===------------------------------------------------------------------------===
+//
+// • Gradient (Host only)
+//
+//  N stops in Jzazbz, each mapped into gamut when the gradient is made, and
+//  interpolated either linearly in Jzazbz or in JzCzhz along the shorter hue
+//  arc (an achromatic stop takes its neighbour's hue). Positions are clamped
+//  to [0, 1] and sorted; before the first and after the last stop the end
+//  colors extend.
+//
+//  Evaluation writes linear Display P3 at texel centers, four texels at a
+//  time through a four-wide transposition of convert_to_linear_display_P3.
+//  Polar interpolation between in-gamut stops can leave the gamut; such
+//  samples are clipped.
+//
+//===------------------------------------------------------------------------===
+
+enum class GradientInterpolation : uint32_t
+{
+    linear,     // Jzazbz
+    polar       // JzCzhz
+};
+
+struct GradientStop
+{
+    float           position;
+    simd::float3    jab;
+};
+
+class Gradient
+{
+public:
+
+    Gradient(const GradientStop* stops, uint32_t count, GradientInterpolation interpolation);
+
+    // • Single sample at `t` in [0, 1], Jzazbz
+    //
+    simd::float3 evaluate(float t) const noexcept;
+
+    // • `width` texels (a texture row or strip), alpha 1
+    //
+    void evaluate(simd::float4* texels, uint32_t width) const;
+    void evaluate(data::half4*  texels, uint32_t width) const;
+
+    // • Properties
+    //
+    GradientInterpolation interpolation(void) const noexcept
+    {
+        return interpolation_;
+    }
+
+    // • Mapped stops, sorted
+    //
+    const std::vector<GradientStop>& stops(void) const noexcept
+    {
+        return stops_;
+    }
+
+private:
+
+    simd::float3 interpolate(uint32_t segment, float t) const noexcept;
+
+    const GradientInterpolation     interpolation_;
+    std::vector<GradientStop>       stops_;
+
+    // • Start and end of each segment in the interpolation space: Jzazbz, or
+    //   (Jz, Cz, hz) with hz in radians, the end unwrapped to the shorter arc
+    //
+    std::vector<simd::float3>       coordinates_;
+};
+
+//===------------------------------------------------------------------------===
+//
+// • GradientCache (Host only)
+//
+//  Evaluated linear Display P3 rows keyed by stop set, interpolation and
+//  width, kept in least-recently-used order within a memory budget, as
+//  SliceCache. Stop sets match on exact values. Misses are evaluated outside
+//  the lock; rows stay alive while in use even if evicted.
+//
+//===------------------------------------------------------------------------===
+
+class GradientCache
+{
+public:
+
+    struct Parameters
+    {
+        size_t      memory_budget;  // bytes
+    };
+
+    static constexpr Parameters default_parameters = {
+        .memory_budget = 8 << 20
+    };
+
+    struct Statistics
+    {
+        uint64_t    hit_count;
+        uint64_t    miss_count;
+        uint64_t    eviction_count;
+        uint32_t    entry_count;
+        size_t      size;           // bytes held
+    };
+
+    using Texels = std::shared_ptr<const std::vector<simd::float4>>;
+
+    // • Initialization
+    //
+    explicit GradientCache(const Parameters& parameters = default_parameters);
+
+    GradientCache(const GradientCache&) = delete;
+    GradientCache& operator = (const GradientCache&) = delete;
+
+    // • Lookup
+    //
+    Texels find(const GradientStop*     stops,
+                uint32_t                count,
+                GradientInterpolation   interpolation,
+                uint32_t                width);
+
+    // • Maintenance
+    //
+    Statistics statistics(void) const;
+
+    void reset_statistics(void);
+    void clear(void);
+
+    // • Properties
+    //
+    const Parameters& parameters(void) const noexcept
+    {
+        return parameters_;
+    }
+
+private:
+
+    // • Bit patterns of the stop values, then interpolation and width
+    //
+    using Key = std::vector<uint32_t>;
+
+    struct KeyHash
+    {
+        size_t operator () (const Key& key) const noexcept;
+    };
+
+    struct Entry
+    {
+        Key         key;
+        Texels      texels;
+    };
+
+    using Entries = std::list<Entry>;
+
+    static size_t entry_size(const Entry& entry) noexcept;
+
+    const Parameters    parameters_;
+
+    // • Most recently used first
+    //
+    mutable std::mutex                                          mutex_;
+    Entries                                                     entries_;
+    std::unordered_map<Key, Entries::iterator, KeyHash>         lookup_;
+    Statistics                                                  statistics_;
+};
+
+} // namespace jzazbz
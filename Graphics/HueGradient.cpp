@@ -0,0 +1,190 @@
+//
+//  HueGradient.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/HueGradient.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/Instrumentation.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Lane-parallel max-chroma search
+//===------------------------------------------------------------------------===
+
+simd::float3 find_max_chroma_color(float    hue,
+                                   uint32_t lane_count,
+                                   float    accuracy)
+{
+    INSTRUMENT_TIMER(max_chroma);
+
+    // • Find the Display P3 max chroma edge for the given hue
+    //
+    const auto target_hue     = (hue < 180.0f) ? hue : hue - 360.0f;
+    const auto target_radians = target_hue * static_cast<float>(M_PI) / 180.0f;
+    const auto edges          = jzazbz::find_max_chroma_edge_P3(target_hue);
+    const auto height         = static_cast<float>(lane_count);
+
+    const auto iteration_count = max_chroma_iteration_count(accuracy, lane_count);
+
+    INSTRUMENT_COUNT(max_chroma_solves, 1);
+    INSTRUMENT_COUNT(max_chroma_iterations, iteration_count);
+
+    // • Narrow the bracket to the last lane inside the target hue
+    //
+    auto lower = edges.lower;
+    auto upper = edges.upper;
+
+    for (uint32_t i = 0; i < iteration_count; ++i)
+    {
+        auto max_t = -1.0f;
+
+        for (uint32_t lane = 0; lane < lane_count; ++lane)
+        {
+            const auto lane_t   = static_cast<float>(lane) / height;
+            const auto val      = lower + lane_t*(upper - lower);
+            const auto jab      = jzazbz::from_LMS(val.xyz);
+            const auto test_hue = atan2f(jab[2], jab[1]);
+
+            if (test_hue <= target_radians)
+            {
+                max_t = std::max(max_t, lane_t);
+            }
+        }
+
+        const auto low_t     = std::max(0.0f, max_t);
+        const auto new_lower = lower + low_t*(upper - lower);
+        const auto new_upper = lower + (low_t + 1.0f/height)*(upper - lower);
+
+        lower = new_lower;
+        upper = new_upper;
+    }
+
+    return jzazbz::from_LMS(lower.xyz);
+}
+
+//===------------------------------------------------------------------------===
+// • generate_hue_gradient
+//===------------------------------------------------------------------------===
+
+void generate_hue_gradient(simd::float4*                 texels,
+                           const HueGradientParameters&  parameters)
+{
+    for (uint32_t texel = 0; texel < parameters.width; ++texel)
+    {
+        const auto hue_t     = (static_cast<float>(texel) + 0.5f) / static_cast<float>(parameters.width);
+        const auto hue       = -180.0f + hue_t*360.0f;
+        const auto max_c_jab = find_max_chroma_color(hue, parameters.lane_count, parameters.accuracy);
+        const auto lrgb      = jzazbz::convert_to_linear_display_P3(max_c_jab);
+
+        texels[texel] = simd::float4{ lrgb[0], lrgb[1], lrgb[2], 1.0f };
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Hue gradient mip chain
+//===------------------------------------------------------------------------===
+
+uint32_t hue_gradient_level_count(uint32_t width) noexcept
+{
+    return std::max( static_cast<uint32_t>( std::bit_width(width) ), 1u );
+}
+
+size_t hue_gradient_chain_size(uint32_t width) noexcept
+{
+    auto size = size_t{ 0 };
+
+    for (uint32_t level = 0; level < hue_gradient_level_count(width); ++level)
+    {
+        size += hue_gradient_level_width(width, level);
+    }
+
+    return size;
+}
+
+void downsample_hue_gradient(const simd::float4* source,
+                             uint32_t            source_width,
+                             simd::float4*       target,
+                             uint32_t            target_width)
+{
+    auto jab = std::vector<simd::float3>(source_width);
+
+    for (uint32_t i = 0; i < source_width; ++i)
+    {
+        jab[i] = jzazbz::convert_from_linear_display_P3(source[i].xyz);
+    }
+
+    // • Tent of radius `ratio` source texels about each target texel center
+    //
+    const auto ratio = static_cast<float>(source_width) / static_cast<float>(target_width);
+    const auto width = static_cast<int32_t>(source_width);
+
+    for (uint32_t it = 0; it < target_width; ++it)
+    {
+        const auto center = (static_cast<float>(it) + 0.5f) * ratio;
+        const auto first  = static_cast<int32_t>( floorf(center - ratio) );
+        const auto last   = static_cast<int32_t>( ceilf(center + ratio) );
+
+        auto sum    = simd::float3(0.0f);
+        auto weight = 0.0f;
+
+        for (auto is = first; is <= last; ++is)
+        {
+            const auto w = 1.0f - fabsf(static_cast<float>(is) + 0.5f - center) / ratio;
+
+            if (0.0f < w)
+            {
+                sum    += w * jab[ ( (is % width) + width ) % width ];
+                weight += w;
+            }
+        }
+
+        const auto lrgb = simd::clamp( jzazbz::convert_to_linear_display_P3(sum / weight),
+                                       simd::float3(0.0f), simd::float3(1.0f) );
+
+        target[it] = simd::float4{ lrgb[0], lrgb[1], lrgb[2], 1.0f };
+    }
+}
+
+void generate_hue_gradient_mip_chain(simd::float4*                 texels,
+                                     const HueGradientParameters&  parameters)
+{
+    generate_hue_gradient(texels, parameters);
+
+    for (uint32_t level = 1; level < hue_gradient_level_count(parameters.width); ++level)
+    {
+        const auto source_width = hue_gradient_level_width(parameters.width, level - 1);
+        const auto target       = texels + source_width;
+
+        downsample_hue_gradient( texels, source_width, target, hue_gradient_level_width(parameters.width, level) );
+
+        texels = target;
+    }
+}
+
+} // namespace jzazbz
@@ -0,0 +1,108 @@
+//
+//  HueGradient.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Jzazbz.hpp>
+#include <simd/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+//
+// • Hue gradient table (Host)
+//
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Hue gradient parameters
+//
+//  `width` texels, one hue each, solved with `lane_count` lanes subdividing
+//  the max-chroma edge bracket until it is within `accuracy` (Jzazbz units)
+//===------------------------------------------------------------------------===
+
+struct HueGradientParameters
+{
+    uint32_t    width;
+    uint32_t    lane_count;
+    float       accuracy;
+};
+
+constexpr HueGradientParameters default_hue_gradient_parameters = {
+    .width           = 1024,
+    .lane_count      = 32,
+    .accuracy        = default_search_accuracy
+};
+
+//===------------------------------------------------------------------------===
+// • Lane-parallel max-chroma search
+//
+//  The lane scheme of the shaders' slice search: each iteration narrows the
+//  edge bracket to the last of `lane_count` subdivisions inside the hue,
+//  max_chroma_iteration_count(accuracy, lane_count) times
+//===------------------------------------------------------------------------===
+
+simd::float3 find_max_chroma_color(float    hue,
+                                   uint32_t lane_count,
+                                   float    accuracy);
+
+//===------------------------------------------------------------------------===
+// • generate_hue_gradient
+//
+//  Writes the linear Display P3 max-chroma color (alpha 1) at each texel
+//  center, hue spanning [-180, 180)
+//===------------------------------------------------------------------------===
+
+void generate_hue_gradient(simd::float4*                 texels,
+                           const HueGradientParameters&  parameters = default_hue_gradient_parameters);
+
+//===------------------------------------------------------------------------===
+// • Hue gradient mip chain
+//
+//  Levels as Metal allocates them: level l is max(1, width >> l) texels, down
+//  to one. Each coarser level is filtered from the one above in Jzazbz, with
+//  a tent two target texels wide wrapping around the hue circle ([1 3 3 1]/8
+//  at 2:1), so that it keeps the gradient's lightness and hue where averaging
+//  linear RGB would darken and shift them. Levels are stored consecutively
+//===------------------------------------------------------------------------===
+
+uint32_t hue_gradient_level_count(uint32_t width) noexcept;
+
+inline uint32_t hue_gradient_level_width(uint32_t width, uint32_t level) noexcept
+{
+    return (width >> level) ? (width >> level) : 1;
+}
+
+// • Texels of the whole chain
+//
+size_t hue_gradient_chain_size(uint32_t width) noexcept;
+
+void downsample_hue_gradient(const simd::float4* source,
+                             uint32_t            source_width,
+                             simd::float4*       target,
+                             uint32_t            target_width);
+
+void generate_hue_gradient_mip_chain(simd::float4*                 texels,
+                                     const HueGradientParameters&  parameters = default_hue_gradient_parameters);
+
+} // namespace jzazbz
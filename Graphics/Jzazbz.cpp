@@ -18,6 +18,7 @@
 //
 
 #include <Graphics/Jzazbz.hpp>
+#include <Utilities/Instrumentation.hpp>
 
 //===------------------------------------------------------------------------===
 // • namespace jzazbz
@@ -30,8 +31,10 @@ namespace jzazbz
 // • find_max_chroma_color
 //===------------------------------------------------------------------------===
 
-simd::float3 find_max_chroma_color(float hue)
+simd::float3 find_max_chroma_color(float hue, float accuracy)
 {
+    INSTRUMENT_TIMER(max_chroma);
+
     // • Find the Display P3 max chroma edge for the given hue
     //
     const auto target_hue     = (hue < 180.0f) ? hue : hue - 360.0f;
@@ -43,7 +46,12 @@ simd::float3 find_max_chroma_color(float hue)
     auto lower = edges.lower;
     auto upper = edges.upper;
 
-    for (auto i = 0; i < 20; i++)
+    const auto iteration_count = max_chroma_iteration_count(accuracy, 2);
+
+    INSTRUMENT_COUNT(max_chroma_solves, 1);
+    INSTRUMENT_COUNT(max_chroma_iterations, iteration_count);
+
+    for (uint32_t i = 0; i < iteration_count; i++)
     {
         const auto val      = lower + 0.5f*(upper - lower);
         const auto jab      = jzazbz::from_LMS(val.xyz);
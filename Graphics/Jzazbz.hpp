@@ -35,39 +35,106 @@ namespace jzazbz
 {
 
 //===------------------------------------------------------------------------===
-// • Jzazbz to LMS
+// • Model constants
+//
+//  The single definition of the constants of the conversions below, for the
+//  kernels here and the host code that transposes or instruments them
+//  (Gradient, JzazbzBatch, RoundTripFuzzer). GoldenReference keeps its own
+//  extended-precision copy on purpose.
 //===------------------------------------------------------------------------===
 
-inline simd::float3 convert_to_LMS(simd::float3 jab)
+// • d and d0 of Jz = (1 + d) Iz / (1 + d Iz) - d0
+//
+constexpr float model_d(void)
+{
+    return -0.56f;
+}
+
+constexpr float model_d0(void)
+{
+    return 1.6295499532821566e-11f;
+}
+
+// • LMS' range of convert_to_LMS; the lower bound is actually
+//   0.000000000037035, adjusted for precision limits
+//
+constexpr float min_LMSp(void)
+{
+    return 0.0000000000370353f;
+}
+
+constexpr float max_LMSp(void)
+{
+    return 3.227f;
+}
+
+inline simd::float3x3 Izazbz_to_LMSp_matrix(void)
 {
-    const auto M_IzazbzToLMSp = simd::float3x3 {
+    return simd::float3x3 {
         simd::float3{ 1.0f,                 1.0f,                 1.0f                },
         simd::float3{ 0.138605043271539f,  -0.138605043271539f,  -0.0960192420263189f },
         simd::float3{ 0.0580473161561189f, -0.0580473161561189f, -0.811891896056039f  }
     };
+}
 
-    constexpr auto d     = -0.56f;
-    constexpr auto d0    =  1.6295499532821566e-11f;
+inline simd::float3x3 LMSp_to_Izazbz_matrix(void)
+{
+    // 0.5       0.5       0
+    // 3.524000 -4.066708  0.542708
+    // 0.199076  1.096799 -1.295875
+    return simd::float3x3{
+        simd::float3{ 0.5f,  3.524000f,  0.199076f },
+        simd::float3{ 0.5f, -4.066708f,  1.096799f },
+        simd::float3{ 0.0f,  0.542708f, -1.295875f }
+    };
+}
 
-    constexpr auto vc1   = simd::float3( 3424.0f/4096.0f );
-    constexpr auto vc2   = simd::float3( 2413.0f/128.0f );
+inline simd::float3x3 LMS_to_linear_display_P3_matrix(void)
+{
+    // M_XYZToLinearP3 = [  2.49350912393461  -0.829473213929555   0.035851264433918  ] T
+    //                   [ -0.931388179404779  1.7626305796003    -0.0761839369220758 ]
+    //                   [ -0.402712756741652  0.0236242371055886  0.957029586694311  ]
+
+    // M_LMSToLinearP3 = M_XYZToLinearP3 * M_XYZpToXYZD65 * M_LMSToXYZD65p
+    return simd::float3x3 {
+        simd::float3{  4.4820606379518333f,  -1.9532025238860451f,  -0.0027453573623004834f },
+        simd::float3{ -3.6184317541411817f,   3.5217700975984596f,  -0.45182653146288487f   },
+        simd::float3{  0.16694496856407345f, -0.54063532522070301f,  1.4822547119502889f    },
+    };
+}
+
+//===------------------------------------------------------------------------===
+// • Jzazbz to LMS
+//
+//  The stages are templates over the value type so that the host can also
+//  run them on four colors transposed into vectors (JzazbzBatch)
+//===------------------------------------------------------------------------===
+
+template <typename Value_>
+inline Value_ Iz_of_Jz(Value_ Jz)
+{
+    const auto Jzp = Jz + model_d0();
+
+    return Jzp / (1.0f + model_d() - model_d()*Jzp);
+}
+
+// • Clamped to [min_LMSp, max_LMSp], then through the inverse PQ curve
+//
+template <typename Vector_>
+inline Vector_ LMSp_to_LMS(Vector_ LMSp)
+{
+    constexpr auto vc1   = Vector_( 3424.0f/4096.0f );
+    constexpr auto vc2   = Vector_( 2413.0f/128.0f );
     constexpr auto vc3   = 2392.0f/128.0f;
     constexpr auto vInvP = 32.0f / (1.7f * 2523.0f);
     constexpr auto vInvN = 16384.0f / 2610.0f;
 
-    // actually 0.000000000037035, adjusted for precision limits
-    constexpr auto minLMSp = simd::float3(0.0000000000370353f);
-    constexpr auto maxLMSp = simd::float3(3.227f);
-
-    const auto Jzp    = jab[0] + d0;
-    const auto Iz     = Jzp / (1.0f + d - d*Jzp);
-    const auto LMSp   = M_IzazbzToLMSp * simd::float3{ Iz, jab[1], jab[2] };
-    const auto LMSpc  = simd::clamp(LMSp, minLMSp, maxLMSp);
+    const auto LMSpc  = simd::clamp( LMSp, Vector_(min_LMSp()), Vector_(max_LMSp()) );
 
 #if !defined ( __METAL_VERSION__ )
-    const auto LMSpp1 = simd::pow( LMSpc, simd::float3(vInvP) );
+    const auto LMSpp1 = simd::pow( LMSpc, Vector_(vInvP) );
     const auto LMSpp2 = (vc1 - LMSpp1) / (vc3*LMSpp1 - vc2);
-    const auto LMS    = 100.0f * simd::pow( LMSpp2, simd::float3(vInvN) );
+    const auto LMS    = 100.0f * simd::pow( LMSpp2, Vector_(vInvN) );
 #else
     const auto LMSpp1 = metal::powr(LMSpc, vInvP);
     const auto LMSpp2 = (vc1 - LMSpp1) / (vc3*LMSpp1 - vc2);
@@ -77,24 +144,25 @@ inline simd::float3 convert_to_LMS(simd::float3 jab)
     return LMS;
 }
 
+// • Unclamped LMS'
+//
+inline simd::float3 LMSp_of_jab(simd::float3 jab)
+{
+    return Izazbz_to_LMSp_matrix() * simd::float3{ Iz_of_Jz(jab[0]), jab[1], jab[2] };
+}
+
+inline simd::float3 convert_to_LMS(simd::float3 jab)
+{
+    return LMSp_to_LMS( LMSp_of_jab(jab) );
+}
+
 //===------------------------------------------------------------------------===
 // • Covnersion to Linear Display P3
 //===------------------------------------------------------------------------===
 
 inline simd::float3 LMS_to_linear_display_P3(simd::float3 lms)
 {
-    // M_XYZToLinearP3 = [  2.49350912393461  -0.829473213929555   0.035851264433918  ] T
-    //                   [ -0.931388179404779  1.7626305796003    -0.0761839369220758 ]
-    //                   [ -0.402712756741652  0.0236242371055886  0.957029586694311  ]
-
-    // M_LMSToLinearP3 = M_XYZToLinearP3 * M_XYZpToXYZD65 * M_LMSToXYZD65p
-    const auto M_LMSToLinearP3 = simd::float3x3 {
-        simd::float3{  4.4820606379518333f,  -1.9532025238860451f,  -0.0027453573623004834f },
-        simd::float3{ -3.6184317541411817f,   3.5217700975984596f,  -0.45182653146288487f   },
-        simd::float3{  0.16694496856407345f, -0.54063532522070301f,  1.4822547119502889f    },
-    };
-
-    return M_LMSToLinearP3 * lms;
+    return LMS_to_linear_display_P3_matrix() * lms;
 }
 
 inline simd::float3 convert_to_linear_display_P3(simd::float3 jab)
@@ -106,26 +174,24 @@ inline simd::float3 convert_to_linear_display_P3(simd::float3 jab)
 // • Jzazbz from LMS
 //===------------------------------------------------------------------------===
 
-inline simd::float3 from_LMS(simd::float3 lms)
+inline simd::float3 jab_of_LMSp(simd::float3 lmsp)
 {
-    // 0.5       0.5       0
-    // 3.524000 -4.066708  0.542708
-    // 0.199076  1.096799 -1.295875
-    const auto M_LMSpToIzazbz = simd::float3x3{
-        simd::float3{ 0.5f,  3.524000f,  0.199076f },
-        simd::float3{ 0.5f, -4.066708f,  1.096799f },
-        simd::float3{ 0.0f,  0.542708f, -1.295875f }
-    };
+    const auto Izazbz = LMSp_to_Izazbz_matrix() * lmsp;
+    const auto Jzn    = (1.0f + model_d()) * Izazbz[0];
+    const auto Jzd    =  1.0f + model_d()*Izazbz[0];
+    const auto Jz     = Jzn / Jzd - model_d0();
+
+    return { Jz, Izazbz[1], Izazbz[2] };
+}
 
+inline simd::float3 from_LMS(simd::float3 lms)
+{
     constexpr auto c1 = simd::float3( 3424.0f / 4096.0f );
     constexpr auto c2 = 2413.0f / 128.0f;
     constexpr auto c3 = 2392.0f / 128.0f;
     constexpr auto n  = 2610.0f / 16384.0f;
     constexpr auto p  = 1.7f * 2523.0f / 32.0f;
 
-    constexpr auto d  = -0.56f;
-    constexpr auto d0 =  1.6295499532821566e-11f;
-
 #if !defined ( __METAL_VERSION__ )
     const auto valp     = simd::pow( simd::max(lms/100.0f, simd::float3(0.0f)), simd::float3(n) );
     const auto fraction = (c1 + c2*valp) / (simd::float3(1.0f) + c3*valp);
@@ -136,12 +202,29 @@ inline simd::float3 from_LMS(simd::float3 lms)
     const auto lmsp     = metal::powr(fraction, p);
 #endif
 
-    const auto Izazbz   = M_LMSpToIzazbz * lmsp;
-    const auto Jzn      = (1.0f + d) * Izazbz[0];
-    const auto Jzd      =  1.0f + d*Izazbz[0];
-    const auto Jz       = Jzn / Jzd - d0;
+    return jab_of_LMSp(lmsp);
+}
 
-    return { Jz, Izazbz[1], Izazbz[2] };
+//===------------------------------------------------------------------------===
+// • Conversion from Linear Display P3
+//===------------------------------------------------------------------------===
+
+inline simd::float3 linear_display_P3_to_LMS(simd::float3 lrgb)
+{
+    // M_LinearP3ToLMS = inverse(M_LMSToLinearP3); the columns are the LMS
+    // values of the primaries
+    const auto M_LinearP3ToLMS = simd::float3x3 {
+        simd::float3{ 0.41569922342211657f,  0.24199222690861918f,  0.07453493016949878f  },
+        simd::float3{ 0.4417746176493501f,   0.5550591123439756f,   0.17001346708806345f  },
+        simd::float3{ 0.11431238432553265f,  0.17519605565166835f,  0.7282635337867523f   },
+    };
+
+    return M_LinearP3ToLMS * lrgb;
+}
+
+inline simd::float3 convert_from_linear_display_P3(simd::float3 lrgb)
+{
+    return from_LMS( linear_display_P3_to_LMS(lrgb) );
 }
 
 //===------------------------------------------------------------------------===
@@ -182,6 +265,57 @@ inline LMSChromaEdge find_max_chroma_edge_P3(float hue)
     };
 }
 
-simd::float3 find_max_chroma_color(float hue);
+//===------------------------------------------------------------------------===
+// • Bracket search iteration count
+//
+//  The lane-parallel bracket searches keep one of `lane_count` subdivisions
+//  per iteration (a binary search keeps one of two), so the iteration count
+//  reaching a target accuracy follows from the initial bracket width and the
+//  lane width. Widths and accuracies are in Jzazbz units.
+//===------------------------------------------------------------------------===
+
+inline uint32_t search_iteration_count(float initial_width, float accuracy, uint32_t lane_count)
+{
+    const auto subdivisions = static_cast<float>( (lane_count < 2) ? 2 : lane_count );
+
+    auto width = initial_width;
+    auto count = uint32_t{ 0 };
+
+    while (accuracy < width && count < 32)
+    {
+        width /= subdivisions;
+        ++count;
+    }
+
+    return count;
+}
+
+// • Slice boundaries: the lower bracket, 0.92 × white Jz at neutral, is the
+//   wider of the two
+//
+inline uint32_t slice_iteration_count(float accuracy, uint32_t lane_count)
+{
+    return search_iteration_count(0.16717463103478347f * 0.92f, accuracy, lane_count);
+}
+
+// • Max chroma: brackets are parameterized along a gamut edge in LMS, where
+//   |d jab / dt| reaches 0.74 (red to yellow). In single precision, from_LMS
+//   limits the result to about 2e-5 whatever the count
+//
+inline uint32_t max_chroma_iteration_count(float accuracy, uint32_t lane_count)
+{
+    return search_iteration_count(0.75f, accuracy, lane_count);
+}
+
+#if !defined ( __METAL_VERSION__ )
+
+// • Matches the former fixed counts: 4 iterations of 32 lanes for slices and
+//   the hue gradient, 20 binary steps for find_max_chroma_color
+//
+constexpr float default_search_accuracy = 1.0e-6f;
+
+simd::float3 find_max_chroma_color(float hue, float accuracy = default_search_accuracy);
+
+#endif
 
 } // namespace jzazbz
@@ -0,0 +1,110 @@
+//
+//  JzazbzBatch.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/JzazbzBatch.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Graphics/Rec2100.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+namespace
+{
+    template <typename Convert_>
+    void convert_pixels(const float* source, float* target, size_t count, Convert_ convert)
+    {
+        for (size_t i = 0; i < count; ++i, source += 3, target += 3)
+        {
+            const auto value = convert( simd::float3{ source[0], source[1], source[2] } );
+
+            target[0] = value[0];
+            target[1] = value[1];
+            target[2] = value[2];
+        }
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Batch conversion
+//===------------------------------------------------------------------------===
+
+void convert_pixels_to_LMS(const float* jab, float* lms, size_t count)
+{
+    convert_pixels(jab, lms, count, convert_to_LMS);
+}
+
+void convert_pixels_from_LMS(const float* lms, float* jab, size_t count)
+{
+    convert_pixels(lms, jab, count, from_LMS);
+}
+
+void convert_pixels_to_linear_display_P3(const float* jab, float* lrgb, size_t count)
+{
+    // • A lambda picks the scalar overload over the four-wide one
+    //
+    convert_pixels( jab, lrgb, count, [](simd::float3 value) {
+        return convert_to_linear_display_P3(value);
+    });
+}
+
+void convert_pixels_from_linear_display_P3(const float* lrgb, float* jab, size_t count)
+{
+    convert_pixels(lrgb, jab, count, convert_from_linear_display_P3);
+}
+
+//===------------------------------------------------------------------------===
+// • Rec. 2100 output, one pass: LMS, BT.2020 primaries and encoding fused
+//===------------------------------------------------------------------------===
+
+void convert_pixels_to_rec2100_pq(const float* jab, float* signal, size_t count, HDRParameters parameters)
+{
+    convert_pixels( jab, signal, count, [=](simd::float3 value) {
+        return convert_to_rec2100_pq(value, parameters);
+    });
+}
+
+void convert_pixels_to_rec2100_hlg(const float* jab, float* signal, size_t count, HDRParameters parameters)
+{
+    convert_pixels( jab, signal, count, [=](simd::float3 value) {
+        return convert_to_rec2100_hlg(value, parameters);
+    });
+}
+
+void convert_pixels_from_linear_display_P3_to_rec2100_pq(const float* lrgb, float* signal, size_t count,
+                                                         HDRParameters parameters)
+{
+    convert_pixels( lrgb, signal, count, [=](simd::float3 value) {
+        return encode_pq( linear_display_P3_to_linear_rec2020(value), parameters );
+    });
+}
+
+void convert_pixels_from_linear_display_P3_to_rec2100_hlg(const float* lrgb, float* signal, size_t count,
+                                                          HDRParameters parameters)
+{
+    convert_pixels( lrgb, signal, count, [=](simd::float3 value) {
+        return encode_hlg( linear_display_P3_to_linear_rec2020(value), parameters );
+    });
+}
+
+} // namespace jzazbz
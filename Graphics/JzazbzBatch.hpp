@@ -0,0 +1,98 @@
+//
+//  JzazbzBatch.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Jzazbz.hpp>
+#include <Graphics/Rec2100.hpp>
+
+#include <cstddef>
+
+//===------------------------------------------------------------------------===
+//
+// • Batch Jzazbz Conversion (Host only)
+//
+//  Array kernels over interleaved float triplets (12 bytes per pixel, the
+//  layout of PFM and raw float scans). Source and target may be the same
+//  buffer.
+//
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+void convert_pixels_to_LMS(const float* jab, float* lms, size_t count);
+
+void convert_pixels_from_LMS(const float* lms, float* jab, size_t count);
+
+void convert_pixels_to_linear_display_P3(const float* jab, float* lrgb, size_t count);
+
+void convert_pixels_from_linear_display_P3(const float* lrgb, float* jab, size_t count);
+
+// • Rec. 2100 PQ or HLG signal (BT.2020 primaries) in a single pass, from
+//   Jzazbz or from linear Display P3 (e.g. HostRenderer output)
+//
+void convert_pixels_to_rec2100_pq(const float* jab, float* signal, size_t count,
+                                  HDRParameters parameters = default_hdr_parameters);
+
+void convert_pixels_to_rec2100_hlg(const float* jab, float* signal, size_t count,
+                                   HDRParameters parameters = default_hdr_parameters);
+
+void convert_pixels_from_linear_display_P3_to_rec2100_pq(const float* lrgb, float* signal, size_t count,
+                                                         HDRParameters parameters = default_hdr_parameters);
+
+void convert_pixels_from_linear_display_P3_to_rec2100_hlg(const float* lrgb, float* signal, size_t count,
+                                                          HDRParameters parameters = default_hdr_parameters);
+
+//===------------------------------------------------------------------------===
+// • Four-wide conversion
+//
+//  convert_to_LMS and LMS_to_linear_display_P3 transposed to four colors per
+//  component vector, so that every operation fills a 128-bit lane
+//===------------------------------------------------------------------------===
+
+struct Colors4
+{
+    simd::float4    x;
+    simd::float4    y;
+    simd::float4    z;
+};
+
+inline Colors4 multiply(const simd::float3x3& m, const Colors4& v)
+{
+    return {
+        .x = m.columns[0][0] * v.x + m.columns[1][0] * v.y + m.columns[2][0] * v.z,
+        .y = m.columns[0][1] * v.x + m.columns[1][1] * v.y + m.columns[2][1] * v.z,
+        .z = m.columns[0][2] * v.x + m.columns[1][2] * v.y + m.columns[2][2] * v.z
+    };
+}
+
+inline Colors4 convert_to_linear_display_P3(const Colors4& jab)
+{
+    const auto LMSp = multiply( Izazbz_to_LMSp_matrix(), { .x = Iz_of_Jz(jab.x), .y = jab.y, .z = jab.z } );
+    const auto LMS  = Colors4{
+        .x = LMSp_to_LMS(LMSp.x),
+        .y = LMSp_to_LMS(LMSp.y),
+        .z = LMSp_to_LMS(LMSp.z)
+    };
+
+    return multiply( LMS_to_linear_display_P3_matrix(), LMS );
+}
+
+} // namespace jzazbz
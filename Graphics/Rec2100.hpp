@@ -0,0 +1,168 @@
+//
+//  Rec2100.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#if defined ( __METAL_VERSION__ )
+#include <metal_stdlib>
+#else
+#include <cmath>
+#endif
+
+#include <Graphics/Jzazbz.hpp>
+
+//===------------------------------------------------------------------------===
+//
+// • Rec. 2100 Output Encoding
+//
+//  Jzazbz is absolute: linear RGB 1.0 from convert_to_LMS is 100 cd/m². The
+//  encoders take linear BT.2020 in those units, scale by reference_white /
+//  100 and either clip to peak_luminance and apply the PQ inverse EOTF, or
+//  normalize to peak_luminance (the nominal HLG display peak, L_W), undo the
+//  HLG OOTF and apply the OETF. Signals are in [0, 1].
+//
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+struct HDRParameters
+{
+    float   reference_white;    // cd/m² of linear 1.0; 100 keeps Jzazbz absolute
+    float   peak_luminance;     // cd/m²
+};
+
+constexpr HDRParameters default_hdr_parameters = {
+    .reference_white = 100.0f,
+    .peak_luminance  = 1000.0f
+};
+
+//===------------------------------------------------------------------------===
+// • LMS to linear BT.2020
+//===------------------------------------------------------------------------===
+
+inline simd::float3 LMS_to_linear_rec2020(simd::float3 lms)
+{
+    // M_LMSToLinear2020 = M_LinearP3ToLinear2020 * M_LMSToLinearP3
+    const auto M_LMSToLinear2020 = simd::float3x3 {
+        simd::float3{  2.9906938928875584f,  -1.6344891969242428f,  -0.042504894693650666f },
+        simd::float3{ -2.0497723188922135f,   3.1455635434685147f,  -0.3780517368417473f   },
+        simd::float3{  0.08899013770301224f, -0.48302437348550453f,  1.4482403458459254f   },
+    };
+
+    return M_LMSToLinear2020 * lms;
+}
+
+inline simd::float3 linear_display_P3_to_linear_rec2020(simd::float3 lrgb)
+{
+    const auto M_LinearP3ToLinear2020 = simd::float3x3 {
+        simd::float3{ 0.7538330343617218f,   0.04574384896535833f,  -0.0012103403545183245f },
+        simd::float3{ 0.1985973690526163f,   0.9417772198116936f,    0.017601717301089895f  },
+        simd::float3{ 0.04756959658566188f,  0.012478931222948122f,  0.9836086230534284f    },
+    };
+
+    return M_LinearP3ToLinear2020 * lrgb;
+}
+
+//===------------------------------------------------------------------------===
+// • PQ (SMPTE ST 2084 inverse EOTF)
+//===------------------------------------------------------------------------===
+
+inline simd::float3 encode_pq(simd::float3 lrgb, HDRParameters parameters)
+{
+    constexpr auto m1 = 2610.0f / 16384.0f;
+    constexpr auto m2 = 2523.0f / 4096.0f * 128.0f;
+    constexpr auto c1 = simd::float3( 3424.0f / 4096.0f );
+    constexpr auto c2 = 2413.0f / 4096.0f * 32.0f;
+    constexpr auto c3 = 2392.0f / 4096.0f * 32.0f;
+
+    const auto luminance = simd::clamp( lrgb * parameters.reference_white,
+                                        simd::float3(0.0f), simd::float3(parameters.peak_luminance) );
+    const auto y         = luminance / 10000.0f;
+
+#if !defined ( __METAL_VERSION__ )
+    const auto ym = simd::pow( y, simd::float3(m1) );
+
+    return simd::pow( (c1 + c2*ym) / (simd::float3(1.0f) + c3*ym), simd::float3(m2) );
+#else
+    const auto ym = metal::powr(y, m1);
+
+    return metal::powr( (c1 + c2*ym) / (1.0f + c3*ym), m2 );
+#endif
+}
+
+//===------------------------------------------------------------------------===
+// • HLG (BT.2100 inverse OOTF and OETF)
+//===------------------------------------------------------------------------===
+
+inline float hlg_oetf(float e)
+{
+    constexpr auto a = 0.17883277f;
+    constexpr auto b = 0.28466892f;
+    constexpr auto c = 0.55991073f;
+
+#if !defined ( __METAL_VERSION__ )
+    return (e <= 1.0f/12.0f) ? sqrtf(3.0f * e) : a * logf(12.0f*e - b) + c;
+#else
+    return (e <= 1.0f/12.0f) ? metal::sqrt(3.0f * e) : a * metal::log(12.0f*e - b) + c;
+#endif
+}
+
+inline simd::float3 encode_hlg(simd::float3 lrgb, HDRParameters parameters)
+{
+    // • System gamma for the nominal peak (BT.2100 note 5f, extended range)
+    //
+#if !defined ( __METAL_VERSION__ )
+    const auto gamma = 1.2f + 0.42f * log10f(parameters.peak_luminance / 1000.0f);
+#else
+    const auto gamma = 1.2f + 0.42f * metal::log10(parameters.peak_luminance / 1000.0f);
+#endif
+
+    // • Display light normalized to the peak, back to scene light
+    //
+    const auto display   = simd::clamp( lrgb * (parameters.reference_white / parameters.peak_luminance),
+                                        simd::float3(0.0f), simd::float3(1.0f) );
+    const auto luminance = simd::dot( display, simd::float3{ 0.2627f, 0.6780f, 0.0593f } );
+
+#if !defined ( __METAL_VERSION__ )
+    const auto scale = (0.0f < luminance) ? powf(luminance, (1.0f - gamma) / gamma) : 0.0f;
+#else
+    const auto scale = (0.0f < luminance) ? metal::powr(luminance, (1.0f - gamma) / gamma) : 0.0f;
+#endif
+
+    const auto scene = display * scale;
+
+    return simd::float3{ hlg_oetf(scene[0]), hlg_oetf(scene[1]), hlg_oetf(scene[2]) };
+}
+
+//===------------------------------------------------------------------------===
+// • Jzazbz to Rec. 2100
+//===------------------------------------------------------------------------===
+
+inline simd::float3 convert_to_rec2100_pq(simd::float3 jab, HDRParameters parameters)
+{
+    return encode_pq( LMS_to_linear_rec2020( convert_to_LMS(jab) ), parameters );
+}
+
+inline simd::float3 convert_to_rec2100_hlg(simd::float3 jab, HDRParameters parameters)
+{
+    return encode_hlg( LMS_to_linear_rec2020( convert_to_LMS(jab) ), parameters );
+}
+
+} // namespace jzazbz
@@ -0,0 +1,305 @@
+//
+//  RegionSet.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/RegionSet.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • namespace geometry
+//===------------------------------------------------------------------------===
+
+namespace geometry
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    struct Span
+    {
+        uint32_t    left;
+        uint32_t    right;
+    };
+
+    // • The spans of the band of `rectangles` covering row `y`, starting the
+    //   search at `index` (advanced past earlier bands)
+    //
+    void band_spans(const std::vector<Region>& rectangles, size_t& index, uint32_t y, std::vector<Span>& spans)
+    {
+        spans.clear();
+
+        while ( index < rectangles.size() && rectangles[index].bottom <= y )
+        {
+            ++index;
+        }
+
+        if ( rectangles.size() <= index || y < rectangles[index].top )
+        {
+            return;
+        }
+
+        const auto top = rectangles[index].top;
+
+        for (auto ir = index; ir < rectangles.size() && top == rectangles[ir].top; ++ir)
+        {
+            spans.push_back({ rectangles[ir].left, rectangles[ir].right });
+        }
+    }
+
+    // • Walk the x breakpoints of both span lists, keeping the intervals for
+    //   which `keep(in_lhs, in_rhs)` holds and merging touching ones
+    //
+    template <class Keep_>
+    void combine_spans(const std::vector<Span>& lhs, const std::vector<Span>& rhs, Keep_ keep,
+                       std::vector<Span>& result)
+    {
+        result.clear();
+
+        size_t il = 0;
+        size_t ir = 0;
+        auto   x  = uint32_t{ 0 };
+
+        while ( il < lhs.size() || ir < rhs.size() )
+        {
+            // • Skip spans ending at or before x
+            //
+            while ( il < lhs.size() && lhs[il].right <= x ) ++il;
+            while ( ir < rhs.size() && rhs[ir].right <= x ) ++ir;
+
+            if ( lhs.size() <= il && rhs.size() <= ir )
+            {
+                break;
+            }
+
+            const auto in_lhs = il < lhs.size() && lhs[il].left <= x;
+            const auto in_rhs = ir < rhs.size() && rhs[ir].left <= x;
+
+            // • Next breakpoint
+            //
+            auto next = UINT32_MAX;
+
+            if ( il < lhs.size() ) next = std::min( next, in_lhs ? lhs[il].right : lhs[il].left );
+            if ( ir < rhs.size() ) next = std::min( next, in_rhs ? rhs[ir].right : rhs[ir].left );
+
+            if ( keep(in_lhs, in_rhs) && x < next )
+            {
+                if ( !result.empty() && result.back().right == x )
+                {
+                    result.back().right = next;
+                }
+                else
+                {
+                    result.push_back({ x, next });
+                }
+            }
+
+            x = next;
+        }
+    }
+
+    bool same_spans(const std::vector<Region>& rectangles, size_t band, const std::vector<Span>& spans)
+    {
+        if ( rectangles.size() - band != spans.size() )
+        {
+            return false;
+        }
+
+        for (size_t is = 0; is < spans.size(); ++is)
+        {
+            if ( rectangles[band + is].left != spans[is].left || rectangles[band + is].right != spans[is].right )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Set operations
+//===------------------------------------------------------------------------===
+
+RegionSet RegionSet::combine(const RegionSet& lhs, const RegionSet& rhs, Operation operation)
+{
+    // • Band boundaries of both operands
+    //
+    auto ys = std::vector<uint32_t>{};
+
+    ys.reserve( 2 * (lhs.rectangles_.size() + rhs.rectangles_.size()) );
+
+    for (const auto set : { &lhs, &rhs })
+    {
+        for (const auto& rect : set->rectangles_)
+        {
+            ys.push_back(rect.top);
+            ys.push_back(rect.bottom);
+        }
+    }
+
+    std::sort(ys.begin(), ys.end());
+    ys.erase( std::unique(ys.begin(), ys.end()), ys.end() );
+
+    const auto keep = [operation](bool in_lhs, bool in_rhs) {
+
+        switch (operation)
+        {
+            case Operation::set_union:        return in_lhs || in_rhs;
+            case Operation::set_intersection: return in_lhs && in_rhs;
+            case Operation::set_difference:   return in_lhs && !in_rhs;
+        }
+
+        return false;
+    };
+
+    auto result     = RegionSet{};
+    auto lhs_spans  = std::vector<Span>{};
+    auto rhs_spans  = std::vector<Span>{};
+    auto spans      = std::vector<Span>{};
+    auto lhs_index  = size_t{ 0 };
+    auto rhs_index  = size_t{ 0 };
+    auto last_band  = size_t{ 0 };
+
+    auto& rectangles = result.rectangles_;
+
+    for (size_t iy = 0; iy + 1 < ys.size(); ++iy)
+    {
+        const auto top    = ys[iy];
+        const auto bottom = ys[iy + 1];
+
+        band_spans(lhs.rectangles_, lhs_index, top, lhs_spans);
+        band_spans(rhs.rectangles_, rhs_index, top, rhs_spans);
+        combine_spans(lhs_spans, rhs_spans, keep, spans);
+
+        if ( spans.empty() )
+        {
+            continue;
+        }
+
+        // • Extend the previous band when it is adjacent and identical
+        //
+        if ( !rectangles.empty() && rectangles.back().bottom == top && same_spans(rectangles, last_band, spans) )
+        {
+            for (auto ir = last_band; ir < rectangles.size(); ++ir)
+            {
+                rectangles[ir].bottom = bottom;
+            }
+
+            continue;
+        }
+
+        last_band = rectangles.size();
+
+        for (const auto span : spans)
+        {
+            rectangles.push_back({ .left = span.left, .top = top, .right = span.right, .bottom = bottom });
+        }
+    }
+
+    return result;
+}
+
+RegionSet operator | (const RegionSet& lhs, const RegionSet& rhs)
+{
+    return RegionSet::combine(lhs, rhs, RegionSet::Operation::set_union);
+}
+
+RegionSet operator & (const RegionSet& lhs, const RegionSet& rhs)
+{
+    return RegionSet::combine(lhs, rhs, RegionSet::Operation::set_intersection);
+}
+
+RegionSet operator - (const RegionSet& lhs, const RegionSet& rhs)
+{
+    return RegionSet::combine(lhs, rhs, RegionSet::Operation::set_difference);
+}
+
+//===------------------------------------------------------------------------===
+// • Properties
+//===------------------------------------------------------------------------===
+
+Region RegionSet::bounds(void) const noexcept
+{
+    if ( rectangles_.empty() )
+    {
+        return { .left = 0, .top = 0, .right = 0, .bottom = 0 };
+    }
+
+    auto result = Region{
+        .left   = UINT32_MAX,
+        .top    = rectangles_.front().top,
+        .right  = 0,
+        .bottom = rectangles_.back().bottom
+    };
+
+    for (const auto& rect : rectangles_)
+    {
+        result.left  = std::min(result.left,  rect.left);
+        result.right = std::max(result.right, rect.right);
+    }
+
+    return result;
+}
+
+uint64_t RegionSet::area(void) const noexcept
+{
+    auto result = uint64_t{ 0 };
+
+    for (const auto& rect : rectangles_)
+    {
+        result += static_cast<uint64_t>( width(rect) ) * height(rect);
+    }
+
+    return result;
+}
+
+bool RegionSet::contains(simd::uint2 point) const noexcept
+{
+    return std::any_of( rectangles_.begin(), rectangles_.end(), [point](const Region& rect) {
+        return geometry::contains(rect, point);
+    });
+}
+
+bool RegionSet::intersects(const Region rgn) const noexcept
+{
+    return std::any_of( rectangles_.begin(), rectangles_.end(), [rgn](const Region& rect) {
+        return geometry::intersects(rect, rgn);
+    });
+}
+
+//===------------------------------------------------------------------------===
+// • Conversion
+//===------------------------------------------------------------------------===
+
+Region make_covering_region(const Rectangle rect, simd::uint2 size)
+{
+    return intersection( Region{
+        .left   = static_cast<uint32_t>( std::max(floorf(rect.left),   0.0f) ),
+        .top    = static_cast<uint32_t>( std::max(floorf(rect.top),    0.0f) ),
+        .right  = static_cast<uint32_t>( std::max(ceilf(rect.right),   0.0f) ),
+        .bottom = static_cast<uint32_t>( std::max(ceilf(rect.bottom),  0.0f) )
+    }, make_region_of_size(size) );
+}
+
+} // namespace geometry
@@ -0,0 +1,120 @@
+//
+//  RegionSet.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Geometry.hpp>
+
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace geometry
+//===------------------------------------------------------------------------===
+
+namespace geometry
+{
+
+//===------------------------------------------------------------------------===
+//
+// • RegionSet (Host only)
+//
+//  Arbitrary pixel areas as y-x banded rectangle lists: rectangles are sorted
+//  by band, then left to right; the rectangles of a band share top and
+//  bottom and neither overlap nor touch; vertically adjacent bands with the
+//  same spans are merged. Every set has exactly one representation, so sets
+//  compare by their rectangles.
+//
+//===------------------------------------------------------------------------===
+
+class RegionSet
+{
+public:
+
+    RegionSet() = default;
+
+    RegionSet(const Region rgn)
+    {
+        if ( !geometry::is_empty(rgn) )
+        {
+            rectangles_.push_back(rgn);
+        }
+    }
+
+    //===--------------------------------------------------------------------===
+    // • Set operations
+    //===--------------------------------------------------------------------===
+
+    friend RegionSet operator | (const RegionSet& lhs, const RegionSet& rhs);   // union
+    friend RegionSet operator & (const RegionSet& lhs, const RegionSet& rhs);   // intersection
+    friend RegionSet operator - (const RegionSet& lhs, const RegionSet& rhs);   // subtraction
+
+    RegionSet& operator |= (const RegionSet& rhs) { return *this = *this | rhs; }
+    RegionSet& operator &= (const RegionSet& rhs) { return *this = *this & rhs; }
+    RegionSet& operator -= (const RegionSet& rhs) { return *this = *this - rhs; }
+
+    friend bool operator == (const RegionSet& lhs, const RegionSet& rhs) = default;
+
+    void clear(void) noexcept
+    {
+        rectangles_.clear();
+    }
+
+    //===--------------------------------------------------------------------===
+    // • Properties
+    //===--------------------------------------------------------------------===
+
+    bool is_empty(void) const noexcept
+    {
+        return rectangles_.empty();
+    }
+
+    const std::vector<Region>& rectangles(void) const noexcept
+    {
+        return rectangles_;
+    }
+
+    Region bounds(void) const noexcept;
+    uint64_t area(void) const noexcept;
+
+    bool contains(simd::uint2 point) const noexcept;
+    bool intersects(const Region rgn) const noexcept;
+
+private:
+
+    enum class Operation
+    {
+        set_union,
+        set_intersection,
+        set_difference
+    };
+
+    static RegionSet combine(const RegionSet& lhs, const RegionSet& rhs, Operation operation);
+
+    std::vector<Region> rectangles_;
+};
+
+//===------------------------------------------------------------------------===
+// • Conversion
+//===------------------------------------------------------------------------===
+
+// • Pixels touched by `rect`, within an image of `size`
+//
+Region make_covering_region(const Rectangle rect, simd::uint2 size);
+
+} // namespace geometry
@@ -0,0 +1,235 @@
+//
+//  SliceCache.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/SliceCache.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/Instrumentation.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    float reduce_hue(float hue)
+    {
+        const auto reduced = fmodf(hue, 360.0f);
+
+        return (reduced < 0.0f) ? reduced + 360.0f : reduced;
+    }
+
+    float target_hue(float hue)
+    {
+        const auto reduced = reduce_hue(hue);
+
+        return (reduced < 180.0f) ? reduced : reduced - 360.0f;
+    }
+
+    float edge_key(float hue)
+    {
+        // • Display P3 gamut edge along which `hue` lies (hue of its lower corner)
+        //
+        return find_max_chroma_edge_P3( target_hue(hue) ).lower.w;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+SliceCache::SliceCache(const SliceParameters& slice, const Parameters& parameters)
+    : slice_     ( slice )
+    , parameters_( parameters )
+    , statistics_( {} )
+{
+}
+
+//===------------------------------------------------------------------------===
+// • Lookup
+//===------------------------------------------------------------------------===
+
+void SliceCache::find_slice_vertices(float hue, simd::float3 max_c_color, simd::float4* vertices)
+{
+    const auto count   = quantized_count();
+    const auto x       = reduce_hue(hue) / parameters_.step;
+    const auto i0      = static_cast<uint32_t>( floorf(x) ) % count;
+    const auto i1      = (i0 + 1) % count;
+    const auto t       = x - floorf(x);
+    const auto nearest = (t < 0.5f) ? i0 : i1;
+
+    const auto lower_hue = static_cast<float>(i0) * parameters_.step;
+
+    // • On a quantized hue: the caller's solve is the entry
+    //
+    if (0.0f == t)
+    {
+        const auto found = find(i0, &max_c_color);
+
+        std::copy(found->begin(), found->end(), vertices);
+        return;
+    }
+
+    // • Across a corner: neither end of the bracket describes this hue
+    //
+    if ( edge_key(lower_hue) != edge_key(lower_hue + parameters_.step) )
+    {
+        {
+            const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+            ++statistics_.corner_count;
+        }
+
+        generate_slice_vertices(max_c_color, vertices, slice_);
+        return;
+    }
+
+    if (!parameters_.interpolate)
+    {
+        const auto found = find(nearest);
+
+        std::copy(found->begin(), found->end(), vertices);
+        return;
+    }
+
+    const auto lower = find(i0);
+    const auto upper = find(i1);
+
+    for (size_t i = 0; i < lower->size(); ++i)
+    {
+        vertices[i] = (*lower)[i] + t*( (*upper)[i] - (*lower)[i] );
+    }
+}
+
+SliceCache::Vertices SliceCache::find(uint32_t index, const simd::float3* max_c_color)
+{
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+        if ( const auto found = lookup_.find(index); lookup_.end() != found )
+        {
+            entries_.splice(entries_.begin(), entries_, found->second);
+
+            ++statistics_.hit_count;
+
+            INSTRUMENT_COUNT(slice_cache_hits, 1);
+
+            return found->second->vertices;
+        }
+
+        ++statistics_.miss_count;
+
+        INSTRUMENT_COUNT(slice_cache_misses, 1);
+    }
+
+    // • Solve outside the lock
+    //
+    const auto solved_color = (nullptr != max_c_color)
+                            ? *max_c_color
+                            : find_max_chroma_color( target_hue(static_cast<float>(index) * parameters_.step) );
+
+    auto solved = std::make_shared<std::vector<simd::float4>>( slice_vertex_count(slice_) );
+
+    generate_slice_vertices(solved_color, solved->data(), slice_);
+
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    // • Another thread may have solved the same hue meanwhile
+    //
+    if ( const auto found = lookup_.find(index); lookup_.end() != found )
+    {
+        return found->second->vertices;
+    }
+
+    entries_.push_front( Entry{ .index = index, .vertices = solved } );
+    lookup_.emplace(index, entries_.begin());
+
+    statistics_.size += entry_size();
+
+    // • Evict down to the budget (the caller keeps its own reference)
+    //
+    while ( parameters_.memory_budget < statistics_.size && !entries_.empty() )
+    {
+        lookup_.erase(entries_.back().index);
+        entries_.pop_back();
+
+        statistics_.size -= entry_size();
+        ++statistics_.eviction_count;
+    }
+
+    statistics_.entry_count = static_cast<uint32_t>( entries_.size() );
+
+    return solved;
+}
+
+//===------------------------------------------------------------------------===
+// • Maintenance
+//===------------------------------------------------------------------------===
+
+SliceCache::Statistics SliceCache::statistics(void) const
+{
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    return statistics_;
+}
+
+void SliceCache::reset_statistics(void)
+{
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    statistics_.hit_count      = 0;
+    statistics_.miss_count     = 0;
+    statistics_.corner_count   = 0;
+    statistics_.eviction_count = 0;
+}
+
+void SliceCache::clear(void)
+{
+    const auto lock = std::lock_guard<std::mutex>(mutex_);
+
+    entries_.clear();
+    lookup_.clear();
+
+    statistics_.entry_count = 0;
+    statistics_.size        = 0;
+}
+
+uint32_t SliceCache::quantized_count(void) const noexcept
+{
+    return std::max( static_cast<uint32_t>( lroundf(360.0f / parameters_.step) ), 1u );
+}
+
+size_t SliceCache::entry_size(void) const noexcept
+{
+    // • Vertices plus list, map and allocation overhead
+    //
+    return slice_vertex_count(slice_) * sizeof(simd::float4) + sizeof(Entry) + 64;
+}
+
+} // namespace jzazbz
@@ -0,0 +1,147 @@
+//
+//  SliceCache.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/GamutSlice.hpp>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+//
+// • SliceCache (Host only)
+//
+//  Uniform slice vertex sets (generate_slice_vertices) at quantized hues,
+//  `step` degrees apart, kept in least-recently-used order within a memory
+//  budget. A lookup either snaps to the nearest quantized hue or, when
+//  `interpolate` is set, blends the vertex sets of the two quantized hues
+//  bracketing it.
+//
+//  The caller passes the max chroma color it solved for the hue, so that the
+//  slice matches the rest of the frame: a hue that falls on a quantized step
+//  is cached from that color rather than solved again, and a hue whose
+//  bracket straddles a corner of the Display P3 gamut (the cusp turns there,
+//  so neither blending nor snapping holds) is generated from it directly.
+//
+//  Lookups may come from several threads: misses are solved outside the
+//  lock, and vertex sets stay alive while in use even if evicted.
+//
+//===------------------------------------------------------------------------===
+
+class SliceCache
+{
+public:
+
+    struct Parameters
+    {
+        float       step;           // quantization step in degrees
+        size_t      memory_budget;  // bytes
+        bool        interpolate;
+    };
+
+    static constexpr Parameters default_parameters = {
+        .step          = 0.25f,
+        .memory_budget = 4 << 20,
+        .interpolate   = true
+    };
+
+    struct Statistics
+    {
+        uint64_t    hit_count;      // quantized hues found
+        uint64_t    miss_count;     // quantized hues solved
+        uint64_t    corner_count;   // lookups generated directly at a corner
+        uint64_t    eviction_count;
+        uint32_t    entry_count;
+        size_t      size;           // bytes held
+    };
+
+    // • Initialization
+    //
+    explicit SliceCache(const SliceParameters& slice      = default_slice_parameters,
+                        const Parameters&      parameters = default_parameters);
+
+    SliceCache(const SliceCache&) = delete;
+    SliceCache& operator = (const SliceCache&) = delete;
+
+    // • Write the slice_vertex_count(slice()) vertices for `hue` (degrees),
+    //   whose max chroma color is `max_c_color`
+    //
+    void find_slice_vertices(float hue, simd::float3 max_c_color, simd::float4* vertices);
+
+    // • Maintenance
+    //
+    Statistics statistics(void) const;
+
+    void reset_statistics(void);
+    void clear(void);
+
+    // • Properties
+    //
+    const SliceParameters& slice(void) const noexcept
+    {
+        return slice_;
+    }
+
+    const Parameters& parameters(void) const noexcept
+    {
+        return parameters_;
+    }
+
+private:
+
+    using Vertices = std::shared_ptr<const std::vector<simd::float4>>;
+
+    struct Entry
+    {
+        uint32_t    index;
+        Vertices    vertices;
+    };
+
+    using Entries = std::list<Entry>;
+
+    // • `max_c_color`, when given, is the solve at the quantized hue
+    //
+    Vertices find(uint32_t index, const simd::float3* max_c_color = nullptr);
+
+    uint32_t quantized_count(void) const noexcept;
+    size_t   entry_size(void) const noexcept;
+
+    const SliceParameters   slice_;
+    const Parameters        parameters_;
+
+    // • Most recently used first
+    //
+    mutable std::mutex                                  mutex_;
+    Entries                                             entries_;
+    std::unordered_map<uint32_t, Entries::iterator>     lookup_;
+    Statistics                                          statistics_;
+};
+
+} // namespace jzazbz
@@ -0,0 +1,226 @@
+//
+//  ToneMapper.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Graphics/ToneMapper.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    // • Jz of a neutral of `luminance` cd/m² (linear 1.0 is 100 cd/m²)
+    //
+    float neutral_Jz(float luminance)
+    {
+        return from_LMS( linear_display_P3_to_LMS( simd::float3(luminance / 100.0f) ) )[0];
+    }
+
+    // • Triangle model of the target gamut's chroma boundary at one hue
+    //
+    float boundary_chroma(float Jz, simd::float2 cusp, float white_Jz)
+    {
+        if (Jz <= 0.0f || white_Jz <= Jz)
+        {
+            return 0.0f;
+        }
+
+        return (Jz <= cusp.x) ? cusp.y * Jz / cusp.x
+                              : cusp.y * (white_Jz - Jz) / (white_Jz - cusp.x);
+    }
+
+    template <typename Value_>
+    Value_ interpolate(const Value_* table, uint32_t size, float t)
+    {
+        const auto x  = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(size - 1);
+        const auto i0 = std::min( static_cast<uint32_t>(x), size - 2 );
+        const auto f  = x - static_cast<float>(i0);
+
+        return table[i0] + f * (table[i0 + 1] - table[i0]);
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+ToneMapper::ToneMapper(const Parameters& parameters)
+    : parameters_     ( parameters )
+    , source_peak_Jz_ ( neutral_Jz(parameters.source_peak) )
+    , target_white_Jz_( neutral_Jz(parameters.target_white) )
+    , knee_Jz_        ( std::clamp(parameters.knee, 0.0f, 1.0f) * target_white_Jz_ )
+{
+    const auto Jz_size     = std::max(parameters.Jz_size, 2u);
+    const auto hue_count   = std::max(parameters.hue_count, 1u);
+    const auto chroma_size = std::max(parameters.chroma_size, 1u);
+
+    // • Jz curve
+    //
+    Jz_table_.resize(Jz_size);
+
+    for (uint32_t i = 0; i < Jz_size; ++i)
+    {
+        Jz_table_[i] = map_Jz( source_peak_Jz_ * static_cast<float>(i) / static_cast<float>(Jz_size - 1) );
+    }
+
+    // • Chroma scale per hue: target boundary at the mapped Jz over the
+    //   source boundary at the original Jz; the limit is the former
+    //
+    chroma_table_.resize( static_cast<size_t>(hue_count) * (chroma_size + 1) );
+
+    for (uint32_t ih = 0; ih < hue_count; ++ih)
+    {
+        const auto max_c_jab = find_max_chroma_color( 360.0f * static_cast<float>(ih) / static_cast<float>(hue_count) );
+        const auto cusp      = simd::float2{ max_c_jab[0], sqrtf(max_c_jab[1]*max_c_jab[1] + max_c_jab[2]*max_c_jab[2]) };
+        const auto knee_C    = boundary_chroma(knee_Jz_, cusp, target_white_Jz_);
+        const auto row       = chroma_table_.data() + static_cast<size_t>(ih) * (chroma_size + 1);
+
+        for (uint32_t ij = 0; ij <= chroma_size; ++ij)
+        {
+            const auto Jz       = source_peak_Jz_ * static_cast<float>(ij) / static_cast<float>(chroma_size);
+            const auto target_C = boundary_chroma( map_Jz(Jz), cusp, target_white_Jz_ );
+
+            if (Jz <= knee_Jz_)
+            {
+                row[ij] = simd::float2{ 1.0f, target_C };
+
+                continue;
+            }
+
+            const auto source_C = (knee_Jz_ < source_peak_Jz_)
+                                ? knee_C * std::max(source_peak_Jz_ - Jz, 0.0f) / (source_peak_Jz_ - knee_Jz_)
+                                : 0.0f;
+            const auto scale    = (1.0e-9f < source_C) ? std::min(target_C / source_C, 1.0f) : 0.0f;
+
+            row[ij] = simd::float2{ scale, target_C };
+        }
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Curve
+//===------------------------------------------------------------------------===
+
+float ToneMapper::map_Jz(float Jz) const noexcept
+{
+    const auto range  = target_white_Jz_ - knee_Jz_;
+    const auto domain = source_peak_Jz_  - knee_Jz_;
+
+    // • Nothing to compress
+    //
+    if (Jz <= knee_Jz_ || domain <= range || range <= 0.0f)
+    {
+        return Jz;
+    }
+
+    if (source_peak_Jz_ <= Jz)
+    {
+        return target_white_Jz_;
+    }
+
+    // • g(x) = s·x / (1 + (s - 1)·x): g(0) = 0, g'(0) = s, g(1) = 1
+    //
+    const auto s = domain / range;
+    const auto x = (Jz - knee_Jz_) / domain;
+
+    return knee_Jz_ + range * (s * x) / (1.0f + (s - 1.0f) * x);
+}
+
+float ToneMapper::lookup_Jz(float Jz) const noexcept
+{
+    if (Jz <= knee_Jz_)
+    {
+        return Jz;
+    }
+
+    return interpolate( Jz_table_.data(), static_cast<uint32_t>( Jz_table_.size() ), Jz / source_peak_Jz_ );
+}
+
+simd::float2 ToneMapper::lookup_chroma(float hue, float Jz) const noexcept
+{
+    const auto hue_count   = std::max(parameters_.hue_count, 1u);
+    const auto chroma_size = std::max(parameters_.chroma_size, 1u);
+
+    // • Linear in hue (wrapping) and Jz
+    //
+    const auto h  = hue * static_cast<float>(hue_count);
+    const auto h0 = static_cast<uint32_t>(h) % hue_count;
+    const auto h1 = (h0 + 1) % hue_count;
+    const auto fh = h - floorf(h);
+    const auto t  = Jz / source_peak_Jz_;
+
+    const auto s0 = interpolate( chroma_table_.data() + static_cast<size_t>(h0) * (chroma_size + 1), chroma_size + 1, t );
+    const auto s1 = interpolate( chroma_table_.data() + static_cast<size_t>(h1) * (chroma_size + 1), chroma_size + 1, t );
+
+    return s0 + fh * (s1 - s0);
+}
+
+//===------------------------------------------------------------------------===
+// • Mapping
+//===------------------------------------------------------------------------===
+
+simd::float3 ToneMapper::map(simd::float3 jab) const noexcept
+{
+    // • Hue as a fraction of the circle in [0, 1)
+    //
+    const auto turn   = atan2f(jab[2], jab[1]) * static_cast<float>(0.5 / M_PI);
+    const auto hue    = (turn < 0.0f) ? turn + 1.0f : turn;
+    const auto chroma = lookup_chroma( hue, jab[0] );
+    const auto C      = sqrtf(jab[1]*jab[1] + jab[2]*jab[2]);
+    const auto scale  = (chroma.y < chroma.x * C) ? chroma.y / C : chroma.x;
+
+    return simd::float3{ lookup_Jz(jab[0]), scale * jab[1], scale * jab[2] };
+}
+
+void ToneMapper::map_pixels(const float* jab, float* target, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i, jab += 3, target += 3)
+    {
+        const auto mapped = map( simd::float3{ jab[0], jab[1], jab[2] } );
+
+        target[0] = mapped[0];
+        target[1] = mapped[1];
+        target[2] = mapped[2];
+    }
+}
+
+void ToneMapper::map_pixels_to_linear_display_P3(const float* jab, float* lrgb, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i, jab += 3, lrgb += 3)
+    {
+        const auto mapped = convert_to_linear_display_P3( map( simd::float3{ jab[0], jab[1], jab[2] } ) );
+
+        lrgb[0] = mapped[0];
+        lrgb[1] = mapped[1];
+        lrgb[2] = mapped[2];
+    }
+}
+
+} // namespace jzazbz
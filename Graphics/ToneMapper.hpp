@@ -0,0 +1,132 @@
+//
+//  ToneMapper.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Jzazbz.hpp>
+#include <simd/simd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace jzazbz
+//===------------------------------------------------------------------------===
+
+namespace jzazbz
+{
+
+//===------------------------------------------------------------------------===
+//
+// • ToneMapper (Host only)
+//
+//  HDR to SDR in Jzazbz. Jz is kept below a knee (a fraction of the target
+//  white's Jz) and compressed above it by a rational shoulder that meets the
+//  target white at the source peak, continuous in slope at the knee. Hue is
+//  kept exactly: az and bz are scaled together by the ratio of the target
+//  gamut's chroma at the new Jz to the source boundary's chroma at the old
+//  one, so colors keep their place relative to the boundary, and limited to
+//  the target boundary (below the knee too, where the scale is 1).
+//
+//  Boundaries are modeled per hue from the Display P3 cusp
+//  (find_max_chroma_color): straight from black to the cusp and from the cusp
+//  to the target white. The source boundary matches it up to the knee, then
+//  closes linearly to the source peak. The maps are tabulated once: Jz in a
+//  1D table, the chroma scale and limit in a (hue, Jz) table, interpolated
+//  linearly, so a pixel costs an atan2, a square root and three lookups.
+//
+//===------------------------------------------------------------------------===
+
+class ToneMapper
+{
+public:
+
+    struct Parameters
+    {
+        float       source_peak;    // cd/m² mapped to the target white
+        float       target_white;   // cd/m² of linear 1.0 in the output
+        float       knee;           // fraction of the target white's Jz kept as is
+        uint32_t    Jz_size;        // 1D table entries
+        uint32_t    hue_count;      // 2D table hues
+        uint32_t    chroma_size;    // 2D table Jz entries per hue
+    };
+
+    static constexpr Parameters default_parameters = {
+        .source_peak  = 1000.0f,
+        .target_white = 100.0f,
+        .knee         = 0.75f,
+        .Jz_size      = 1024,
+        .hue_count    = 360,
+        .chroma_size  = 128
+    };
+
+    explicit ToneMapper(const Parameters& parameters = default_parameters);
+
+    // • Single color
+    //
+    simd::float3 map(simd::float3 jab) const noexcept;
+
+    // • Interleaved Jzazbz triplets; source and target may be the same buffer
+    //
+    void map_pixels(const float* jab, float* target, size_t count) const;
+
+    // • Mapped and converted to linear Display P3, in one pass
+    //
+    void map_pixels_to_linear_display_P3(const float* jab, float* lrgb, size_t count) const;
+
+    // • Properties
+    //
+    const Parameters& parameters(void) const noexcept
+    {
+        return parameters_;
+    }
+
+    float source_peak_Jz(void) const noexcept
+    {
+        return source_peak_Jz_;
+    }
+
+    float target_white_Jz(void) const noexcept
+    {
+        return target_white_Jz_;
+    }
+
+    // • Untabulated curve, for building and checking the tables
+    //
+    float map_Jz(float Jz) const noexcept;
+
+private:
+
+    float lookup_Jz(float Jz) const noexcept;
+
+    // • (scale, limit)
+    //
+    simd::float2 lookup_chroma(float hue, float Jz) const noexcept;
+
+    const Parameters            parameters_;
+    float                       source_peak_Jz_;
+    float                       target_white_Jz_;
+    float                       knee_Jz_;
+
+    std::vector<float>          Jz_table_;      // Jz_size over [0, source peak]
+    std::vector<simd::float2>   chroma_table_;  // hue_count rows of chroma_size + 1
+};
+
+} // namespace jzazbz
@@ -0,0 +1,283 @@
+//
+//  EXREncoder.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/EXREncoder.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <zlib.h>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+static_assert( std::endian::native == std::endian::little, "EXR data is written in native order" );
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    constexpr uint32_t channel_count = 3;
+
+    template <typename Value_>
+    void append(std::vector<uint8_t>& bytes, Value_ value)
+    {
+        const auto offset = bytes.size();
+
+        bytes.resize( offset + sizeof(Value_) );
+
+        memcpy( bytes.data() + offset, &value, sizeof(Value_) );
+    }
+
+    void append_string(std::vector<uint8_t>& bytes, const char* string)
+    {
+        bytes.insert(bytes.end(), string, string + strlen(string) + 1);
+    }
+
+    void append_attribute(std::vector<uint8_t>& bytes, const char* name, const char* type,
+                          const std::vector<uint8_t>& value)
+    {
+        append_string(bytes, name);
+        append_string(bytes, type);
+        append( bytes, static_cast<int32_t>( value.size() ) );
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+
+    std::vector<uint8_t> make_box(uint32_t width, uint32_t height)
+    {
+        auto box = std::vector<uint8_t>{};
+
+        append( box, int32_t{ 0 } );
+        append( box, int32_t{ 0 } );
+        append( box, static_cast<int32_t>(width)  - 1 );
+        append( box, static_cast<int32_t>(height) - 1 );
+
+        return box;
+    }
+
+    // • ZIP compression: split even and odd bytes, delta-encode, deflate.
+    //   Incompressible blocks are stored raw
+    //
+    void compress_block(std::vector<uint8_t>& raw, int32_t level, std::vector<uint8_t>& compressed)
+    {
+        const auto size = raw.size();
+
+        auto predicted = std::vector<uint8_t>(size);
+        auto even      = predicted.data();
+        auto odd       = predicted.data() + (size + 1)/2;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            *( (0 == (i & 1)) ? even++ : odd++ ) = raw[i];
+        }
+
+        for (size_t i = size - 1; 0 < i; --i)
+        {
+            predicted[i] = static_cast<uint8_t>( int32_t{ predicted[i] } - predicted[i-1] + (128 + 256) );
+        }
+
+        auto length = compressBound( static_cast<uLong>(size) );
+
+        compressed.resize(length);
+
+        const auto status = compress2( compressed.data(), &length, predicted.data(),
+                                       static_cast<uLong>(size), level );
+
+        if (Z_OK == status && length < size)
+        {
+            compressed.resize(length);
+        }
+        else
+        {
+            compressed.swap(raw);
+        }
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+EXREncoder::EXREncoder(const char*            path,
+                       uint32_t               width,
+                       uint32_t               height,
+                       utilities::ThreadPool& pool,
+                       const Options&         options)
+    : ImageEncoder          ( path, width, height )
+    , pool_                 ( pool )
+    , options_              ( options )
+    , batch_top_            ( 0 )
+    , batch_rows_           ( 0 )
+    , batch_capacity_       ( block_rows * std::max(options.blocks_per_batch, 1u) * pool.concurrency() )
+    , blocks_               ( batch_capacity_ / block_rows )
+    , offset_table_position_( 0 )
+    , offsets_              ( (height + block_rows - 1) / block_rows, 0 )
+{
+    batch_.resize( static_cast<size_t>(width) * channel_count * batch_capacity_ );
+
+    auto header = std::vector<uint8_t>{};
+
+    // • Magic number, version 2, single-part scanline
+    //
+    append( header, uint32_t{ 20000630 } );
+    append( header, uint32_t{ 2 } );
+
+    // • Channels, alphabetical: B, G, R (half, linear sampling 1 × 1)
+    //
+    auto channels = std::vector<uint8_t>{};
+
+    for (const auto name : { "B", "G", "R" })
+    {
+        append_string(channels, name);
+        append( channels, int32_t{ 1 } );   // HALF
+        append( channels, uint32_t{ 0 } );  // pLinear, reserved
+        append( channels, int32_t{ 1 } );
+        append( channels, int32_t{ 1 } );
+    }
+
+    channels.push_back(0);
+
+    append_attribute(header, "channels", "chlist", channels);
+
+    // • Display P3 primaries and D65 white
+    //
+    auto chromaticities = std::vector<uint8_t>{};
+
+    for (const auto value : { 0.680f, 0.320f, 0.265f, 0.690f, 0.150f, 0.060f, 0.3127f, 0.3290f })
+    {
+        append(chromaticities, value);
+    }
+
+    append_attribute(header, "chromaticities",     "chromaticities", chromaticities);
+    append_attribute(header, "compression",        "compression",    { 3 }); // ZIP
+    append_attribute(header, "dataWindow",         "box2i",          make_box(width, height));
+    append_attribute(header, "displayWindow",      "box2i",          make_box(width, height));
+    append_attribute(header, "lineOrder",          "lineOrder",      { 0 }); // increasing y
+
+    auto aspect = std::vector<uint8_t>{};
+    auto center = std::vector<uint8_t>{};
+
+    append( aspect, 1.0f );
+    append( center, 0.0f );
+    append( center, 0.0f );
+
+    append_attribute(header, "pixelAspectRatio",   "float",          aspect);
+    append_attribute(header, "screenWindowCenter", "v2f",            center);
+    append_attribute(header, "screenWindowWidth",  "float",          aspect);
+
+    header.push_back(0);
+
+    file_.write(header.data(), header.size());
+
+    // • Offset table, written once every block is in place
+    //
+    offset_table_position_ = file_.size();
+
+    file_.write( offsets_.data(), offsets_.size() * sizeof(uint64_t) );
+}
+
+//===------------------------------------------------------------------------===
+// • Encoding
+//===------------------------------------------------------------------------===
+
+bool EXREncoder::encode_rows(uint32_t top, data::ImageView<simd::float4> strip)
+{
+    const auto plane = static_cast<size_t>( width() );
+
+    for (uint32_t y = 0; y < strip.height; ++y)
+    {
+        const auto source = strip.row(y);
+        const auto target = batch_.data() + batch_rows_ * plane * channel_count;
+
+        for (uint32_t x = 0; x < strip.width; ++x)
+        {
+            target[x]           = data::float_to_half( source[x][2] );
+            target[x + plane]   = data::float_to_half( source[x][1] );
+            target[x + 2*plane] = data::float_to_half( source[x][0] );
+        }
+
+        if ( ++batch_rows_ == batch_capacity_ || top + y + 1 == height() )
+        {
+            if ( !encode_batch() )
+            {
+                return false;
+            }
+        }
+    }
+
+    return is_good();
+}
+
+bool EXREncoder::encode_batch(void)
+{
+    const auto block_count = (batch_rows_ + block_rows - 1) / block_rows;
+    const auto row_bytes   = static_cast<size_t>( width() ) * channel_count * sizeof(uint16_t);
+
+    pool_.parallel_for( block_count, [&](uint32_t ib) {
+
+        auto&      block     = blocks_[ib];
+        const auto first_row = ib * block_rows;
+        const auto row_count = std::min(uint32_t{ block_rows }, batch_rows_ - first_row);
+        const auto source    = reinterpret_cast<const uint8_t*>( batch_.data() ) + first_row * row_bytes;
+
+        block.raw.assign(source, source + row_count * row_bytes);
+
+        compress_block(block.raw, options_.compression_level, block.compressed);
+    });
+
+    for (uint32_t ib = 0; ib < block_count; ++ib)
+    {
+        const auto& block = blocks_[ib];
+        const auto  y     = batch_top_ + ib * block_rows;
+
+        offsets_[y / block_rows] = file_.size();
+
+        auto prefix = std::vector<uint8_t>{};
+
+        append( prefix, static_cast<int32_t>(y) );
+        append( prefix, static_cast<int32_t>( block.compressed.size() ) );
+
+        file_.write(prefix.data(), prefix.size());
+        file_.write(block.compressed.data(), block.compressed.size());
+    }
+
+    batch_top_ += batch_rows_;
+    batch_rows_ = 0;
+
+    return is_good();
+}
+
+bool EXREncoder::encode_end(void)
+{
+    file_.write_at( offset_table_position_, offsets_.data(), offsets_.size() * sizeof(uint64_t) );
+
+    batch_  = {};
+    blocks_ = {};
+
+    return is_good();
+}
+
+} // namespace imaging
@@ -0,0 +1,101 @@
+//
+//  EXREncoder.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Imaging/ImageEncoder.hpp>
+#include <Utilities/ThreadPool.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • EXREncoder
+//
+//  Single-part scanline OpenEXR with half-float R, G, B channels, ZIP
+//  compression (16-row blocks) and Display P3 chromaticities; values are
+//  stored linear and unclamped. Blocks are compressed in parallel, a batch
+//  of blocks at a time; the offset table is reserved after the header and
+//  filled in by finish().
+//
+//===------------------------------------------------------------------------===
+
+class EXREncoder : public ImageEncoder
+{
+public:
+
+    struct Options
+    {
+        uint32_t    blocks_per_batch;   // per pool thread
+        int32_t     compression_level;  // zlib level, 0-9
+    };
+
+    static constexpr Options default_options = {
+        .blocks_per_batch  = 2,
+        .compression_level = 4
+    };
+
+    enum : uint32_t
+    {
+        block_rows = 16
+    };
+
+    EXREncoder(const char*            path,
+               uint32_t               width,
+               uint32_t               height,
+               utilities::ThreadPool& pool    = utilities::ThreadPool::shared(),
+               const Options&         options = default_options);
+
+protected:
+
+    bool encode_rows(uint32_t top, data::ImageView<simd::float4> strip) override;
+    bool encode_end(void) override;
+
+private:
+
+    struct Block
+    {
+        std::vector<uint8_t>    raw;
+        std::vector<uint8_t>    compressed;
+    };
+
+    bool encode_batch(void);
+
+    utilities::ThreadPool&  pool_;
+    const Options           options_;
+
+    // • Pending rows as half-precision B, G, R planes per row
+    //
+    std::vector<uint16_t>   batch_;
+    uint32_t                batch_top_;
+    uint32_t                batch_rows_;
+    uint32_t                batch_capacity_;
+
+    std::vector<Block>      blocks_;
+
+    uint64_t                offset_table_position_;
+    std::vector<uint64_t>   offsets_;
+};
+
+} // namespace imaging
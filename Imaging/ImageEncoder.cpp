@@ -0,0 +1,133 @@
+//
+//  ImageEncoder.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/ImageEncoder.hpp>
+#include <Utilities/FrameTrace.hpp>
+
+#include <algorithm>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+namespace
+{
+    constexpr uint32_t widened_row_count = 16;
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+ImageEncoder::ImageEncoder(const char* path, uint32_t width, uint32_t height)
+    : file_        ( path )
+    , width_       ( width )
+    , height_      ( height )
+    , rows_written_( 0 )
+    , finished_    ( false )
+{
+}
+
+ImageEncoder::~ImageEncoder()
+{
+}
+
+//===------------------------------------------------------------------------===
+// • Writing
+//===------------------------------------------------------------------------===
+
+bool ImageEncoder::write_rows(data::ImageView<simd::float4> strip)
+{
+    if ( finished_ || !is_good() || strip.width != width_ || height_ - rows_written_ < strip.height )
+    {
+        return false;
+    }
+
+    if ( 0 == strip.height )
+    {
+        return true;
+    }
+
+    // • One span per strip, so output_encoding statistics are per strip
+    //
+    TRACE_SPAN(output_encoding);
+
+    const auto top = rows_written_;
+
+    rows_written_ += strip.height;
+
+    return encode_rows(top, strip);
+}
+
+bool ImageEncoder::write_rows(data::ImageView<data::half4> strip)
+{
+    widened_.resize( static_cast<size_t>(width_) * widened_row_count );
+
+    for (uint32_t first = 0; first < strip.height; first += widened_row_count)
+    {
+        const auto row_count = std::min(widened_row_count, strip.height - first);
+
+        for (uint32_t y = 0; y < row_count; ++y)
+        {
+            const auto source = strip.row(first + y);
+            const auto target = widened_.data() + static_cast<size_t>(y) * width_;
+
+            for (uint32_t x = 0; x < strip.width && x < width_; ++x)
+            {
+                target[x] = data::make_float4(source[x]);
+            }
+        }
+
+        const auto widened = data::ImageView<simd::float4>{
+            .pixels = widened_.data(),
+            .width  = strip.width,
+            .height = row_count,
+            .stride = width_
+        };
+
+        if ( !write_rows(widened) )
+        {
+            return false;
+        }
+    }
+
+    return is_good();
+}
+
+bool ImageEncoder::finish(void)
+{
+    if (finished_)
+    {
+        return is_good();
+    }
+
+    finished_ = true;
+
+    TRACE_SPAN(output_encoding);
+
+    const auto complete = rows_written_ == height_ && is_good() && encode_end();
+
+    return file_.close() && complete;
+}
+
+} // namespace imaging
@@ -0,0 +1,113 @@
+//
+//  ImageEncoder.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Data/Half.hpp>
+#include <Data/Image.hpp>
+#include <Imaging/OutputFile.hpp>
+
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • ImageEncoder (Host only)
+//
+//  Row-streaming image file writer. Strips of linear Display P3 rows are
+//  appended top to bottom as they are produced and encoded as soon as enough
+//  rows are available, so an encoder holds at most a bounded batch of rows
+//  regardless of the image height. finish() must be called after the last
+//  row to complete the file.
+//
+//===------------------------------------------------------------------------===
+
+class ImageEncoder
+{
+public:
+
+    ImageEncoder(const char* path, uint32_t width, uint32_t height);
+    virtual ~ImageEncoder();
+
+    ImageEncoder(const ImageEncoder&) = delete;
+    ImageEncoder& operator = (const ImageEncoder&) = delete;
+
+    // • Append the next strip.height rows; strip.width must equal width()
+    //
+    bool write_rows(data::ImageView<simd::float4> strip);
+    bool write_rows(data::ImageView<data::half4>  strip);
+
+    // • Encode any pending rows, complete and close the file. Fails if
+    //   fewer than height() rows were written
+    //
+    bool finish(void);
+
+    // • Properties
+    //
+    uint32_t width(void) const noexcept
+    {
+        return width_;
+    }
+
+    uint32_t height(void) const noexcept
+    {
+        return height_;
+    }
+
+    uint32_t rows_written(void) const noexcept
+    {
+        return rows_written_;
+    }
+
+    bool is_good(void) const noexcept
+    {
+        return file_.is_good();
+    }
+
+protected:
+
+    // • Rows [top, top + strip.height) in order
+    //
+    virtual bool encode_rows(uint32_t top, data::ImageView<simd::float4> strip) = 0;
+
+    // • After the last row
+    //
+    virtual bool encode_end(void) = 0;
+
+    OutputFile                  file_;
+
+private:
+
+    const uint32_t              width_;
+    const uint32_t              height_;
+    uint32_t                    rows_written_;
+    bool                        finished_;
+
+    // • Half-precision strips are widened a few rows at a time
+    //
+    std::vector<simd::float4>   widened_;
+};
+
+} // namespace imaging
@@ -0,0 +1,88 @@
+//
+//  InputFile.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/InputFile.hpp>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+InputFile::InputFile(const char* path)
+    : descriptor_( ::open(path, O_RDONLY | O_CLOEXEC) )
+    , size_      ( 0 )
+{
+    struct stat status;
+
+    if ( is_open() && 0 == ::fstat(descriptor_, &status) )
+    {
+        size_ = static_cast<uint64_t>(status.st_size);
+    }
+}
+
+InputFile::~InputFile()
+{
+    if ( is_open() )
+    {
+        ::close(descriptor_);
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Reading
+//===------------------------------------------------------------------------===
+
+bool InputFile::read_at(uint64_t offset, void* bytes, size_t size) const
+{
+    auto target = static_cast<uint8_t*>(bytes);
+
+    while (0 < size)
+    {
+        const auto count = ::pread( descriptor_, target, size, static_cast<off_t>(offset) );
+
+        if (count < 0 && EINTR == errno)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        target += count;
+        offset += static_cast<uint64_t>(count);
+        size   -= static_cast<size_t>(count);
+    }
+
+    return true;
+}
+
+} // namespace imaging
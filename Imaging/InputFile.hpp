@@ -0,0 +1,74 @@
+//
+//  InputFile.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • InputFile (Host only)
+//
+//  Read-only POSIX file read with positioned reads (pread), so that strips
+//  of arbitrarily large files can be fetched into fixed buffers, from any
+//  thread, without mapping or caching the whole file.
+//
+//===------------------------------------------------------------------------===
+
+class InputFile
+{
+public:
+
+    explicit InputFile(const char* path);
+    ~InputFile();
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator = (const InputFile&) = delete;
+
+    // • Read exactly `size` bytes at `offset`
+    //
+    bool read_at(uint64_t offset, void* bytes, size_t size) const;
+
+    // • Properties
+    //
+    bool is_open(void) const noexcept
+    {
+        return 0 <= descriptor_;
+    }
+
+    uint64_t size(void) const noexcept
+    {
+        return size_;
+    }
+
+private:
+
+    int         descriptor_;
+    uint64_t    size_;
+};
+
+} // namespace imaging
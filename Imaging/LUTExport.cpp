@@ -0,0 +1,447 @@
+//
+//  LUTExport.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/LUTExport.hpp>
+#include <Imaging/OutputFile.hpp>
+#include <Graphics/ChromaticAdaptation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <memory>
+#include <string>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    // • PCSXYZ in 16-bit LUT tags: 0xFFFF is 1 + 32767/32768
+    //
+    constexpr float pcs_xyz_max = 1.0f + 32767.0f / 32768.0f;
+
+    // • D50 PCS illuminant and media white
+    //
+    constexpr auto pcs_white = simd::float3{ 0.9642f, 1.0f, 0.8249f };
+
+    simd::float3 clamp_unit(simd::float3 value)
+    {
+        return simd::clamp( value, simd::float3(0.0f), simd::float3(1.0f) );
+    }
+
+    template <typename Convert_>
+    void sample_grid(LUT3D& lut, utilities::ThreadPool& pool, Convert_ convert)
+    {
+        const auto size  = lut.grid_size;
+        const auto scale = 1.0f / static_cast<float>(size - 1);
+
+        pool.parallel_for( size, [&](uint32_t i2) {
+
+            auto target = lut.samples.data() + static_cast<size_t>(size) * size * i2;
+
+            for (uint32_t i1 = 0; i1 < size; ++i1)
+            {
+                for (uint32_t i0 = 0; i0 < size; ++i0)
+                {
+                    *target++ = convert( simd::float3{ scale * i0, scale * i1, scale * i2 } );
+                }
+            }
+        });
+    }
+
+    //===--------------------------------------------------------------------===
+    // • ICC encoding (big-endian)
+    //===--------------------------------------------------------------------===
+
+    void append_u16(std::vector<uint8_t>& bytes, uint16_t value)
+    {
+        bytes.push_back( static_cast<uint8_t>(value >> 8) );
+        bytes.push_back( static_cast<uint8_t>(value) );
+    }
+
+    void append_u32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        bytes.push_back( static_cast<uint8_t>(value >> 24) );
+        bytes.push_back( static_cast<uint8_t>(value >> 16) );
+        bytes.push_back( static_cast<uint8_t>(value >> 8) );
+        bytes.push_back( static_cast<uint8_t>(value) );
+    }
+
+    void append_signature(std::vector<uint8_t>& bytes, const char* signature)
+    {
+        const auto offset = bytes.size();
+
+        bytes.resize(offset + 4);
+
+        memcpy(bytes.data() + offset, signature, 4);
+    }
+
+    void append_s15_fixed16(std::vector<uint8_t>& bytes, float value)
+    {
+        append_u32( bytes, static_cast<uint32_t>( static_cast<int32_t>( lroundf(value * 65536.0f) ) ) );
+    }
+
+    void pad_to_4(std::vector<uint8_t>& bytes)
+    {
+        bytes.resize( (bytes.size() + 3) & ~size_t{ 3 } );
+    }
+
+    void set_u32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value)
+    {
+        bytes[offset]     = static_cast<uint8_t>(value >> 24);
+        bytes[offset + 1] = static_cast<uint8_t>(value >> 16);
+        bytes[offset + 2] = static_cast<uint8_t>(value >> 8);
+        bytes[offset + 3] = static_cast<uint8_t>(value);
+    }
+
+    // • multiLocalizedUnicodeType, one en-US record; ASCII only
+    //
+    std::vector<uint8_t> make_mluc(const char* text)
+    {
+        auto       tag    = std::vector<uint8_t>{};
+        const auto length = static_cast<uint32_t>( strlen(text) );
+
+        append_signature(tag, "mluc");
+        append_u32(tag, 0);
+        append_u32(tag, 1);             // records
+        append_u32(tag, 12);            // record size
+        append_signature(tag, "enUS");
+        append_u32(tag, 2 * length);
+        append_u32(tag, 28);            // offset from the tag start
+
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            const auto c = static_cast<unsigned char>(text[i]);
+
+            append_u16( tag, (c < 0x80) ? c : '?' );
+        }
+
+        return tag;
+    }
+
+    std::vector<uint8_t> make_XYZ(simd::float3 xyz)
+    {
+        auto tag = std::vector<uint8_t>{};
+
+        append_signature(tag, "XYZ ");
+        append_u32(tag, 0);
+        append_s15_fixed16(tag, xyz[0]);
+        append_s15_fixed16(tag, xyz[1]);
+        append_s15_fixed16(tag, xyz[2]);
+
+        return tag;
+    }
+
+    void append_identity_curves(std::vector<uint8_t>& tag)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            append_signature(tag, "curv");
+            append_u32(tag, 0);
+            append_u32(tag, 0);         // no entries: identity
+        }
+    }
+
+    // • lutAtoBType ("mAB ") or lutBtoAType ("mBA "): B curves, a 16-bit
+    //   CLUT and A curves. The element offsets are in the same order in both
+    //   and unused elements (M curves, matrix) are 0
+    //
+    std::vector<uint8_t> make_lut_tag(const char* signature, const LUT3D& lut)
+    {
+        auto tag = std::vector<uint8_t>{};
+
+        append_signature(tag, signature);
+        append_u32(tag, 0);
+        tag.push_back(3);               // input channels
+        tag.push_back(3);               // output channels
+        append_u16(tag, 0);
+
+        const auto offsets = tag.size();
+
+        tag.resize(offsets + 5 * 4);
+
+        // • B curves
+        //
+        set_u32( tag, offsets, static_cast<uint32_t>( tag.size() ) );
+        append_identity_curves(tag);
+
+        // • CLUT: first input channel slowest
+        //
+        set_u32( tag, offsets + 12, static_cast<uint32_t>( tag.size() ) );
+
+        for (int i = 0; i < 16; ++i)
+        {
+            tag.push_back( static_cast<uint8_t>( (i < 3) ? lut.grid_size : 0 ) );
+        }
+
+        tag.push_back(2);               // bytes per value
+        tag.insert(tag.end(), 3, 0);
+
+        tag.reserve( tag.size() + lut.samples.size() * 6 + 64 );
+
+        for (uint32_t i0 = 0; i0 < lut.grid_size; ++i0)
+        {
+            for (uint32_t i1 = 0; i1 < lut.grid_size; ++i1)
+            {
+                for (uint32_t i2 = 0; i2 < lut.grid_size; ++i2)
+                {
+                    const auto value = clamp_unit( lut.at(i0, i1, i2) ) * 65535.0f;
+
+                    append_u16( tag, static_cast<uint16_t>( lroundf(value[0]) ) );
+                    append_u16( tag, static_cast<uint16_t>( lroundf(value[1]) ) );
+                    append_u16( tag, static_cast<uint16_t>( lroundf(value[2]) ) );
+                }
+            }
+        }
+
+        pad_to_4(tag);
+
+        // • A curves
+        //
+        set_u32( tag, offsets + 16, static_cast<uint32_t>( tag.size() ) );
+        append_identity_curves(tag);
+
+        return tag;
+    }
+
+    bool is_valid(const LUT3D& lut)
+    {
+        return 2 <= lut.grid_size && lut.grid_size <= 255
+            && lut.samples.size() == static_cast<size_t>(lut.grid_size) * lut.grid_size * lut.grid_size;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Sampling
+//===------------------------------------------------------------------------===
+
+LUT3D sample_lut(LUTTransform transform, const LUTParameters& parameters, utilities::ThreadPool& pool)
+{
+    const auto size = parameters.grid_size;
+
+    if (size < 2 || 255 < size)
+    {
+        return { .grid_size = 0, .samples = {} };
+    }
+
+    auto lut = LUT3D{
+        .grid_size = size,
+        .samples   = std::vector<simd::float3>( static_cast<size_t>(size) * size * size )
+    };
+
+    const auto& encoding = parameters.encoding;
+
+    // • D50 PCS: XYZ of linear P3 and Jzazbz LMS, folded once
+    //
+    const auto pcs       = jzazbz::make_XYZ_conversion(jzazbz::white_point::D50);
+    const auto P3_to_XYZ = pcs.from_LMS * jzazbz::make_RGB_conversion(jzazbz::display_P3_primaries).to_LMS;
+
+    auto tone_mapper = std::unique_ptr<jzazbz::ToneMapper>{};
+
+    if ( LUTTransform::jzazbz_tone_mapped_to_linear_display_P3 == transform
+      || LUTTransform::jzazbz_tone_mapped_to_PCS_XYZ           == transform )
+    {
+        tone_mapper = std::make_unique<jzazbz::ToneMapper>(parameters.tone_map);
+    }
+
+    switch (transform)
+    {
+        case LUTTransform::jzazbz_to_linear_display_P3:
+            sample_grid( lut, pool, [&](simd::float3 value) {
+                return jzazbz::convert_to_linear_display_P3( decode_jzazbz(value, encoding) );
+            });
+            break;
+
+        case LUTTransform::jzazbz_tone_mapped_to_linear_display_P3:
+            sample_grid( lut, pool, [&](simd::float3 value) {
+                return clamp_unit( jzazbz::convert_to_linear_display_P3( tone_mapper->map( decode_jzazbz(value, encoding) ) ) );
+            });
+            break;
+
+        case LUTTransform::linear_display_P3_to_jzazbz:
+            sample_grid( lut, pool, [&](simd::float3 value) {
+                return encode_jzazbz( jzazbz::convert_from_linear_display_P3(value), encoding );
+            });
+            break;
+
+        case LUTTransform::jzazbz_tone_mapped_to_PCS_XYZ:
+            sample_grid( lut, pool, [&](simd::float3 value) {
+                const auto lrgb = clamp_unit( jzazbz::convert_to_linear_display_P3( tone_mapper->map( decode_jzazbz(value, encoding) ) ) );
+
+                return (P3_to_XYZ * lrgb) / pcs_xyz_max;
+            });
+            break;
+
+        case LUTTransform::PCS_XYZ_to_jzazbz:
+            sample_grid( lut, pool, [&](simd::float3 value) {
+                return clamp_unit( encode_jzazbz( jzazbz::convert_from_adapted(value * pcs_xyz_max, pcs), encoding ) );
+            });
+            break;
+    }
+
+    return lut;
+}
+
+//===------------------------------------------------------------------------===
+// • .cube
+//===------------------------------------------------------------------------===
+
+bool write_cube_lut(const char* path, const LUT3D& lut, const char* title)
+{
+    if ( !is_valid(lut) )
+    {
+        return false;
+    }
+
+    auto file = OutputFile{ path };
+    auto text = std::string{};
+
+    text += "TITLE \"";
+    text += title;
+    text += "\"\nLUT_3D_SIZE " + std::to_string(lut.grid_size) + "\n";
+    text += "DOMAIN_MIN 0.0 0.0 0.0\nDOMAIN_MAX 1.0 1.0 1.0\n";
+
+    // • Red fastest, as stored; one write per 64 KiB or so
+    //
+    char line[64];
+
+    for (const auto& sample : lut.samples)
+    {
+        const auto length = snprintf(line, sizeof(line), "%.6f %.6f %.6f\n", sample[0], sample[1], sample[2]);
+
+        text.append(line, static_cast<size_t>(length));
+
+        if (65536 <= text.size())
+        {
+            file.write( text.data(), text.size() );
+            text.clear();
+        }
+    }
+
+    file.write( text.data(), text.size() );
+
+    return file.close();
+}
+
+//===------------------------------------------------------------------------===
+// • ICC v4 profile
+//===------------------------------------------------------------------------===
+
+bool write_icc_profile(const char* path, const LUT3D& a_to_b, const LUT3D& b_to_a, const char* description)
+{
+    if ( !is_valid(a_to_b) || !is_valid(b_to_a) )
+    {
+        return false;
+    }
+
+    struct Tag
+    {
+        const char*             signature;
+        std::vector<uint8_t>    data;
+    };
+
+    const Tag tags[] = {
+        { "desc", make_mluc(description) },
+        { "cprt", make_mluc("Copyright (c) 2024 Robert Guequierre, GPL-3.0-or-later") },
+        { "wtpt", make_XYZ(pcs_white) },
+        { "A2B0", make_lut_tag("mAB ", a_to_b) },
+        { "B2A0", make_lut_tag("mBA ", b_to_a) }
+    };
+
+    constexpr auto tag_count = static_cast<uint32_t>( std::size(tags) );
+
+    // • Header
+    //
+    auto profile = std::vector<uint8_t>{};
+
+    const auto now = std::time(nullptr);
+    auto       utc = std::tm{};
+
+    gmtime_r(&now, &utc);
+
+    append_u32(profile, 0);                     // size, patched below
+    append_u32(profile, 0);                     // preferred CMM
+    append_u32(profile, 0x04300000);            // version 4.3
+    append_signature(profile, "spac");          // ColorSpace class
+    append_signature(profile, "3CLR");          // encoded Jzazbz
+    append_signature(profile, "XYZ ");
+    append_u16( profile, static_cast<uint16_t>(utc.tm_year + 1900) );
+    append_u16( profile, static_cast<uint16_t>(utc.tm_mon + 1) );
+    append_u16( profile, static_cast<uint16_t>(utc.tm_mday) );
+    append_u16( profile, static_cast<uint16_t>(utc.tm_hour) );
+    append_u16( profile, static_cast<uint16_t>(utc.tm_min) );
+    append_u16( profile, static_cast<uint16_t>(utc.tm_sec) );
+    append_signature(profile, "acsp");
+    append_signature(profile, "APPL");
+    append_u32(profile, 0);                     // flags
+    append_u32(profile, 0);                     // manufacturer
+    append_u32(profile, 0);                     // model
+    append_u32(profile, 0);                     // attributes
+    append_u32(profile, 0);
+    append_u32(profile, 0);                     // perceptual
+    append_s15_fixed16(profile, pcs_white[0]);
+    append_s15_fixed16(profile, pcs_white[1]);
+    append_s15_fixed16(profile, pcs_white[2]);
+    append_u32(profile, 0);                     // creator
+
+    profile.resize(128);                        // profile ID (not computed) and reserved
+
+    // • Tag table, then the 4-byte aligned tag data
+    //
+    append_u32(profile, tag_count);
+
+    auto offset = static_cast<uint32_t>( profile.size() + 12 * tag_count );
+
+    for (const auto& tag : tags)
+    {
+        append_signature(profile, tag.signature);
+        append_u32(profile, offset);
+        append_u32( profile, static_cast<uint32_t>( tag.data.size() ) );
+
+        offset += static_cast<uint32_t>( (tag.data.size() + 3) & ~size_t{ 3 } );
+    }
+
+    for (const auto& tag : tags)
+    {
+        profile.insert(profile.end(), tag.data.begin(), tag.data.end());
+        pad_to_4(profile);
+    }
+
+    set_u32( profile, 0, static_cast<uint32_t>( profile.size() ) );
+
+    auto file = OutputFile{ path };
+
+    file.write( profile.data(), profile.size() );
+
+    return file.close();
+}
+
+} // namespace imaging
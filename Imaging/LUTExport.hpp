@@ -0,0 +1,133 @@
+//
+//  LUTExport.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/ToneMapper.hpp>
+#include <Utilities/ThreadPool.hpp>
+#include <simd/simd.h>
+
+#include <cstdint>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • LUT Export (Host only)
+//
+//  The Jzazbz conversions sampled on a 3D grid, for CMMs and grading tools
+//  that apply a table instead of calling this code per pixel: a .cube file
+//  (Resolve / Adobe 3D LUT) or an ICC v4 ColorSpace profile whose A2B0 and
+//  B2A0 are lutAtoBType / lutBtoAType CLUTs with identity curves.
+//
+//  Jzazbz is carried in [0, 1]³ by JzazbzEncoding: Jz / Jz_max and
+//  0.5 + az,bz / (2·ab_max), so neutrals sit on the 0.5 plane (a grid node
+//  when the size is odd). The profile's PCS is XYZ relative to D50, adapted
+//  from D65 with Bradford; diffuse white, linear 1.0, is the PCS white.
+//
+//===------------------------------------------------------------------------===
+
+struct JzazbzEncoding
+{
+    float   Jz_max;     // 1000 cd/m² neutral is 0.401
+    float   ab_max;     // Display P3 at 1000 cd/m² reaches 0.253
+};
+
+constexpr JzazbzEncoding default_jzazbz_encoding = {
+    .Jz_max = 0.42f,
+    .ab_max = 0.27f
+};
+
+inline simd::float3 encode_jzazbz(simd::float3 jab, const JzazbzEncoding& encoding)
+{
+    return simd::float3{ jab[0] / encoding.Jz_max,
+                         0.5f + 0.5f * jab[1] / encoding.ab_max,
+                         0.5f + 0.5f * jab[2] / encoding.ab_max };
+}
+
+inline simd::float3 decode_jzazbz(simd::float3 value, const JzazbzEncoding& encoding)
+{
+    return simd::float3{ value[0] * encoding.Jz_max,
+                         (2.0f * value[1] - 1.0f) * encoding.ab_max,
+                         (2.0f * value[2] - 1.0f) * encoding.ab_max };
+}
+
+// • Input → output, both in [0, 1]³ unless noted
+//
+enum class LUTTransform : uint32_t
+{
+    jzazbz_to_linear_display_P3,                // encoded Jzazbz → linear P3, unclamped
+    jzazbz_tone_mapped_to_linear_display_P3,    // through ToneMapper, clamped
+    linear_display_P3_to_jzazbz,                // linear P3 → encoded Jzazbz
+    jzazbz_tone_mapped_to_PCS_XYZ,              // ICC A2B0: PCSXYZ 16-bit encoding
+    PCS_XYZ_to_jzazbz                           // ICC B2A0
+};
+
+struct LUTParameters
+{
+    uint32_t                        grid_size;  // points per axis, 2 to 255
+    JzazbzEncoding                  encoding;
+    jzazbz::ToneMapper::Parameters  tone_map;   // tone-mapped transforms only
+};
+
+constexpr LUTParameters default_lut_parameters = {
+    .grid_size = 65,
+    .encoding  = default_jzazbz_encoding,
+    .tone_map  = jzazbz::ToneMapper::default_parameters
+};
+
+//===------------------------------------------------------------------------===
+// • LUT3D
+//===------------------------------------------------------------------------===
+
+struct LUT3D
+{
+    uint32_t                    grid_size;
+    std::vector<simd::float3>   samples;        // first input fastest, as .cube
+
+    const simd::float3& at(uint32_t i0, uint32_t i1, uint32_t i2) const noexcept
+    {
+        return samples[ i0 + static_cast<size_t>(grid_size) * (i1 + static_cast<size_t>(grid_size) * i2) ];
+    }
+};
+
+// • One grid plane per task. Empty if the grid size is out of range
+//
+LUT3D sample_lut(LUTTransform           transform,
+                 const LUTParameters&   parameters = default_lut_parameters,
+                 utilities::ThreadPool& pool       = utilities::ThreadPool::shared());
+
+//===------------------------------------------------------------------------===
+// • Files
+//===------------------------------------------------------------------------===
+
+bool write_cube_lut(const char* path, const LUT3D& lut, const char* title);
+
+// • `a_to_b` from jzazbz_tone_mapped_to_PCS_XYZ, `b_to_a` from
+//   PCS_XYZ_to_jzazbz (or any pair with those encodings)
+//
+bool write_icc_profile(const char* path, const LUT3D& a_to_b, const LUT3D& b_to_a, const char* description);
+
+} // namespace imaging
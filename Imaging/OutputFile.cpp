@@ -0,0 +1,99 @@
+//
+//  OutputFile.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/OutputFile.hpp>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+OutputFile::OutputFile(const char* path)
+    : descriptor_( ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) )
+    , end_       ( 0 )
+    , good_      ( 0 <= descriptor_ )
+{
+}
+
+OutputFile::~OutputFile()
+{
+    close();
+}
+
+//===------------------------------------------------------------------------===
+// • Writing
+//===------------------------------------------------------------------------===
+
+bool OutputFile::write(const void* bytes, size_t size)
+{
+    if ( write_at(end_, bytes, size) )
+    {
+        end_ += size;
+    }
+
+    return good_;
+}
+
+bool OutputFile::write_at(uint64_t offset, const void* bytes, size_t size)
+{
+    auto source = static_cast<const uint8_t*>(bytes);
+
+    while (good_ && 0 < size)
+    {
+        const auto written = ::pwrite( descriptor_, source, size, static_cast<off_t>(offset) );
+
+        if (written < 0)
+        {
+            good_ = (EINTR == errno);
+            continue;
+        }
+
+        source += written;
+        offset += static_cast<uint64_t>(written);
+        size   -= static_cast<size_t>(written);
+    }
+
+    return good_;
+}
+
+bool OutputFile::close(void)
+{
+    if (descriptor_ < 0)
+    {
+        return good_;
+    }
+
+    good_ = 0 == ::close(descriptor_) && good_;
+
+    descriptor_ = -1;
+
+    return good_;
+}
+
+} // namespace imaging
@@ -0,0 +1,93 @@
+//
+//  OutputFile.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • OutputFile (Host only)
+//
+//  Unbuffered POSIX file for encoders: sequential appends plus positioned
+//  writes for headers and offset tables patched after the data. Any failed
+//  write latches is_good() to false; later writes are ignored.
+//
+//===------------------------------------------------------------------------===
+
+class OutputFile
+{
+public:
+
+    // • Initialization. Creates or truncates `path`
+    //
+    explicit OutputFile(const char* path);
+    ~OutputFile();
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator = (const OutputFile&) = delete;
+
+    // • Append at the current end
+    //
+    bool write(const void* bytes, size_t size);
+
+    // • Write at `offset` without moving the end
+    //
+    bool write_at(uint64_t offset, const void* bytes, size_t size);
+
+    // • Close; returns is_good()
+    //
+    bool close(void);
+
+    // • Latch is_good() to false without a failed write, for an encoder that
+    //   cannot produce a valid file
+    //
+    void fail(void) noexcept
+    {
+        good_ = false;
+    }
+
+    // • Properties
+    //
+    bool is_good(void) const noexcept
+    {
+        return good_;
+    }
+
+    uint64_t size(void) const noexcept
+    {
+        return end_;
+    }
+
+private:
+
+    int         descriptor_;
+    uint64_t    end_;
+    bool        good_;
+};
+
+} // namespace imaging
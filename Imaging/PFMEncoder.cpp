@@ -0,0 +1,91 @@
+//
+//  PFMEncoder.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/PFMEncoder.hpp>
+
+#include <bit>
+#include <cstdio>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+static_assert( std::endian::native == std::endian::little, "PFM samples are written in native order" );
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+PFMEncoder::PFMEncoder(const char* path, uint32_t width, uint32_t height)
+    : ImageEncoder( path, width, height )
+    , header_size_( 0 )
+{
+    // • A negative scale denotes little-endian samples
+    //
+    char header[64];
+
+    const auto length = snprintf(header, sizeof(header), "PF\n%u %u\n-1.0\n", width, height);
+
+    header_size_ = static_cast<uint64_t>(length);
+
+    file_.write(header, header_size_);
+}
+
+//===------------------------------------------------------------------------===
+// • Encoding
+//===------------------------------------------------------------------------===
+
+bool PFMEncoder::encode_rows(uint32_t top, data::ImageView<simd::float4> strip)
+{
+    const auto row_size = static_cast<size_t>( width() ) * 3;
+
+    rows_.resize(row_size * strip.height);
+
+    // • Reverse the strip so it lands in one contiguous write
+    //
+    for (uint32_t y = 0; y < strip.height; ++y)
+    {
+        const auto source = strip.row(y);
+        auto       target = rows_.data() + (strip.height - 1 - y) * row_size;
+
+        for (uint32_t x = 0; x < strip.width; ++x)
+        {
+            *target++ = source[x][0];
+            *target++ = source[x][1];
+            *target++ = source[x][2];
+        }
+    }
+
+    const auto bottom_row = height() - (top + strip.height);
+    const auto offset     = header_size_ + static_cast<uint64_t>(bottom_row) * row_size * sizeof(float);
+
+    return file_.write_at( offset, rows_.data(), rows_.size() * sizeof(float) );
+}
+
+bool PFMEncoder::encode_end(void)
+{
+    rows_ = {};
+
+    return is_good();
+}
+
+} // namespace imaging
@@ -0,0 +1,58 @@
+//
+//  PFMEncoder.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Imaging/ImageEncoder.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • PFMEncoder
+//
+//  Portable float map (little-endian RGB float32), unclamped linear values.
+//  PFM stores rows bottom-up; every strip is written in place at its final
+//  offset, so rows never need to be held until the end.
+//
+//===------------------------------------------------------------------------===
+
+class PFMEncoder : public ImageEncoder
+{
+public:
+
+    PFMEncoder(const char* path, uint32_t width, uint32_t height);
+
+protected:
+
+    bool encode_rows(uint32_t top, data::ImageView<simd::float4> strip) override;
+    bool encode_end(void) override;
+
+private:
+
+    uint64_t            header_size_;
+    std::vector<float>  rows_;
+};
+
+} // namespace imaging
@@ -0,0 +1,125 @@
+//
+//  PFMReader.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/PFMReader.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+PFMReader::PFMReader(const char* path)
+    : file_       ( path )
+    , width_      ( 0 )
+    , height_     ( 0 )
+    , data_offset_( 0 )
+    , swap_bytes_ ( false )
+{
+    // • "PF", width, height and scale separated by whitespace, then a single
+    //   whitespace character before the samples
+    //
+    char header[128] = {};
+
+    const auto header_size = std::min( file_.size(), uint64_t{ sizeof(header) - 1 } );
+
+    if ( !file_.is_open() || !file_.read_at(0, header, header_size) || 0 != strncmp(header, "PF", 2) )
+    {
+        return;
+    }
+
+    char* cursor = header + 2;
+
+    const auto width  = strtoul(cursor, &cursor, 10);
+    const auto height = strtoul(cursor, &cursor, 10);
+    const auto scale  = strtof(cursor, &cursor);
+
+    if ( 0 == width || 0 == height || 0.0f == scale || header + header_size <= cursor )
+    {
+        return;
+    }
+
+    const auto data_offset = static_cast<uint64_t>(cursor - header) + 1;
+    const auto data_size   = static_cast<uint64_t>(width) * height * 3 * sizeof(float);
+
+    if ( file_.size() < data_offset + data_size )
+    {
+        return;
+    }
+
+    width_       = static_cast<uint32_t>(width);
+    height_      = static_cast<uint32_t>(height);
+    data_offset_ = data_offset;
+    swap_bytes_  = (scale < 0.0f) != (std::endian::native == std::endian::little);
+}
+
+//===------------------------------------------------------------------------===
+// • Reading
+//===------------------------------------------------------------------------===
+
+bool PFMReader::read_rows(uint32_t top, uint32_t row_count, float* rows) const
+{
+    if ( !is_valid() || height_ < top || height_ - top < row_count )
+    {
+        return false;
+    }
+
+    // • The strip is one contiguous, bottom-up range of the file
+    //
+    const auto first_file_row = height_ - (top + row_count);
+    const auto offset         = data_offset_ + static_cast<uint64_t>(first_file_row) * row_size();
+
+    if ( !file_.read_at(offset, rows, row_count * row_size()) )
+    {
+        return false;
+    }
+
+    const auto row_floats = static_cast<size_t>(width_) * 3;
+
+    for (uint32_t y = 0; y < row_count/2; ++y)
+    {
+        std::swap_ranges( rows + y * row_floats, rows + (y + 1) * row_floats,
+                          rows + (row_count - 1 - y) * row_floats );
+    }
+
+    if (swap_bytes_)
+    {
+        const auto words = reinterpret_cast<uint32_t*>(rows);
+
+        for (size_t i = 0; i < row_floats * row_count; ++i)
+        {
+            words[i] = __builtin_bswap32(words[i]);
+        }
+    }
+
+    return true;
+}
+
+} // namespace imaging
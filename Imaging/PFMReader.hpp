@@ -0,0 +1,83 @@
+//
+//  PFMReader.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Imaging/InputFile.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • PFMReader (Host only)
+//
+//  Strip access to RGB portable float maps of any size. Rows are returned
+//  top to bottom as interleaved float triplets in native byte order,
+//  regardless of the file's bottom-up row order and endianness.
+//
+//===------------------------------------------------------------------------===
+
+class PFMReader
+{
+public:
+
+    explicit PFMReader(const char* path);
+
+    // • Read rows [top, top + row_count) into `rows` (row_count × width × 3
+    //   floats). Safe to call from any thread
+    //
+    bool read_rows(uint32_t top, uint32_t row_count, float* rows) const;
+
+    // • Properties
+    //
+    bool is_valid(void) const noexcept
+    {
+        return 0 < width_ && 0 < height_;
+    }
+
+    uint32_t width(void) const noexcept
+    {
+        return width_;
+    }
+
+    uint32_t height(void) const noexcept
+    {
+        return height_;
+    }
+
+    size_t row_size(void) const noexcept
+    {
+        return static_cast<size_t>(width_) * 3 * sizeof(float);
+    }
+
+private:
+
+    InputFile   file_;
+    uint32_t    width_;
+    uint32_t    height_;
+    uint64_t    data_offset_;
+    bool        swap_bytes_;
+};
+
+} // namespace imaging
@@ -0,0 +1,323 @@
+//
+//  PNGEncoder.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/PNGEncoder.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <zlib.h>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void append_u32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        bytes.push_back( static_cast<uint8_t>(value >> 24) );
+        bytes.push_back( static_cast<uint8_t>(value >> 16) );
+        bytes.push_back( static_cast<uint8_t>(value >>  8) );
+        bytes.push_back( static_cast<uint8_t>(value) );
+    }
+
+    // • sRGB transfer curve (shared by Display P3), clipped to 16 bits
+    //
+    uint16_t encode_sample(float linear)
+    {
+        const auto v = std::clamp(linear, 0.0f, 1.0f);
+        const auto e = (v <= 0.0031308f) ? 12.92f*v : 1.055f*powf(v, 1.0f/2.4f) - 0.055f;
+
+        return static_cast<uint16_t>( lrintf(e * 65535.0f) );
+    }
+
+    uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+    {
+        const auto p  = int32_t{ a } + int32_t{ b } - int32_t{ c };
+        const auto pa = abs(p - a);
+        const auto pb = abs(p - b);
+        const auto pc = abs(p - c);
+
+        return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+    }
+
+    // • Paeth-filter `row_count` rows, each preceded by its filter type byte
+    //
+    void filter_rows(const uint8_t* above, const uint8_t* rows, uint32_t row_count,
+                     size_t row_size, std::vector<uint8_t>& filtered)
+    {
+        constexpr auto bpp = size_t{ 6 };
+
+        filtered.resize( (row_size + 1) * row_count );
+
+        auto target = filtered.data();
+
+        for (uint32_t y = 0; y < row_count; ++y)
+        {
+            const auto row = rows + y * row_size;
+
+            *target++ = 4; // Paeth
+
+            for (size_t i = 0; i < row_size; ++i)
+            {
+                const auto a = (bpp <= i) ? row[i - bpp]   : uint8_t{ 0 };
+                const auto c = (bpp <= i) ? above[i - bpp] : uint8_t{ 0 };
+
+                *target++ = static_cast<uint8_t>( row[i] - paeth(a, above[i], c) );
+            }
+
+            above = row;
+        }
+    }
+
+    // • Raw deflate ending on a byte boundary (sync flush), or with the final
+    //   block of the stream. False if zlib fails
+    //
+    bool deflate_segment(const std::vector<uint8_t>& source, int32_t level, bool is_last,
+                         std::vector<uint8_t>& deflated)
+    {
+        z_stream stream = {};
+
+        if ( Z_OK != deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) )
+        {
+            deflated.clear();
+            return false;
+        }
+
+        deflated.resize( deflateBound(&stream, source.size()) + 16 );
+
+        stream.next_in   = const_cast<Bytef*>( source.data() );
+        stream.avail_in  = static_cast<uInt>( source.size() );
+        stream.next_out  = deflated.data();
+        stream.avail_out = static_cast<uInt>( deflated.size() );
+
+        const auto status = deflate(&stream, is_last ? Z_FINISH : Z_SYNC_FLUSH);
+
+        deflated.resize(stream.total_out);
+
+        deflateEnd(&stream);
+
+        // • Z_FINISH must end the stream; a sync flush reports Z_BUF_ERROR
+        //   when it had nothing further to do
+        //
+        return is_last ? Z_STREAM_END == status
+                       : Z_OK == status || Z_BUF_ERROR == status;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+PNGEncoder::PNGEncoder(const char*            path,
+                       uint32_t               width,
+                       uint32_t               height,
+                       utilities::ThreadPool& pool,
+                       const Options&         options)
+    : ImageEncoder   ( path, width, height )
+    , pool_          ( pool )
+    , options_       ( options )
+    , batch_rows_    ( 0 )
+    , batch_capacity_( std::max(options.chunk_rows, 1u) * pool.concurrency() )
+    , chunks_        ( pool.concurrency() )
+    , adler_         ( static_cast<uint32_t>( adler32(0, nullptr, 0) ) )
+{
+    // • PNG has no empty images, and the zlib stream ends with the last row
+    //
+    if (0 == width || 0 == height)
+    {
+        file_.fail();
+        return;
+    }
+
+    batch_.assign( row_size() * (batch_capacity_ + 1), 0 );
+
+    constexpr uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+    file_.write( signature, sizeof(signature) );
+
+    // • IHDR: 16-bit truecolor
+    //
+    auto header = std::vector<uint8_t>{};
+
+    append_u32(header, width);
+    append_u32(header, height);
+    header.insert( header.end(), { 16, 2, 0, 0, 0 } );
+
+    write_chunk("IHDR", header.data(), header.size());
+
+    // • gAMA and cHRM: sRGB curve, D65 white and Display P3 primaries
+    //
+    auto gamma = std::vector<uint8_t>{};
+
+    append_u32(gamma, 45455);
+
+    write_chunk("gAMA", gamma.data(), gamma.size());
+
+    auto chromaticities = std::vector<uint8_t>{};
+
+    for (const auto value : { 31270u, 32900u, 68000u, 32000u, 26500u, 69000u, 15000u, 6000u })
+    {
+        append_u32(chromaticities, value);
+    }
+
+    write_chunk("cHRM", chromaticities.data(), chromaticities.size());
+
+    // • zlib stream header (32K window, default compression)
+    //
+    constexpr uint8_t zlib_header[] = { 0x78, 0x9c };
+
+    write_chunk("IDAT", zlib_header, sizeof(zlib_header));
+}
+
+//===------------------------------------------------------------------------===
+// • Encoding
+//===------------------------------------------------------------------------===
+
+bool PNGEncoder::encode_rows(uint32_t top, data::ImageView<simd::float4> strip)
+{
+    for (uint32_t y = 0; y < strip.height; ++y)
+    {
+        const auto source = strip.row(y);
+        auto       target = batch_.data() + (batch_rows_ + 1) * row_size();
+
+        for (uint32_t x = 0; x < strip.width; ++x)
+        {
+            for (auto ic = 0; ic < 3; ++ic)
+            {
+                const auto sample = encode_sample(source[x][ic]);
+
+                *target++ = static_cast<uint8_t>(sample >> 8);
+                *target++ = static_cast<uint8_t>(sample);
+            }
+        }
+
+        const auto is_last = top + y + 1 == height();
+
+        if ( ++batch_rows_ == batch_capacity_ || is_last )
+        {
+            if ( !encode_batch(is_last) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return is_good();
+}
+
+bool PNGEncoder::encode_batch(bool is_last)
+{
+    const auto chunk_rows  = std::max(options_.chunk_rows, 1u);
+    const auto chunk_count = (batch_rows_ + chunk_rows - 1) / chunk_rows;
+
+    pool_.parallel_for( chunk_count, [&](uint32_t ic) {
+
+        auto&      chunk     = chunks_[ic];
+        const auto first_row = ic * chunk_rows;
+        const auto row_count = std::min(chunk_rows, batch_rows_ - first_row);
+        const auto above     = batch_.data() + first_row * row_size();
+
+        filter_rows(above, above + row_size(), row_count, row_size(), chunk.filtered);
+
+        chunk.is_deflated = deflate_segment( chunk.filtered, options_.compression_level,
+                                             is_last && ic + 1 == chunk_count, chunk.deflated );
+
+        chunk.adler = static_cast<uint32_t>( adler32(adler32(0, nullptr, 0), chunk.filtered.data(),
+                                                     static_cast<uInt>( chunk.filtered.size() )) );
+    });
+
+    for (uint32_t ic = 0; ic < chunk_count; ++ic)
+    {
+        const auto& chunk = chunks_[ic];
+
+        if (!chunk.is_deflated)
+        {
+            file_.fail();
+            return false;
+        }
+
+        adler_ = static_cast<uint32_t>( adler32_combine(adler_, chunk.adler,
+                                                        static_cast<z_off_t>( chunk.filtered.size() )) );
+
+        write_chunk("IDAT", chunk.deflated.data(), chunk.deflated.size());
+    }
+
+    // • The last row becomes the row above the next batch
+    //
+    std::copy_n( batch_.data() + batch_rows_ * row_size(), row_size(), batch_.data() );
+
+    batch_rows_ = 0;
+
+    return is_good();
+}
+
+bool PNGEncoder::encode_end(void)
+{
+    auto trailer = std::vector<uint8_t>{};
+
+    append_u32(trailer, adler_);
+
+    write_chunk("IDAT", trailer.data(), trailer.size());
+    write_chunk("IEND", nullptr, 0);
+
+    batch_  = {};
+    chunks_ = {};
+
+    return is_good();
+}
+
+bool PNGEncoder::write_chunk(const char type[4], const uint8_t* data, size_t size)
+{
+    auto header = std::vector<uint8_t>{};
+
+    append_u32(header, static_cast<uint32_t>(size));
+    header.insert(header.end(), type, type + 4);
+
+    auto crc = crc32(0, header.data() + 4, 4);
+
+    if (0 < size)
+    {
+        crc = crc32(crc, data, static_cast<uInt>(size));
+    }
+
+    auto trailer = std::vector<uint8_t>{};
+
+    append_u32(trailer, static_cast<uint32_t>(crc));
+
+    file_.write(header.data(), header.size());
+
+    if (0 < size)
+    {
+        file_.write(data, size);
+    }
+
+    return file_.write(trailer.data(), trailer.size());
+}
+
+} // namespace imaging
@@ -0,0 +1,104 @@
+//
+//  PNGEncoder.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Imaging/ImageEncoder.hpp>
+#include <Utilities/ThreadPool.hpp>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • PNGEncoder
+//
+//  16-bit RGB PNG in Display P3 (cHRM primaries, sRGB transfer curve; values
+//  are clipped to [0, 1]). Rows are gathered into batches of chunk_rows ×
+//  pool concurrency rows; the chunks of a batch are filtered and deflated in
+//  parallel as independent raw deflate segments ending on byte boundaries
+//  and concatenated into a single zlib stream, the checksum being combined
+//  from the per-chunk Adler-32 values. An empty image, or any zlib failure,
+//  fails the encoder.
+//
+//===------------------------------------------------------------------------===
+
+class PNGEncoder : public ImageEncoder
+{
+public:
+
+    struct Options
+    {
+        uint32_t    chunk_rows;         // rows per parallel deflate segment
+        int32_t     compression_level;  // zlib level, 0-9
+    };
+
+    static constexpr Options default_options = {
+        .chunk_rows        = 32,
+        .compression_level = 6
+    };
+
+    PNGEncoder(const char*            path,
+               uint32_t               width,
+               uint32_t               height,
+               utilities::ThreadPool& pool    = utilities::ThreadPool::shared(),
+               const Options&         options = default_options);
+
+protected:
+
+    bool encode_rows(uint32_t top, data::ImageView<simd::float4> strip) override;
+    bool encode_end(void) override;
+
+private:
+
+    struct Chunk
+    {
+        std::vector<uint8_t>    filtered;
+        std::vector<uint8_t>    deflated;
+        uint32_t                adler;
+        bool                    is_deflated;
+    };
+
+    bool encode_batch(bool is_last);
+    bool write_chunk(const char type[4], const uint8_t* data, size_t size);
+
+    size_t row_size(void) const noexcept
+    {
+        return static_cast<size_t>( width() ) * 6;
+    }
+
+    utilities::ThreadPool&  pool_;
+    const Options           options_;
+
+    // • Unfiltered big-endian samples of the pending batch, preceded by the
+    //   last row of the previous batch (zero above the first row)
+    //
+    std::vector<uint8_t>    batch_;
+    uint32_t                batch_rows_;
+    uint32_t                batch_capacity_;
+
+    std::vector<Chunk>      chunks_;
+    uint32_t                adler_;
+};
+
+} // namespace imaging
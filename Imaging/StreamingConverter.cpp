@@ -0,0 +1,224 @@
+//
+//  StreamingConverter.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/StreamingConverter.hpp>
+#include <Graphics/JzazbzBatch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double seconds_since(Clock::time_point start)
+    {
+        return std::chrono::duration<double>( Clock::now() - start ).count();
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+StreamingConverter::StreamingConverter(utilities::ThreadPool& pool, const Options& options)
+    : pool_   ( pool )
+    , options_( options )
+{
+    if (Conversion::jzazbz_tone_mapped_to_linear_display_P3 == options.conversion)
+    {
+        tone_mapper_ = std::make_unique<jzazbz::ToneMapper>(options.tone_map);
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Conversion
+//===------------------------------------------------------------------------===
+
+std::optional<ConversionStatistics> StreamingConverter::convert(const PFMReader&       input,
+                                                                ImageEncoder&          output,
+                                                                const ProgressHandler& progress)
+{
+    if ( !input.is_valid() || input.width() != output.width() || input.height() != output.height() )
+    {
+        return std::nullopt;
+    }
+
+    const auto width       = input.width();
+    const auto height      = input.height();
+    const auto strip_rows  = std::clamp(options_.strip_rows, 1u, height);
+    const auto strip_count = (height + strip_rows - 1) / strip_rows;
+    const auto strip_size  = static_cast<size_t>(width) * 3 * strip_rows;
+
+    const auto rows_in_strip = [&](uint32_t strip) {
+        return std::min(strip_rows, height - strip * strip_rows);
+    };
+
+    // • Double-buffered input and output strips
+    //
+    std::vector<float>       input_strips[2] = { std::vector<float>(strip_size), std::vector<float>(strip_size) };
+    data::Image<simd::float4> output_strips[2] = { { width, strip_rows }, { width, strip_rows } };
+
+    const auto read_strip = [&](uint32_t strip) {
+        return std::async( std::launch::async, [&input, &input_strips, strip, strip_rows, rows_in_strip] {
+            return input.read_rows( strip * strip_rows, rows_in_strip(strip), input_strips[strip % 2].data() );
+        });
+    };
+
+    auto statistics = ConversionStatistics{
+        .rows               = 0,
+        .total_rows         = height,
+        .bytes_read         = 0,
+        .elapsed_seconds    = 0.0,
+        .convert_seconds    = 0.0,
+        .read_wait_seconds  = 0.0,
+        .write_wait_seconds = 0.0
+    };
+
+    const auto start = Clock::now();
+
+    auto pending_read  = read_strip(0);
+    auto pending_write = std::future<bool>{};
+    auto succeeded     = true;
+
+    for (uint32_t strip = 0; strip < strip_count && succeeded; ++strip)
+    {
+        const auto row_count = rows_in_strip(strip);
+
+        // • Wait for this strip, then start reading the next one
+        //
+        auto wait_start = Clock::now();
+
+        succeeded = pending_read.get();
+
+        statistics.read_wait_seconds += seconds_since(wait_start);
+
+        if (!succeeded)
+        {
+            break;
+        }
+
+        if (strip + 1 < strip_count)
+        {
+            pending_read = read_strip(strip + 1);
+        }
+
+        // • Convert. The output buffer was last used by strip - 2, whose
+        //   write completed before strip - 1 was queued
+        //
+        const auto convert_start = Clock::now();
+        const auto strip_view    = output_strips[strip % 2].view().subview(
+                                        geometry::make_region_of_size({ width, row_count }) );
+
+        convert_strip(input_strips[strip % 2].data(), row_count, width, strip_view);
+
+        statistics.convert_seconds += seconds_since(convert_start);
+
+        // • Writes are serialized: wait for the previous strip, then queue this one
+        //
+        if ( pending_write.valid() )
+        {
+            wait_start = Clock::now();
+            succeeded  = pending_write.get();
+
+            statistics.write_wait_seconds += seconds_since(wait_start);
+        }
+
+        pending_write = std::async( std::launch::async, [&output, strip_view] {
+            return output.write_rows(strip_view);
+        });
+
+        statistics.rows            += row_count;
+        statistics.bytes_read      += row_count * input.row_size();
+        statistics.elapsed_seconds  = seconds_since(start);
+
+        if (progress)
+        {
+            progress(statistics);
+        }
+    }
+
+    // • Drain outstanding I/O before the buffers go away
+    //
+    if ( pending_read.valid() )
+    {
+        succeeded = pending_read.get() && succeeded;
+    }
+
+    if ( pending_write.valid() )
+    {
+        succeeded = pending_write.get() && succeeded;
+    }
+
+    succeeded = output.finish() && succeeded;
+
+    statistics.elapsed_seconds = seconds_since(start);
+
+    if (!succeeded)
+    {
+        return std::nullopt;
+    }
+
+    return statistics;
+}
+
+void StreamingConverter::convert_strip(float* pixels, uint32_t row_count, uint32_t width,
+                                       data::ImageView<simd::float4> output)
+{
+    const auto row_floats = static_cast<size_t>(width) * 3;
+
+    pool_.parallel_for( row_count, [&](uint32_t y) {
+
+        const auto row = pixels + y * row_floats;
+
+        switch (options_.conversion)
+        {
+            case Conversion::jzazbz_to_linear_display_P3:
+                jzazbz::convert_pixels_to_linear_display_P3(row, row, width);
+                break;
+
+            case Conversion::linear_display_P3_to_jzazbz:
+                jzazbz::convert_pixels_from_linear_display_P3(row, row, width);
+                break;
+
+            case Conversion::jzazbz_tone_mapped_to_linear_display_P3:
+                tone_mapper_->map_pixels_to_linear_display_P3(row, row, width);
+                break;
+        }
+
+        auto target = output.row(y);
+
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            target[x] = simd::float4{ row[3*x], row[3*x + 1], row[3*x + 2], 1.0f };
+        }
+    });
+}
+
+} // namespace imaging
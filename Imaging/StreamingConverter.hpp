@@ -0,0 +1,123 @@
+//
+//  StreamingConverter.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/ToneMapper.hpp>
+#include <Imaging/ImageEncoder.hpp>
+#include <Imaging/PFMReader.hpp>
+#include <Utilities/ThreadPool.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+//===------------------------------------------------------------------------===
+// • namespace imaging
+//===------------------------------------------------------------------------===
+
+namespace imaging
+{
+
+//===------------------------------------------------------------------------===
+//
+// • StreamingConverter (Host only)
+//
+//  Out-of-core Jzazbz conversion of float images larger than memory. The
+//  input is read one strip at a time, converted with the batch kernels on
+//  the pool and appended to an ImageEncoder. Reading of strip k + 1 and
+//  encoding of strip k - 1 run on their own threads while strip k converts,
+//  with two input and two output strip buffers, so memory use is four strips
+//  whatever the image size.
+//
+//===------------------------------------------------------------------------===
+
+enum class Conversion : uint32_t
+{
+    jzazbz_to_linear_display_P3,
+    linear_display_P3_to_jzazbz,
+    jzazbz_tone_mapped_to_linear_display_P3     // HDR Jzazbz to SDR, see ToneMapper
+};
+
+struct ConversionStatistics
+{
+    uint32_t    rows;               // rows converted so far
+    uint32_t    total_rows;
+    uint64_t    bytes_read;
+    double      elapsed_seconds;
+    double      convert_seconds;    // spent converting
+    double      read_wait_seconds;  // conversion stalled on input
+    double      write_wait_seconds; // conversion stalled on output
+
+    double megapixels_per_second(uint32_t width) const noexcept
+    {
+        return (0.0 < elapsed_seconds) ? 1.0e-6 * width * rows / elapsed_seconds : 0.0;
+    }
+
+    double read_megabytes_per_second(void) const noexcept
+    {
+        return (0.0 < elapsed_seconds) ? 1.0e-6 * bytes_read / elapsed_seconds : 0.0;
+    }
+};
+
+class StreamingConverter
+{
+public:
+
+    struct Options
+    {
+        Conversion                      conversion;
+        uint32_t                        strip_rows;
+        jzazbz::ToneMapper::Parameters  tone_map;   // tone-mapped conversion only
+    };
+
+    static constexpr Options default_options = {
+        .conversion = Conversion::jzazbz_to_linear_display_P3,
+        .strip_rows = 256,
+        .tone_map   = jzazbz::ToneMapper::default_parameters
+    };
+
+    // • Called on the converting thread after each strip
+    //
+    using ProgressHandler = std::function<void (const ConversionStatistics& statistics)>;
+
+    explicit StreamingConverter(utilities::ThreadPool& pool    = utilities::ThreadPool::shared(),
+                                const Options&         options = default_options);
+
+    // • Convert every row of `input` into `output`, which must have the same
+    //   size, then finish the output. Empty on read or write failure
+    //
+    std::optional<ConversionStatistics> convert(const PFMReader&       input,
+                                                ImageEncoder&          output,
+                                                const ProgressHandler& progress = nullptr);
+
+private:
+
+    void convert_strip(float* pixels, uint32_t row_count, uint32_t width,
+                       data::ImageView<simd::float4> output);
+
+    utilities::ThreadPool&                  pool_;
+    const Options                           options_;
+
+    // • Tables built once, for the tone-mapped conversion
+    //
+    std::unique_ptr<jzazbz::ToneMapper>     tone_mapper_;
+};
+
+} // namespace imaging
@@ -0,0 +1,399 @@
+//
+//  simd.h
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+//===------------------------------------------------------------------------===
+//
+// • Portable <simd/simd.h> (Host only, non-Apple platforms)
+//
+//  The part of Apple's simd vector and matrix library used by the host code,
+//  for builds without the Apple SDK (CMakeLists.txt adds this directory to
+//  the include path only there). Layout follows Apple's: 3- and 4-element
+//  vectors occupy and are aligned to 4 elements, 2-element vectors to 2.
+//  Comparisons yield masks with every bit set where true, as Apple's do.
+//  Element-wise loops are left to the compiler to vectorize.
+//
+//===------------------------------------------------------------------------===
+
+namespace simd
+{
+
+//===------------------------------------------------------------------------===
+// • Vectors
+//===------------------------------------------------------------------------===
+
+template <typename Scalar_, size_t Count_>
+struct Vector;
+
+template <typename Scalar_>
+struct alignas( 2 * sizeof(Scalar_) ) Vector<Scalar_, 2>
+{
+    union
+    {
+        struct { Scalar_ x, y; };
+        Scalar_ elements[2];
+    };
+
+    Vector(void) = default;
+
+    constexpr Vector(Scalar_ s) noexcept : elements{ s, s } { }
+    constexpr Vector(Scalar_ x_, Scalar_ y_) noexcept : elements{ x_, y_ } { }
+
+    constexpr Scalar_& operator [] (size_t i) noexcept { return elements[i]; }
+    constexpr const Scalar_& operator [] (size_t i) const noexcept { return elements[i]; }
+};
+
+template <typename Scalar_>
+struct alignas( 4 * sizeof(Scalar_) ) Vector<Scalar_, 3>
+{
+    union
+    {
+        struct { Scalar_ x, y, z; };
+        Scalar_ elements[3];
+    };
+
+    Vector(void) = default;
+
+    constexpr Vector(Scalar_ s) noexcept : elements{ s, s, s } { }
+    constexpr Vector(Scalar_ x_, Scalar_ y_, Scalar_ z_) noexcept : elements{ x_, y_, z_ } { }
+
+    constexpr Scalar_& operator [] (size_t i) noexcept { return elements[i]; }
+    constexpr const Scalar_& operator [] (size_t i) const noexcept { return elements[i]; }
+};
+
+template <typename Scalar_>
+struct alignas( 4 * sizeof(Scalar_) ) Vector<Scalar_, 4>
+{
+    union
+    {
+        struct { Scalar_ x, y, z, w; };
+        Scalar_ elements[4];
+        Vector<Scalar_, 3> xyz;
+    };
+
+    Vector(void) = default;
+
+    constexpr Vector(Scalar_ s) noexcept : elements{ s, s, s, s } { }
+    constexpr Vector(Scalar_ x_, Scalar_ y_, Scalar_ z_, Scalar_ w_) noexcept : elements{ x_, y_, z_, w_ } { }
+    constexpr Vector(Vector<Scalar_, 3> v, Scalar_ w_) noexcept : elements{ v.x, v.y, v.z, w_ } { }
+
+    constexpr Scalar_& operator [] (size_t i) noexcept { return elements[i]; }
+    constexpr const Scalar_& operator [] (size_t i) const noexcept { return elements[i]; }
+};
+
+using float2  = Vector<float, 2>;
+using float3  = Vector<float, 3>;
+using float4  = Vector<float, 4>;
+using double2 = Vector<double, 2>;
+using double3 = Vector<double, 3>;
+using double4 = Vector<double, 4>;
+using int2    = Vector<int32_t, 2>;
+using int3    = Vector<int32_t, 3>;
+using int4    = Vector<int32_t, 4>;
+using uint2   = Vector<uint32_t, 2>;
+using uint3   = Vector<uint32_t, 3>;
+using uint4   = Vector<uint32_t, 4>;
+using long2   = Vector<int64_t, 2>;
+using long3   = Vector<int64_t, 3>;
+using long4   = Vector<int64_t, 4>;
+
+// • Comparison result: a signed integer of the element's size per lane
+//
+template <typename Scalar_>
+using MaskScalar = std::conditional_t<8 == sizeof(Scalar_), int64_t, int32_t>;
+
+template <typename Scalar_, size_t Count_>
+using Mask = Vector<MaskScalar<Scalar_>, Count_>;
+
+//===------------------------------------------------------------------------===
+// • Operators
+//===------------------------------------------------------------------------===
+
+#define SIMD_PORTABLE_OPERATOR(op_)                                                                 \
+    template <typename Scalar_, size_t Count_>                                                      \
+    constexpr Vector<Scalar_, Count_> operator op_ (Vector<Scalar_, Count_> a,                      \
+                                                    Vector<Scalar_, Count_> b) noexcept             \
+    {                                                                                               \
+        auto result = Vector<Scalar_, Count_>{};                                                    \
+        for (size_t i = 0; i < Count_; ++i) result[i] = a[i] op_ b[i];                              \
+        return result;                                                                              \
+    }                                                                                               \
+                                                                                                    \
+    template <typename Scalar_, size_t Count_, typename Other_>                                     \
+        requires std::is_arithmetic_v<Other_>                                                       \
+    constexpr Vector<Scalar_, Count_> operator op_ (Vector<Scalar_, Count_> a, Other_ b) noexcept   \
+    {                                                                                               \
+        return a op_ Vector<Scalar_, Count_>( static_cast<Scalar_>(b) );                            \
+    }                                                                                               \
+                                                                                                    \
+    template <typename Scalar_, size_t Count_, typename Other_>                                     \
+        requires std::is_arithmetic_v<Other_>                                                       \
+    constexpr Vector<Scalar_, Count_> operator op_ (Other_ a, Vector<Scalar_, Count_> b) noexcept   \
+    {                                                                                               \
+        return Vector<Scalar_, Count_>( static_cast<Scalar_>(a) ) op_ b;                            \
+    }                                                                                               \
+                                                                                                    \
+    template <typename Scalar_, size_t Count_, typename Other_>                                     \
+    constexpr Vector<Scalar_, Count_>& operator op_##= (Vector<Scalar_, Count_>& a, Other_ b) noexcept \
+    {                                                                                               \
+        return a = a op_ b;                                                                         \
+    }
+
+SIMD_PORTABLE_OPERATOR(+)
+SIMD_PORTABLE_OPERATOR(-)
+SIMD_PORTABLE_OPERATOR(*)
+SIMD_PORTABLE_OPERATOR(/)
+
+#undef SIMD_PORTABLE_OPERATOR
+
+template <typename Scalar_, size_t Count_>
+constexpr Vector<Scalar_, Count_> operator - (Vector<Scalar_, Count_> a) noexcept
+{
+    auto result = Vector<Scalar_, Count_>{};
+    for (size_t i = 0; i < Count_; ++i) result[i] = -a[i];
+    return result;
+}
+
+#define SIMD_PORTABLE_COMPARISON(op_)                                                               \
+    template <typename Scalar_, size_t Count_>                                                      \
+    constexpr Mask<Scalar_, Count_> operator op_ (Vector<Scalar_, Count_> a,                        \
+                                                  Vector<Scalar_, Count_> b) noexcept               \
+    {                                                                                               \
+        auto result = Mask<Scalar_, Count_>{};                                                      \
+        for (size_t i = 0; i < Count_; ++i) result[i] = (a[i] op_ b[i]) ? -1 : 0;                  \
+        return result;                                                                              \
+    }
+
+SIMD_PORTABLE_COMPARISON(==)
+SIMD_PORTABLE_COMPARISON(!=)
+SIMD_PORTABLE_COMPARISON(<)
+SIMD_PORTABLE_COMPARISON(<=)
+SIMD_PORTABLE_COMPARISON(>)
+SIMD_PORTABLE_COMPARISON(>=)
+
+#undef SIMD_PORTABLE_COMPARISON
+
+//===------------------------------------------------------------------------===
+// • Functions
+//===------------------------------------------------------------------------===
+
+template <typename Scalar_, size_t Count_>
+constexpr bool all(Vector<Scalar_, Count_> mask) noexcept
+{
+    for (size_t i = 0; i < Count_; ++i) if (0 == mask[i]) return false;
+    return true;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr bool any(Vector<Scalar_, Count_> mask) noexcept
+{
+    for (size_t i = 0; i < Count_; ++i) if (0 != mask[i]) return true;
+    return false;
+}
+
+#define SIMD_PORTABLE_UNARY(name_, expression_)                                                     \
+    template <typename Scalar_, size_t Count_>                                                      \
+    inline Vector<Scalar_, Count_> name_(Vector<Scalar_, Count_> a) noexcept                        \
+    {                                                                                               \
+        auto result = Vector<Scalar_, Count_>{};                                                    \
+        for (size_t i = 0; i < Count_; ++i) { const auto x = a[i]; result[i] = (expression_); }     \
+        return result;                                                                              \
+    }
+
+SIMD_PORTABLE_UNARY(abs,   std::abs(x))
+SIMD_PORTABLE_UNARY(floor, std::floor(x))
+SIMD_PORTABLE_UNARY(ceil,  std::ceil(x))
+SIMD_PORTABLE_UNARY(sqrt,  std::sqrt(x))
+
+#undef SIMD_PORTABLE_UNARY
+
+template <typename Scalar_, size_t Count_>
+constexpr Vector<Scalar_, Count_> min(Vector<Scalar_, Count_> a, Vector<Scalar_, Count_> b) noexcept
+{
+    auto result = Vector<Scalar_, Count_>{};
+    for (size_t i = 0; i < Count_; ++i) result[i] = (b[i] < a[i]) ? b[i] : a[i];
+    return result;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Vector<Scalar_, Count_> max(Vector<Scalar_, Count_> a, Vector<Scalar_, Count_> b) noexcept
+{
+    auto result = Vector<Scalar_, Count_>{};
+    for (size_t i = 0; i < Count_; ++i) result[i] = (a[i] < b[i]) ? b[i] : a[i];
+    return result;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Vector<Scalar_, Count_> clamp(Vector<Scalar_, Count_> x,
+                                        Vector<Scalar_, Count_> low,
+                                        Vector<Scalar_, Count_> high) noexcept
+{
+    return min( max(x, low), high );
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Vector<Scalar_, Count_> mix(Vector<Scalar_, Count_> a,
+                                      Vector<Scalar_, Count_> b,
+                                      Vector<Scalar_, Count_> t) noexcept
+{
+    return a + t * (b - a);
+}
+
+template <typename Scalar_, size_t Count_>
+inline Vector<Scalar_, Count_> pow(Vector<Scalar_, Count_> a, Vector<Scalar_, Count_> b) noexcept
+{
+    auto result = Vector<Scalar_, Count_>{};
+    for (size_t i = 0; i < Count_; ++i) result[i] = std::pow(a[i], b[i]);
+    return result;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Scalar_ dot(Vector<Scalar_, Count_> a, Vector<Scalar_, Count_> b) noexcept
+{
+    auto sum = Scalar_{ 0 };
+    for (size_t i = 0; i < Count_; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Scalar_ length_squared(Vector<Scalar_, Count_> a) noexcept
+{
+    return dot(a, a);
+}
+
+template <typename Scalar_, size_t Count_>
+inline Scalar_ length(Vector<Scalar_, Count_> a) noexcept
+{
+    return std::sqrt( dot(a, a) );
+}
+
+template <typename Scalar_, size_t Count_>
+inline Scalar_ distance(Vector<Scalar_, Count_> a, Vector<Scalar_, Count_> b) noexcept
+{
+    return length(a - b);
+}
+
+template <typename Scalar_, size_t Count_>
+inline Vector<Scalar_, Count_> normalize(Vector<Scalar_, Count_> a) noexcept
+{
+    return a / length(a);
+}
+
+template <typename Scalar_>
+constexpr Vector<Scalar_, 3> cross(Vector<Scalar_, 3> a, Vector<Scalar_, 3> b) noexcept
+{
+    return { a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z, a.x*b.y - a.y*b.x };
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Scalar_ reduce_add(Vector<Scalar_, Count_> a) noexcept
+{
+    auto sum = Scalar_{ 0 };
+    for (size_t i = 0; i < Count_; ++i) sum += a[i];
+    return sum;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Scalar_ reduce_min(Vector<Scalar_, Count_> a) noexcept
+{
+    auto result = a[0];
+    for (size_t i = 1; i < Count_; ++i) result = (a[i] < result) ? a[i] : result;
+    return result;
+}
+
+template <typename Scalar_, size_t Count_>
+constexpr Scalar_ reduce_max(Vector<Scalar_, Count_> a) noexcept
+{
+    auto result = a[0];
+    for (size_t i = 1; i < Count_; ++i) result = (result < a[i]) ? a[i] : result;
+    return result;
+}
+
+//===------------------------------------------------------------------------===
+// • 3×3 matrices (column-major)
+//===------------------------------------------------------------------------===
+
+template <typename Scalar_>
+struct Matrix3
+{
+    Vector<Scalar_, 3> columns[3];
+
+    Matrix3(void) = default;
+
+    constexpr Matrix3(Vector<Scalar_, 3> c0, Vector<Scalar_, 3> c1, Vector<Scalar_, 3> c2) noexcept
+        : columns{ c0, c1, c2 }
+    {
+    }
+
+    // • Diagonal
+    //
+    constexpr explicit Matrix3(Scalar_ d) noexcept
+        : columns{ { d, 0, 0 }, { 0, d, 0 }, { 0, 0, d } }
+    {
+    }
+
+    constexpr Vector<Scalar_, 3>& operator [] (size_t i) noexcept { return columns[i]; }
+    constexpr const Vector<Scalar_, 3>& operator [] (size_t i) const noexcept { return columns[i]; }
+};
+
+using float3x3  = Matrix3<float>;
+using double3x3 = Matrix3<double>;
+
+template <typename Scalar_>
+constexpr Vector<Scalar_, 3> operator * (const Matrix3<Scalar_>& m, Vector<Scalar_, 3> v) noexcept
+{
+    return m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z;
+}
+
+template <typename Scalar_>
+constexpr Matrix3<Scalar_> operator * (const Matrix3<Scalar_>& a, const Matrix3<Scalar_>& b) noexcept
+{
+    return { a * b.columns[0], a * b.columns[1], a * b.columns[2] };
+}
+
+template <typename Scalar_>
+constexpr Matrix3<Scalar_> transpose(const Matrix3<Scalar_>& m) noexcept
+{
+    return {
+        { m.columns[0].x, m.columns[1].x, m.columns[2].x },
+        { m.columns[0].y, m.columns[1].y, m.columns[2].y },
+        { m.columns[0].z, m.columns[1].z, m.columns[2].z }
+    };
+}
+
+// • Adjugate over determinant
+//
+template <typename Scalar_>
+constexpr Matrix3<Scalar_> inverse(const Matrix3<Scalar_>& m) noexcept
+{
+    const auto r0  = cross(m.columns[1], m.columns[2]);
+    const auto r1  = cross(m.columns[2], m.columns[0]);
+    const auto r2  = cross(m.columns[0], m.columns[1]);
+    const auto det = dot(m.columns[0], r0);
+
+    return transpose( Matrix3<Scalar_>{ r0 / det, r1 / det, r2 / det } );
+}
+
+} // namespace simd
@@ -0,0 +1,223 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Data/FrameRing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • frame-ring-stress
+//
+//  One producer and several consumers hammering data::FrameRing:
+//
+//      frame-ring-stress [--frames N] [--consumers N]
+//
+//  Consumers check that every frame they hold is whole (no torn writes) and
+//  that sequences never go backwards. The producer fails if it cannot claim a
+//  slot for a second while consumers keep releasing theirs. At the end every
+//  slot must be claimable again. Exits non-zero on any failure.
+//
+//  Built and run by CMakeLists.txt (ctest), or from the project root, e.g.
+//
+//      clang++ -std=gnu++20 -O2 -I. -o frame-ring-stress
+//          Tools/FrameRingStress/main.cpp
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    struct Frame
+    {
+        uint64_t    value;
+        uint64_t    check;      // ~value
+        uint64_t    padding[6];
+    };
+
+    constexpr auto stall_limit = std::chrono::seconds(1);
+
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: frame-ring-stress [--frames N] [--consumers N]\n");
+    }
+
+    // • Hammer a ring of `Count_` slots; true when it held up
+    //
+    template <uint32_t Count_>
+    bool stress(uint64_t frame_count, uint32_t consumer_count)
+    {
+        using Ring = data::FrameRing<Frame, Count_>;
+
+        auto ring      = Ring{ Frame{ .value = 0, .check = ~uint64_t{ 0 }, .padding = {} } };
+        auto is_done   = std::atomic<bool>{ false };
+        auto failures  = std::atomic<uint64_t>{ 0 };
+        auto acquired  = std::atomic<uint64_t>{ 0 };
+        auto consumers = std::vector<std::thread>{};
+
+        for (uint32_t ic = 0; ic < consumer_count; ++ic)
+        {
+            consumers.emplace_back( [&] {
+
+                auto last_sequence = uint64_t{ 0 };
+
+                while ( !is_done.load(std::memory_order_acquire) )
+                {
+                    const auto token = ring.acquire();
+
+                    if (token.data->check != ~token.data->value || token.sequence < last_sequence)
+                    {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    last_sequence = token.sequence;
+
+                    acquired.fetch_add(1, std::memory_order_relaxed);
+
+                    // • Hold the frame across a reschedule now and then
+                    //
+                    if (0 == token.sequence % 5)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    ring.release(token);
+                }
+            });
+        }
+
+        auto stalled = false;
+
+        for (uint64_t frame = 1; frame <= frame_count && !stalled; ++frame)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            auto value = ring.begin_write();
+
+            while (nullptr == value)
+            {
+                if (stall_limit < std::chrono::steady_clock::now() - start)
+                {
+                    stalled = true;
+                    break;
+                }
+
+                std::this_thread::yield();
+
+                value = ring.begin_write();
+            }
+
+            if (nullptr != value)
+            {
+                value->value = frame;
+                value->check = ~frame;
+
+                // • Exercise both the publish and the cancel path
+                //
+                if (0 == frame % 3)
+                {
+                    ring.cancel_write();
+                }
+                else
+                {
+                    ring.publish();
+                }
+            }
+        }
+
+        is_done.store(true, std::memory_order_release);
+
+        for (auto& consumer : consumers)
+        {
+            consumer.join();
+        }
+
+        // • With no consumer left, every slot but the latest must be claimable
+        //   in turn
+        //
+        auto is_reclaimable = true;
+
+        for (uint32_t is = 0; is < 2 * Count_; ++is)
+        {
+            if (nullptr == ring.begin_write())
+            {
+                is_reclaimable = false;
+                break;
+            }
+
+            ring.publish();
+        }
+
+        printf("%u slots: %llu published, %llu acquisitions, %llu torn or out of order%s%s\n",
+               Count_, static_cast<unsigned long long>( ring.latest_sequence() ),
+               static_cast<unsigned long long>( acquired.load() ),
+               static_cast<unsigned long long>( failures.load() ),
+               stalled ? ", producer stalled" : "",
+               is_reclaimable ? "" : ", slots not reclaimable");
+
+        return 0 == failures.load() && !stalled && is_reclaimable;
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto frame_count    = uint64_t{ 1'000'000 };
+    auto consumer_count = uint32_t{ 4 };
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--frames"))
+        {
+            frame_count = strtoull(value, nullptr, 10);
+        }
+        else if (0 == strcmp(option, "--consumers"))
+        {
+            consumer_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    // • Two slots is where a stuck slot stops the producer for good
+    //
+    const auto is_passed = stress<2>(frame_count, consumer_count)
+                         & stress<3>(frame_count, consumer_count);
+
+    return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/GoldenReference.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+//
+// • golden-reference
+//
+//  Command-line front end of validation::evaluate_golden_reference:
+//
+//      golden-reference [--grid N] [--hues N] [--bands N]
+//
+//  Prints one line per kernel and exits non-zero when any kernel exceeds its
+//  bound, so it can gate a build or a CI job.
+//
+//  Built and run by CMakeLists.txt (ctest), or from the project root, e.g.
+//
+//      clang++ -std=gnu++20 -O3 -I. -o golden-reference
+//          Tools/GoldenReference/main.cpp Validation/GoldenReference.cpp
+//          Graphics/Jzazbz.cpp Graphics/JzazbzBatch.cpp
+//          Graphics/GamutSlice.cpp Graphics/HueGradient.cpp
+//          Utilities/Instrumentation.cpp
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: golden-reference [--grid N] [--hues N] [--bands N]\n");
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto parameters = validation::default_golden_parameters;
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--grid"))
+        {
+            parameters.grid_size = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--hues"))
+        {
+            parameters.hue_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--bands"))
+        {
+            parameters.band_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    if (parameters.grid_size < 2 || 0 == parameters.hue_count || 0 == parameters.band_count)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto start   = std::chrono::steady_clock::now();
+    const auto errors  = validation::evaluate_golden_reference(parameters);
+    const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    printf("%s", validation::format_error_report(errors).c_str());
+    fprintf(stderr, "evaluated in %.2f s\n", seconds);
+
+    if ( !validation::all_passed(errors) )
+    {
+        fprintf(stderr, "golden-reference: error bounds exceeded\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
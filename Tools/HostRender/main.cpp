@@ -0,0 +1,184 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Composition/HostRenderer.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Imaging/EXREncoder.hpp>
+#include <Imaging/PFMEncoder.hpp>
+#include <Imaging/PNGEncoder.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+//===------------------------------------------------------------------------===
+//
+// • host-render
+//
+//  Command-line front end of HostRenderer, for machines without a GPU:
+//
+//      host-render [--hue DEGREES] [--width N] [--height N] OUTPUT.png|.pfm|.exr
+//
+//  Renders the composition of the app window (30 × 33 grid) at the hue,
+//  strip by strip straight into the encoder chosen by the output suffix.
+//
+//  Built by CMakeLists.txt, or from the project root, e.g.
+//
+//      clang++ -std=gnu++20 -O3 -I. -o host-render Tools/HostRender/main.cpp
+//          Composition/HostRenderer.cpp Graphics/*.cpp Imaging/*.cpp
+//          Data/Arena.cpp Utilities/*.cpp -lz
+//
+//  (add -IPortable off Apple platforms)
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: host-render [--hue DEGREES] [--width N] [--height N] OUTPUT.png|.pfm|.exr\n");
+    }
+
+    bool has_suffix(const char* text, const char* suffix)
+    {
+        const auto length        = strlen(text);
+        const auto suffix_length = strlen(suffix);
+
+        return suffix_length <= length && 0 == strcmp(text + length - suffix_length, suffix);
+    }
+
+    std::unique_ptr<imaging::ImageEncoder> make_encoder(const char* path, uint32_t width, uint32_t height)
+    {
+        if ( has_suffix(path, ".png") )
+        {
+            return std::make_unique<imaging::PNGEncoder>(path, width, height);
+        }
+
+        if ( has_suffix(path, ".pfm") )
+        {
+            return std::make_unique<imaging::PFMEncoder>(path, width, height);
+        }
+
+        if ( has_suffix(path, ".exr") )
+        {
+            return std::make_unique<imaging::EXREncoder>(path, width, height);
+        }
+
+        return nullptr;
+    }
+
+    // • As Composition's initial buffer
+    //
+    CompositionData make_composition(float hue)
+    {
+        return {
+            .grid_size       = { 30, 33 },
+            .jc_region       = { .left =  1, .top =  1, .right = 29, .bottom = 29 },
+            .gradient_region = { .left =  1, .top = 30, .right = 26, .bottom = 32 },
+            .max_c_region    = { .left = 27, .top = 30, .right = 29, .bottom = 32 },
+            .hue             = hue,
+            .max_c_color     = jzazbz::find_max_chroma_color(hue)
+        };
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto hue    = 42.794290425520614f;  // 01 Red
+    auto size   = simd::uint2{ 600, 660 };
+    auto output = static_cast<const char*>(nullptr);
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (0 == strncmp(option, "--", 2) && nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--hue"))
+        {
+            hue = strtof(value, nullptr);
+        }
+        else if (0 == strcmp(option, "--width"))
+        {
+            size.x = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--height"))
+        {
+            size.y = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 != strncmp(option, "--", 2) && nullptr == output)
+        {
+            output = option;
+            continue;
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    if (nullptr == output || 0 == size.x || 0 == size.y)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto encoder = make_encoder(output, size.x, size.y);
+
+    if (nullptr == encoder)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto reduced = fmodf(hue, 360.0f);
+    const auto start   = std::chrono::steady_clock::now();
+
+    auto renderer   = HostRenderer{};
+    auto is_written = encoder->is_good();
+
+    renderer.render_strips( make_composition( (reduced < 0.0f) ? reduced + 360.0f : reduced ), size,
+                            [&](uint32_t, data::ImageView<simd::float4> strip) {
+
+        is_written = is_written && encoder->write_rows(strip);
+    });
+
+    if ( !encoder->finish() || !is_written )
+    {
+        fprintf(stderr, "host-render: failed to write %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    fprintf(stderr, "%u × %u in %.3f s\n", size.x, size.y, seconds);
+
+    return EXIT_SUCCESS;
+}
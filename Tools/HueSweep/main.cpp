@@ -0,0 +1,178 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/OutputFile.hpp>
+#include <Validation/HueSweepAnalysis.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+//===------------------------------------------------------------------------===
+//
+// • hue-sweep
+//
+//  Command-line front end of validation::run_hue_sweep:
+//
+//      hue-sweep [--count N] [--first DEGREES] [--bands N] [--lanes N]
+//                [--accuracy A] [--format csv|binary] OUTPUT
+//
+//  Built and run by CMakeLists.txt (ctest), or from the project root with the
+//  Graphics, Imaging, Utilities and Validation sources it uses, e.g.
+//
+//      clang++ -std=gnu++20 -O3 -I. -o hue-sweep Tools/HueSweep/main.cpp
+//          Validation/HueSweepAnalysis.cpp Graphics/Jzazbz.cpp
+//          Graphics/GamutSlice.cpp Imaging/OutputFile.cpp
+//          Utilities/ThreadPool.cpp Utilities/Instrumentation.cpp
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: hue-sweep [--count N] [--first DEGREES] [--bands N] [--lanes N]\n"
+                        "                 [--accuracy A] [--format csv|binary] OUTPUT\n");
+    }
+
+    bool write_sweep(imaging::OutputFile& file, const validation::HueSweepParameters& parameters, bool is_binary)
+    {
+        if (is_binary)
+        {
+            const auto header = validation::make_hue_sweep_file_header(parameters);
+
+            file.write( &header, sizeof(header) );
+        }
+        else
+        {
+            file.write( validation::hue_sweep_csv_header, strlen(validation::hue_sweep_csv_header) );
+        }
+
+        auto text = std::string{};
+
+        validation::run_hue_sweep( parameters, [&](uint32_t, const validation::HueSweepRecord* records, uint32_t count) {
+
+            if (is_binary)
+            {
+                file.write( records, count * sizeof(validation::HueSweepRecord) );
+            }
+            else
+            {
+                text.clear();
+
+                validation::append_hue_sweep_csv(text, records, count);
+
+                file.write( text.data(), text.size() );
+            }
+        });
+
+        return file.close();
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto parameters = validation::default_hue_sweep_parameters;
+    auto is_binary  = false;
+    auto output     = static_cast<const char*>(nullptr);
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (0 == strncmp(option, "--", 2) && nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--count"))
+        {
+            parameters.hue_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--first"))
+        {
+            parameters.first_hue = strtof(value, nullptr);
+        }
+        else if (0 == strcmp(option, "--bands"))
+        {
+            parameters.band_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--lanes"))
+        {
+            parameters.lane_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--accuracy"))
+        {
+            parameters.accuracy = strtof(value, nullptr);
+        }
+        else if (0 == strcmp(option, "--format"))
+        {
+            is_binary = (0 == strcmp(value, "binary"));
+
+            if ( !is_binary && 0 != strcmp(value, "csv") )
+            {
+                print_usage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (0 != strncmp(option, "--", 2) && nullptr == output)
+        {
+            output = option;
+            continue;
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    // • One lane cannot subdivide a bracket; the search would never narrow
+    //
+    if (nullptr == output || 0 == parameters.hue_count || parameters.lane_count < 2
+        || !(0.0f < parameters.accuracy))
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto file = imaging::OutputFile{ output };
+
+    if ( !write_sweep(file, parameters, is_binary) )
+    {
+        fprintf(stderr, "hue-sweep: failed to write %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    fprintf(stderr, "%u hues in %.2f s (%.0f hues/s)\n", parameters.hue_count, seconds,
+            parameters.hue_count / seconds);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Imaging/LUTExport.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//===------------------------------------------------------------------------===
+//
+// • lut-export
+//
+//  Command-line front end of imaging::sample_lut:
+//
+//      lut-export [--size N] [--peak CD_M2] [--transform NAME] OUTPUT.cube
+//      lut-export [--size N] [--peak CD_M2] OUTPUT.icc
+//
+//  NAME is to-p3 (default), tone-mapped-to-p3 or from-p3. An .icc output is
+//  the ColorSpace profile with the tone-mapped A2B0 and its B2A0.
+//
+//  Built and run by CMakeLists.txt (ctest), or from the project root, e.g.
+//
+//      clang++ -std=gnu++20 -O3 -I. -o lut-export Tools/LUTExport/main.cpp
+//          Imaging/LUTExport.cpp Imaging/OutputFile.cpp
+//          Graphics/ChromaticAdaptation.cpp Graphics/ToneMapper.cpp
+//          Graphics/Jzazbz.cpp Utilities/ThreadPool.cpp
+//          Utilities/Instrumentation.cpp
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: lut-export [--size N] [--peak CD_M2]\n"
+                        "                  [--transform to-p3|tone-mapped-to-p3|from-p3] OUTPUT.cube|OUTPUT.icc\n");
+    }
+
+    bool has_suffix(const char* text, const char* suffix)
+    {
+        const auto length        = strlen(text);
+        const auto suffix_length = strlen(suffix);
+
+        return suffix_length <= length && 0 == strcmp(text + length - suffix_length, suffix);
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto parameters = imaging::default_lut_parameters;
+    auto transform  = imaging::LUTTransform::jzazbz_to_linear_display_P3;
+    auto output     = static_cast<const char*>(nullptr);
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (0 == strncmp(option, "--", 2) && nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--size"))
+        {
+            parameters.grid_size = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--peak"))
+        {
+            parameters.tone_map.source_peak = strtof(value, nullptr);
+        }
+        else if (0 == strcmp(option, "--transform"))
+        {
+            if (0 == strcmp(value, "to-p3"))
+            {
+                transform = imaging::LUTTransform::jzazbz_to_linear_display_P3;
+            }
+            else if (0 == strcmp(value, "tone-mapped-to-p3"))
+            {
+                transform = imaging::LUTTransform::jzazbz_tone_mapped_to_linear_display_P3;
+            }
+            else if (0 == strcmp(value, "from-p3"))
+            {
+                transform = imaging::LUTTransform::linear_display_P3_to_jzazbz;
+            }
+            else
+            {
+                print_usage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (0 != strncmp(option, "--", 2) && nullptr == output)
+        {
+            output = option;
+            continue;
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    if (nullptr == output || parameters.grid_size < 2 || 255 < parameters.grid_size)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto start  = std::chrono::steady_clock::now();
+    const auto is_icc = has_suffix(output, ".icc") || has_suffix(output, ".icm");
+
+    auto is_written = false;
+
+    if (is_icc)
+    {
+        const auto a_to_b = imaging::sample_lut(imaging::LUTTransform::jzazbz_tone_mapped_to_PCS_XYZ, parameters);
+        const auto b_to_a = imaging::sample_lut(imaging::LUTTransform::PCS_XYZ_to_jzazbz, parameters);
+
+        is_written = imaging::write_icc_profile(output, a_to_b, b_to_a, "Jzazbz (encoded)");
+    }
+    else
+    {
+        is_written = imaging::write_cube_lut( output, imaging::sample_lut(transform, parameters), "Jzazbz" );
+    }
+
+    if ( !is_written )
+    {
+        fprintf(stderr, "lut-export: failed to write %s\n", output);
+        return EXIT_FAILURE;
+    }
+
+    const auto seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    fprintf(stderr, "%u³ grid in %.2f s\n", parameters.grid_size, seconds);
+
+    return EXIT_SUCCESS;
+}
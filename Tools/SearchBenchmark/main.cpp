@@ -0,0 +1,131 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/SearchBenchmark.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • search-benchmark
+//
+//  Command-line front end of validation::benchmark_search_accuracy:
+//
+//      search-benchmark [--hues N] [--bands N] [--lanes N] [--repeats N]
+//                       [ACCURACY ...]
+//
+//  Prints, per target accuracy (default 1e-2 down to 1e-8), the iteration
+//  count, time over all hues and error against the reference of the slice
+//  and max-chroma searches.
+//
+//  Built by CMakeLists.txt, or from the project root, e.g.
+//
+//      clang++ -std=gnu++20 -O3 -I. -o search-benchmark
+//          Tools/SearchBenchmark/main.cpp Validation/SearchBenchmark.cpp
+//          Graphics/GamutSlice.cpp Graphics/HueGradient.cpp
+//          Graphics/Jzazbz.cpp Utilities/Instrumentation.cpp
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: search-benchmark [--hues N] [--bands N] [--lanes N] [--repeats N] [ACCURACY ...]\n");
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto parameters = validation::default_search_benchmark_parameters;
+    auto accuracies = std::vector<float>{};
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (0 == strncmp(option, "--", 2) && nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--hues"))
+        {
+            parameters.hue_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--bands"))
+        {
+            parameters.band_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--lanes"))
+        {
+            parameters.lane_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--repeats"))
+        {
+            parameters.repeat_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 != strncmp(option, "--", 2) && 0.0f < strtof(option, nullptr))
+        {
+            accuracies.push_back( strtof(option, nullptr) );
+            continue;
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    if (0 == parameters.hue_count || 0 == parameters.band_count || parameters.lane_count < 2
+        || 0 == parameters.repeat_count)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    if ( accuracies.empty() )
+    {
+        accuracies = { 1.0e-2f, 1.0e-3f, 1.0e-4f, 1.0e-5f, 1.0e-6f, 1.0e-7f, 1.0e-8f };
+    }
+
+    const auto results = validation::benchmark_search_accuracy(accuracies, parameters);
+
+    printf("%u hues, %u bands, %u lanes, reference at %.0e\n",
+           parameters.hue_count, parameters.band_count, parameters.lane_count, parameters.reference_accuracy);
+    printf("accuracy    slice iter    slice ms   slice error    max C iter    max C ms   max C error\n");
+
+    for (const auto& result : results)
+    {
+        printf("%8.0e  %12u  %10.3f  %12.3e  %12u  %10.3f  %12.3e\n",
+               result.accuracy,
+               result.slice_iteration_count, 1.0e3 * result.slice_seconds, result.slice_error,
+               result.max_chroma_iteration_count, 1.0e3 * result.max_chroma_seconds, result.max_chroma_error);
+    }
+
+    return EXIT_SUCCESS;
+}
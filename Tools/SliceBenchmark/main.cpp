@@ -0,0 +1,127 @@
+//
+//  main.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/SliceBenchmark.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+//
+// • slice-benchmark
+//
+//  Command-line front end of validation::benchmark_slice_bands:
+//
+//      slice-benchmark [--hues N] [--reference-bands N] [--max-bands N]
+//
+//  Prints vertex count, error and time of uniform slices at 8 to 128 bands
+//  and of adaptive slices at error budgets of 1e-3 down to 1e-5, so that the
+//  two can be compared at equal vertex count.
+//
+//  Built and run by CMakeLists.txt (ctest), or from the project root, e.g.
+//
+//      clang++ -std=gnu++20 -O3 -I. -o slice-benchmark
+//          Tools/SliceBenchmark/main.cpp Validation/SliceBenchmark.cpp
+//          Graphics/GamutSlice.cpp Graphics/Jzazbz.cpp
+//          Utilities/Instrumentation.cpp
+//
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    void print_usage(void)
+    {
+        fprintf(stderr, "usage: slice-benchmark [--hues N] [--reference-bands N] [--max-bands N]\n");
+    }
+
+} // namespace <anonymous>
+
+int main(int argc, const char* argv[])
+{
+    auto parameters = validation::default_slice_benchmark_parameters;
+
+    for (int ia = 1; ia < argc; ++ia)
+    {
+        const auto option = argv[ia];
+        const auto value  = (ia + 1 < argc) ? argv[ia + 1] : nullptr;
+
+        if (nullptr == value)
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        if (0 == strcmp(option, "--hues"))
+        {
+            parameters.hue_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--reference-bands"))
+        {
+            parameters.reference_band_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else if (0 == strcmp(option, "--max-bands"))
+        {
+            parameters.max_band_count = static_cast<uint32_t>( strtoul(value, nullptr, 10) );
+        }
+        else
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        ++ia;
+    }
+
+    if (0 == parameters.hue_count || 0 == parameters.reference_band_count
+        || parameters.max_band_count < parameters.initial_band_count)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    const auto band_counts   = std::vector<uint32_t>{ 8, 16, 32, 64, 128 };
+    const auto error_budgets = std::vector<float>{ 1.0e-3f, 3.0e-4f, 1.0e-4f, 5.0e-5f, 2.0e-5f, 1.0e-5f };
+
+    const auto results = validation::benchmark_slice_bands(band_counts, error_budgets, parameters);
+
+    printf("%u hues, reference of %u uniform bands, adaptive from %u up to %u bands\n",
+           parameters.hue_count, parameters.reference_band_count,
+           parameters.initial_band_count, parameters.max_band_count);
+    printf("bands     budget   mean vertices   max vertices    mean error     max error          ms\n");
+
+    for (const auto& result : results)
+    {
+        if (result.is_adaptive)
+        {
+            printf("adaptive  %6.0e", result.error_budget);
+        }
+        else
+        {
+            printf("%8u  %6s", result.band_count, "-");
+        }
+
+        printf("  %14.1f  %13u  %12.3e  %12.3e  %10.3f\n",
+               result.mean_vertex_count, result.max_vertex_count,
+               result.mean_error, result.max_error, 1.0e3 * result.seconds);
+    }
+
+    return EXIT_SUCCESS;
+}
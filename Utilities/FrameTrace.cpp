@@ -0,0 +1,332 @@
+//
+//  FrameTrace.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Utilities/FrameTrace.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+
+#if defined ( __APPLE__ )
+#include <mach/mach_time.h>
+#endif
+
+//===------------------------------------------------------------------------===
+// • namespace instrumentation
+//===------------------------------------------------------------------------===
+
+namespace instrumentation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+#if INSTRUMENTATION
+
+    // • Live rings and the newest spans of threads that have exited. Created
+    //   by the first ring's constructor, so it outlives every ring
+    //
+    struct Registry
+    {
+        std::mutex                  mutex;
+        std::vector<const SpanRing*> rings;
+        std::vector<Span>           retired;
+        uint32_t                    thread_count = 0;
+    };
+
+    Registry& registry(void)
+    {
+        static Registry instance;
+
+        return instance;
+    }
+
+#endif // INSTRUMENTATION
+
+    // • Nearest-rank percentile of sorted durations
+    //
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        const auto rank = static_cast<size_t>( std::ceil(p * sorted.size()) );
+
+        return sorted[ std::clamp(rank, size_t{ 1 }, sorted.size()) - 1 ];
+    }
+
+    // • Nanoseconds; zero for a span whose end precedes its begin (torn, or
+    //   timestamps from another clock)
+    //
+    uint64_t duration(const Span& span) noexcept
+    {
+        return (span.begin < span.end) ? span.end - span.begin : 0;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Stages
+//===------------------------------------------------------------------------===
+
+const char* stage_name(Stage stage) noexcept
+{
+    switch (stage)
+    {
+        case Stage::frame:                  return "frame";
+        case Stage::prepare_composition:    return "prepare_composition";
+        case Stage::vertex_generation:      return "vertex_generation";
+        case Stage::triangle_setup:         return "triangle_setup";
+        case Stage::shading:                return "shading";
+        case Stage::gpu:                    return "gpu";
+        case Stage::output_encoding:        return "output_encoding";
+        case Stage::count:                  break;
+    }
+
+    return "unknown";
+}
+
+uint64_t trace_clock(void) noexcept
+{
+#if defined ( __APPLE__ )
+    // • mach_absolute_time stops during sleep, as Metal's host time does;
+    //   steady_clock (CLOCK_MONOTONIC_RAW) does not
+    //
+    static const auto timebase = [] {
+        auto info = mach_timebase_info_data_t{};
+        mach_timebase_info(&info);
+        return info;
+    }();
+
+    const auto ticks = mach_absolute_time();
+
+    // • Split so ticks × numer cannot overflow
+    //
+    return (ticks / timebase.denom) * timebase.numer
+         + (ticks % timebase.denom) * timebase.numer / timebase.denom;
+#else
+    const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() );
+#endif
+}
+
+//===------------------------------------------------------------------------===
+// • SpanRing
+//===------------------------------------------------------------------------===
+
+#if INSTRUMENTATION
+
+SpanRing::SpanRing(void)
+    : slots_( new Slot[capacity] )
+    , head_ ( 0 )
+{
+    auto& shared = registry();
+    auto  lock   = std::lock_guard{ shared.mutex };
+
+    thread_ = ++shared.thread_count;
+
+    shared.rings.push_back(this);
+}
+
+SpanRing::~SpanRing()
+{
+    auto& shared = registry();
+    auto  lock   = std::lock_guard{ shared.mutex };
+
+    read(shared.retired);
+
+    if (capacity < shared.retired.size())
+    {
+        shared.retired.erase( shared.retired.begin(), shared.retired.end() - capacity );
+    }
+
+    shared.rings.erase( std::find(shared.rings.begin(), shared.rings.end(), this) );
+}
+
+void SpanRing::read(std::vector<Span>& spans) const
+{
+    const auto head  = head_.load(std::memory_order_acquire);
+    const auto first = (capacity < head) ? head - capacity : 0;
+    const auto base  = spans.size();
+
+    for (auto index = first; index < head; ++index)
+    {
+        const auto& slot = slots_[index % capacity];
+
+        spans.push_back({
+            .begin  = slot.begin.load(std::memory_order_relaxed),
+            .end    = slot.end.load(std::memory_order_relaxed),
+            .stage  = static_cast<Stage>( slot.stage.load(std::memory_order_relaxed) ),
+            .thread = thread_
+        });
+    }
+
+    // • Drop slots the owner may have overwritten while they were copied
+    //
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const auto later = head_.load(std::memory_order_relaxed);
+
+    // • The owner writes slot `later % capacity` before advancing head_, so
+    //   index `later - capacity` may already be torn
+    //
+    if (first + capacity <= later)
+    {
+        const auto stale = std::min(later - capacity - first + 1, head - first);
+
+        spans.erase( spans.begin() + base, spans.begin() + base + stale );
+    }
+}
+
+#endif // INSTRUMENTATION
+
+std::vector<Span> collect_spans(void)
+{
+    auto spans = std::vector<Span>{};
+
+#if INSTRUMENTATION
+    auto& shared = registry();
+    auto  lock   = std::lock_guard{ shared.mutex };
+
+    spans = shared.retired;
+
+    for (const auto ring : shared.rings)
+    {
+        ring->read(spans);
+    }
+#endif
+
+    return spans;
+}
+
+//===------------------------------------------------------------------------===
+// • Chrome trace
+//===------------------------------------------------------------------------===
+
+std::string format_chrome_trace(const std::vector<Span>& spans)
+{
+    const auto origin = spans.empty() ? uint64_t{ 0 }
+                                      : std::min_element( spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+                                            return a.begin < b.begin;
+                                        })->begin;
+
+    auto json = std::string{ "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" };
+    char event[192];
+
+    for (size_t is = 0; is < spans.size(); ++is)
+    {
+        const auto& span = spans[is];
+
+        snprintf(event, sizeof(event),
+                 "%s\n{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                 (0 == is) ? "" : ",", stage_name(span.stage), span.thread,
+                 1.0e-3 * (span.begin - origin), 1.0e-3 * duration(span));
+
+        json += event;
+    }
+
+    json += "\n]}\n";
+
+    return json;
+}
+
+bool write_chrome_trace(const char* path, const std::vector<Span>& spans)
+{
+    const auto json = format_chrome_trace(spans);
+    const auto file = fopen(path, "wb");
+
+    if (nullptr == file)
+    {
+        return false;
+    }
+
+    const auto is_written = json.size() == fwrite(json.data(), 1, json.size(), file);
+
+    return (0 == fclose(file)) && is_written;
+}
+
+//===------------------------------------------------------------------------===
+// • Stage statistics
+//===------------------------------------------------------------------------===
+
+std::vector<StageStatistics> stage_statistics(const std::vector<Span>& spans)
+{
+    auto durations = std::vector<std::vector<double>>(stage_count);
+
+    for (const auto& span : spans)
+    {
+        if ( static_cast<size_t>(span.stage) < stage_count )
+        {
+            durations[ static_cast<size_t>(span.stage) ].push_back( 1.0e-6 * duration(span) );
+        }
+    }
+
+    auto statistics = std::vector<StageStatistics>{};
+
+    for (size_t is = 0; is < stage_count; ++is)
+    {
+        auto& sorted = durations[is];
+
+        if ( sorted.empty() )
+        {
+            continue;
+        }
+
+        std::sort(sorted.begin(), sorted.end());
+
+        auto sum = 0.0;
+
+        for (const auto duration : sorted)
+        {
+            sum += duration;
+        }
+
+        statistics.push_back({
+            .stage = static_cast<Stage>(is),
+            .count = static_cast<uint32_t>( sorted.size() ),
+            .mean  = sum / sorted.size(),
+            .p50   = percentile(sorted, 0.50),
+            .p99   = percentile(sorted, 0.99),
+            .max   = sorted.back()
+        });
+    }
+
+    return statistics;
+}
+
+std::string format_stage_statistics(const std::vector<StageStatistics>& statistics)
+{
+    auto report = std::string{ "stage                    count      mean ms    p50 ms     p99 ms     max ms\n" };
+    char line[160];
+
+    for (const auto& stage : statistics)
+    {
+        snprintf(line, sizeof(line), "%-20s %9u  %9.3f  %9.3f  %9.3f  %9.3f\n",
+                 stage_name(stage.stage), stage.count, stage.mean, stage.p50, stage.p99, stage.max);
+
+        report += line;
+    }
+
+    return report;
+}
+
+} // namespace instrumentation
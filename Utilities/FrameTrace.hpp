@@ -0,0 +1,228 @@
+//
+//  FrameTrace.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Utilities/Instrumentation.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace instrumentation
+//===------------------------------------------------------------------------===
+
+namespace instrumentation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Frame stages
+//
+//  Renderer.draw records the frame (CPU encoding) and the GPU execution of
+//  its whole command buffer (gpu); the passes within it are not timed
+//  separately. HostRenderer shades every layer in one pass per tile,
+//  recorded as shading. ImageEncoder records one output_encoding span per
+//  strip written and one for the trailer, so its statistics are per strip,
+//  not per frame. Values are shared with FrameTracer.h.
+//
+//===------------------------------------------------------------------------===
+
+enum class Stage : uint32_t
+{
+    frame,                  // one whole frame
+    prepare_composition,    // prepareCompositionBuffer
+    vertex_generation,      // gamut slice vertices
+    triangle_setup,         // HostRenderer triangles and tile bins
+    shading,                // HostRenderer tiles
+    gpu,                    // command buffer execution
+    output_encoding,        // ImageEncoder, per strip and trailer
+    count
+};
+
+constexpr auto stage_count = static_cast<size_t>( Stage::count );
+
+const char* stage_name(Stage stage) noexcept;
+
+//===------------------------------------------------------------------------===
+// • Spans
+//===------------------------------------------------------------------------===
+
+struct Span
+{
+    uint64_t    begin;      // trace_clock, nanoseconds
+    uint64_t    end;
+    Stage       stage;
+    uint32_t    thread;     // registration order, from 1
+};
+
+// • Nanoseconds. On Apple platforms mach_absolute_time, the host time of
+//   Metal timestamps (gpuStartTime × 10⁹), which pauses during sleep;
+//   elsewhere the steady clock
+//
+uint64_t trace_clock(void) noexcept;
+
+// • Spans retained by every thread's ring, oldest first per thread, and by
+//   threads that have exited (bounded as one more ring)
+//
+std::vector<Span> collect_spans(void);
+
+//===------------------------------------------------------------------------===
+// • Export
+//===------------------------------------------------------------------------===
+
+// • Chrome trace event JSON ("X" events, microseconds), for chrome://tracing
+//   or Perfetto
+//
+std::string format_chrome_trace(const std::vector<Span>& spans);
+bool write_chrome_trace(const char* path, const std::vector<Span>& spans);
+
+struct StageStatistics
+{
+    Stage       stage;
+    uint32_t    count;
+    double      mean;       // milliseconds
+    double      p50;
+    double      p99;
+    double      max;
+};
+
+// • Stages with at least one span, in Stage order
+//
+std::vector<StageStatistics> stage_statistics(const std::vector<Span>& spans);
+std::string format_stage_statistics(const std::vector<StageStatistics>& statistics);
+
+//===------------------------------------------------------------------------===
+//
+// • SpanRing
+//
+//  Fixed-capacity ring of one thread's spans, overwriting the oldest. The
+//  owning thread is the only writer and publishes each span by advancing
+//  head_ with a release store; readers copy the slots and re-read head_ to
+//  discard any slot overwritten meanwhile, so neither side ever waits.
+//
+//===------------------------------------------------------------------------===
+
+#if INSTRUMENTATION
+
+class SpanRing
+{
+public:
+
+    enum : uint32_t
+    {
+        capacity = 1u << 14
+    };
+
+    SpanRing(void);
+    ~SpanRing();
+
+    SpanRing(const SpanRing&) = delete;
+    SpanRing& operator=(const SpanRing&) = delete;
+
+    void record(Stage stage, uint64_t begin, uint64_t end) noexcept
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        auto&      slot = slots_[head % capacity];
+
+        // • Orders the previous head_ store before the slot stores: a reader
+        //   that sees any of them also sees head_ past the slot's old span
+        //
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.stage.store(static_cast<uint32_t>(stage), std::memory_order_relaxed);
+
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    void read(std::vector<Span>& spans) const;
+
+private:
+
+    struct Slot
+    {
+        std::atomic<uint64_t>   begin;
+        std::atomic<uint64_t>   end;
+        std::atomic<uint32_t>   stage;
+    };
+
+    std::unique_ptr<Slot[]>     slots_;
+    std::atomic<uint64_t>       head_;
+    uint32_t                    thread_;
+};
+
+inline SpanRing& span_ring(void)
+{
+    thread_local SpanRing ring;
+
+    return ring;
+}
+
+inline void record_span(Stage stage, uint64_t begin, uint64_t end) noexcept
+{
+    span_ring().record(stage, begin, end);
+}
+
+//===------------------------------------------------------------------------===
+// • ScopedSpan
+//===------------------------------------------------------------------------===
+
+class ScopedSpan
+{
+public:
+
+    explicit ScopedSpan(Stage stage) noexcept
+        : stage_( stage )
+        , begin_( trace_clock() )
+    {
+    }
+
+    ~ScopedSpan()
+    {
+        record_span( stage_, begin_, trace_clock() );
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+
+    Stage       stage_;
+    uint64_t    begin_;
+};
+
+#define TRACE_SPAN(stage_) \
+    const auto trace_span_##stage_ = ::instrumentation::ScopedSpan{ ::instrumentation::Stage::stage_ }
+
+#else
+
+inline void record_span(Stage, uint64_t, uint64_t) noexcept
+{
+}
+
+#define TRACE_SPAN(stage_) ((void)0)
+
+#endif // INSTRUMENTATION
+
+} // namespace instrumentation
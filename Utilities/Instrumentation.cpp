@@ -0,0 +1,317 @@
+//
+//  Instrumentation.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Utilities/Instrumentation.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace instrumentation
+//===------------------------------------------------------------------------===
+
+namespace instrumentation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    uint64_t now(void)
+    {
+        const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+
+        return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() );
+    }
+
+    void accumulate(Snapshot& totals, const Snapshot& addend) noexcept
+    {
+        for (size_t ic = 0; ic < counter_count; ++ic)
+        {
+            totals.counters[ic] += addend.counters[ic];
+        }
+
+        for (size_t it = 0; it < timer_count; ++it)
+        {
+            totals.timers[it].call_count  += addend.timers[it].call_count;
+            totals.timers[it].nanoseconds += addend.timers[it].nanoseconds;
+        }
+    }
+
+#if INSTRUMENTATION
+
+    // • Live thread records and the totals of threads that have exited. The
+    //   registry outlives every record: it is created by the first record's
+    //   constructor
+    //
+    struct Registry
+    {
+        std::mutex                          mutex;
+        std::vector<const ThreadRecord*>    records;
+        Snapshot                            retired = {};
+        uint32_t                            thread_count = 0;
+    };
+
+    Registry& registry(void)
+    {
+        static Registry instance;
+
+        return instance;
+    }
+
+#endif // INSTRUMENTATION
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Names
+//===------------------------------------------------------------------------===
+
+const char* counter_name(Counter counter) noexcept
+{
+    switch (counter)
+    {
+        case Counter::max_chroma_solves:        return "max_chroma_solves";
+        case Counter::max_chroma_iterations:    return "max_chroma_iterations";
+        case Counter::slice_band_solves:        return "slice_band_solves";
+        case Counter::slice_band_iterations:    return "slice_band_iterations";
+        case Counter::hue_changes:              return "hue_changes";
+        case Counter::prefetch_hits:            return "prefetch_hits";
+        case Counter::prefetch_misses:          return "prefetch_misses";
+        case Counter::slice_cache_hits:         return "slice_cache_hits";
+        case Counter::slice_cache_misses:       return "slice_cache_misses";
+        case Counter::count:                    break;
+    }
+
+    return "unknown";
+}
+
+const char* timer_name(Timer timer) noexcept
+{
+    switch (timer)
+    {
+        case Timer::max_chroma:             return "max_chroma";
+        case Timer::slice_band:             return "slice_band";
+        case Timer::prepare_composition:    return "prepare_composition";
+        case Timer::count:                  break;
+    }
+
+    return "unknown";
+}
+
+//===------------------------------------------------------------------------===
+// • ThreadRecord
+//===------------------------------------------------------------------------===
+
+#if INSTRUMENTATION
+
+ThreadRecord::ThreadRecord(void)
+{
+    for (auto& value : counters_)    { value.store(0, std::memory_order_relaxed); }
+    for (auto& value : calls_)       { value.store(0, std::memory_order_relaxed); }
+    for (auto& value : nanoseconds_) { value.store(0, std::memory_order_relaxed); }
+
+    auto& shared = registry();
+    auto  lock   = std::lock_guard{ shared.mutex };
+
+    shared.records.push_back(this);
+    ++shared.thread_count;
+}
+
+ThreadRecord::~ThreadRecord()
+{
+    auto& shared = registry();
+    auto  lock   = std::lock_guard{ shared.mutex };
+
+    read(shared.retired);
+
+    shared.records.erase( std::find(shared.records.begin(), shared.records.end(), this) );
+}
+
+void ThreadRecord::read(Snapshot& totals) const noexcept
+{
+    for (size_t ic = 0; ic < counter_count; ++ic)
+    {
+        totals.counters[ic] += counters_[ic].load(std::memory_order_relaxed);
+    }
+
+    for (size_t it = 0; it < timer_count; ++it)
+    {
+        totals.timers[it].call_count  += calls_[it].load(std::memory_order_relaxed);
+        totals.timers[it].nanoseconds += nanoseconds_[it].load(std::memory_order_relaxed);
+    }
+}
+
+#endif // INSTRUMENTATION
+
+//===------------------------------------------------------------------------===
+// • Snapshots
+//===------------------------------------------------------------------------===
+
+Snapshot snapshot(void)
+{
+    auto totals = Snapshot{};
+
+#if INSTRUMENTATION
+    auto& shared = registry();
+    auto  lock   = std::lock_guard{ shared.mutex };
+
+    accumulate(totals, shared.retired);
+
+    for (const auto record : shared.records)
+    {
+        record->read(totals);
+    }
+
+    totals.thread_count = shared.thread_count;
+#else
+    (void)accumulate;
+#endif
+
+    totals.time = now();
+
+    return totals;
+}
+
+Snapshot difference(const Snapshot& later, const Snapshot& earlier) noexcept
+{
+    auto delta = later;
+
+    for (size_t ic = 0; ic < counter_count; ++ic)
+    {
+        delta.counters[ic] -= earlier.counters[ic];
+    }
+
+    for (size_t it = 0; it < timer_count; ++it)
+    {
+        delta.timers[it].call_count  -= earlier.timers[it].call_count;
+        delta.timers[it].nanoseconds -= earlier.timers[it].nanoseconds;
+    }
+
+    delta.interval = later.time - earlier.time;
+
+    return delta;
+}
+
+std::string format_snapshot(const Snapshot& snapshot)
+{
+    const auto seconds = 1.0e-9 * snapshot.interval;
+
+    auto report = std::string{};
+    char line[160];
+
+    for (size_t ic = 0; ic < counter_count; ++ic)
+    {
+        const auto value = snapshot.counters[ic];
+
+        if (0 == value)
+        {
+            continue;
+        }
+
+        const auto name = counter_name( static_cast<Counter>(ic) );
+
+        if (0.0 < seconds)
+        {
+            snprintf(line, sizeof(line), "%-24s %12llu  %12.1f/s\n", name,
+                     static_cast<unsigned long long>(value), value / seconds);
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "%-24s %12llu\n", name, static_cast<unsigned long long>(value));
+        }
+
+        report += line;
+    }
+
+    for (size_t it = 0; it < timer_count; ++it)
+    {
+        const auto& total = snapshot.timers[it];
+
+        if (0 == total.call_count)
+        {
+            continue;
+        }
+
+        snprintf(line, sizeof(line), "%-24s %12llu calls  %12.3f ms  %10.3f us/call\n",
+                 timer_name( static_cast<Timer>(it) ),
+                 static_cast<unsigned long long>(total.call_count),
+                 1.0e-6 * total.nanoseconds,
+                 1.0e-3 * total.nanoseconds / total.call_count);
+
+        report += line;
+    }
+
+    return report;
+}
+
+//===------------------------------------------------------------------------===
+// • PeriodicReporter
+//===------------------------------------------------------------------------===
+
+PeriodicReporter::PeriodicReporter(std::chrono::milliseconds interval, Report report)
+    : interval_( interval )
+    , report_  ( std::move(report) )
+    , stopping_( false )
+{
+#if INSTRUMENTATION
+    thread_ = std::thread{ [this] { run(); } };
+#endif
+}
+
+PeriodicReporter::~PeriodicReporter()
+{
+    if ( thread_.joinable() )
+    {
+        {
+            auto lock = std::lock_guard{ mutex_ };
+
+            stopping_ = true;
+        }
+
+        wake_.notify_one();
+        thread_.join();
+    }
+}
+
+void PeriodicReporter::run(void)
+{
+    auto previous = snapshot();
+    auto lock     = std::unique_lock{ mutex_ };
+
+    for (auto is_last = false; !is_last; )
+    {
+        is_last = wake_.wait_for( lock, interval_, [this] { return stopping_; } );
+
+        lock.unlock();
+
+        const auto current = snapshot();
+
+        report_( difference(current, previous) );
+
+        previous = current;
+
+        lock.lock();
+    }
+}
+
+} // namespace instrumentation
@@ -0,0 +1,268 @@
+//
+//  Instrumentation.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+//===------------------------------------------------------------------------===
+// • Compile-time switch
+//
+//  Define INSTRUMENTATION=1 (e.g. in GCC_PREPROCESSOR_DEFINITIONS) to record
+//  counters and timers. Otherwise INSTRUMENT_COUNT and INSTRUMENT_TIMER expand
+//  to nothing, their arguments are not evaluated, snapshots are all zero and
+//  PeriodicReporter starts no thread.
+//
+//===------------------------------------------------------------------------===
+
+#if !defined ( INSTRUMENTATION )
+#define INSTRUMENTATION 0
+#endif
+
+//===------------------------------------------------------------------------===
+// • namespace instrumentation
+//===------------------------------------------------------------------------===
+
+namespace instrumentation
+{
+
+//===------------------------------------------------------------------------===
+// • Counters and timers
+//===------------------------------------------------------------------------===
+
+enum class Counter : uint32_t
+{
+    max_chroma_solves,      // find_max_chroma_color searches
+    max_chroma_iterations,  // bracket iterations of those searches
+    slice_band_solves,      // solve_slice_band calls
+    slice_band_iterations,  // bracket iterations of those calls
+    hue_changes,            // composition hue updates (max chroma re-solved)
+    prefetch_hits,          // HuePrefetcher lookups served from the table
+    prefetch_misses,        // ... and those falling back to the solver
+    slice_cache_hits,       // SliceCache lookups served from the cache
+    slice_cache_misses,     // ... and those solving a slice
+    count
+};
+
+enum class Timer : uint32_t
+{
+    max_chroma,             // find_max_chroma_color
+    slice_band,             // solve_slice_band
+    prepare_composition,    // prepareCompositionBuffer (either path)
+    count
+};
+
+constexpr auto counter_count = static_cast<size_t>( Counter::count );
+constexpr auto timer_count   = static_cast<size_t>( Timer::count );
+
+const char* counter_name(Counter counter) noexcept;
+const char* timer_name(Timer timer) noexcept;
+
+//===------------------------------------------------------------------------===
+//
+// • Snapshot
+//
+//  Totals over every thread that has recorded anything, including threads
+//  that have since exited. Counters only ever grow; rates over an interval
+//  are the difference of two snapshots.
+//
+//===------------------------------------------------------------------------===
+
+struct TimerTotal
+{
+    uint64_t    call_count;
+    uint64_t    nanoseconds;
+};
+
+struct Snapshot
+{
+    std::array<uint64_t, counter_count>   counters;
+    std::array<TimerTotal, timer_count>   timers;
+    uint64_t                              time;         // steady clock, nanoseconds
+    uint64_t                              interval;     // nanoseconds spanned by a difference, else 0
+    uint32_t                              thread_count; // threads recorded so far
+
+    uint64_t counter(Counter counter) const noexcept
+    {
+        return counters[ static_cast<size_t>(counter) ];
+    }
+
+    const TimerTotal& timer(Timer timer) const noexcept
+    {
+        return timers[ static_cast<size_t>(timer) ];
+    }
+};
+
+Snapshot snapshot(void);
+
+// • Counts and times recorded between `earlier` and `later`
+//
+Snapshot difference(const Snapshot& later, const Snapshot& earlier) noexcept;
+
+// • One line per non-zero counter and timer, with per-second rates when the
+//   snapshot is a difference
+//
+std::string format_snapshot(const Snapshot& snapshot);
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadRecord
+//
+//  Counters of one thread, registered on its first use and folded into the
+//  retired totals when the thread exits. Only the owning thread writes, as a
+//  relaxed load and store rather than a read-modify-write, so recording
+//  costs a thread-local access and two plain moves; readers see each value
+//  whole but possibly a little stale.
+//
+//===------------------------------------------------------------------------===
+
+#if INSTRUMENTATION
+
+class ThreadRecord
+{
+public:
+
+    ThreadRecord(void);
+    ~ThreadRecord();
+
+    ThreadRecord(const ThreadRecord&) = delete;
+    ThreadRecord& operator=(const ThreadRecord&) = delete;
+
+    void add(Counter counter, uint64_t amount) noexcept
+    {
+        bump( counters_[ static_cast<size_t>(counter) ], amount );
+    }
+
+    void add_time(Timer timer, uint64_t nanoseconds) noexcept
+    {
+        const auto it = static_cast<size_t>(timer);
+
+        bump( calls_[it], 1 );
+        bump( nanoseconds_[it], nanoseconds );
+    }
+
+    void read(Snapshot& totals) const noexcept;
+
+private:
+
+    static void bump(std::atomic<uint64_t>& value, uint64_t amount) noexcept
+    {
+        value.store( value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed );
+    }
+
+    std::array<std::atomic<uint64_t>, counter_count>  counters_;
+    std::array<std::atomic<uint64_t>, timer_count>    calls_;
+    std::array<std::atomic<uint64_t>, timer_count>    nanoseconds_;
+};
+
+inline ThreadRecord& thread_record(void)
+{
+    thread_local ThreadRecord record;
+
+    return record;
+}
+
+//===------------------------------------------------------------------------===
+// • ScopedTimer
+//===------------------------------------------------------------------------===
+
+class ScopedTimer
+{
+public:
+
+    explicit ScopedTimer(Timer timer) noexcept
+        : timer_( timer )
+        , start_( std::chrono::steady_clock::now() )
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+
+        thread_record().add_time( timer_, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() ) );
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+
+    Timer                                   timer_;
+    std::chrono::steady_clock::time_point   start_;
+};
+
+#define INSTRUMENT_COUNT(counter_, amount_) \
+    ::instrumentation::thread_record().add( ::instrumentation::Counter::counter_, (amount_) )
+
+#define INSTRUMENT_TIMER(timer_) \
+    const auto instrumentation_timer_##timer_ = ::instrumentation::ScopedTimer{ ::instrumentation::Timer::timer_ }
+
+#else
+
+#define INSTRUMENT_COUNT(counter_, amount_) ((void)0)
+#define INSTRUMENT_TIMER(timer_)            ((void)0)
+
+#endif // INSTRUMENTATION
+
+//===------------------------------------------------------------------------===
+//
+// • PeriodicReporter (Host only)
+//
+//  Background thread handing the difference between consecutive snapshots
+//  to `report` every `interval`, and once more for the remainder when
+//  destroyed. Does nothing when instrumentation is compiled out.
+//
+//===------------------------------------------------------------------------===
+
+class PeriodicReporter
+{
+public:
+
+    using Report = std::function<void(const Snapshot&)>;
+
+    PeriodicReporter(std::chrono::milliseconds interval, Report report);
+    ~PeriodicReporter();
+
+    PeriodicReporter(const PeriodicReporter&) = delete;
+    PeriodicReporter& operator=(const PeriodicReporter&) = delete;
+
+private:
+
+    void run(void);
+
+    std::chrono::milliseconds   interval_;
+    Report                      report_;
+
+    std::mutex                  mutex_;
+    std::condition_variable     wake_;
+    bool                        stopping_;
+    std::thread                 thread_;
+};
+
+} // namespace instrumentation
@@ -0,0 +1,211 @@
+//
+//  ThreadPool.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Utilities/ThreadPool.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+//===------------------------------------------------------------------------===
+// • namespace utilities
+//===------------------------------------------------------------------------===
+
+namespace utilities
+{
+
+//===------------------------------------------------------------------------===
+// • Job
+//===------------------------------------------------------------------------===
+
+struct ThreadPool::Job
+{
+    const Function*         function;
+    uint32_t                count;
+    std::atomic<uint32_t>   next;       // next unclaimed index
+    std::atomic<uint32_t>   completed;  // finished indices
+    std::atomic<uint32_t>   users;      // threads other than the owner holding the job
+};
+
+//===------------------------------------------------------------------------===
+// • Initialization
+//===------------------------------------------------------------------------===
+
+ThreadPool::ThreadPool(uint32_t worker_count)
+    : stopping_( false )
+{
+    workers_.reserve(worker_count);
+
+    for (uint32_t iw = 0; iw < worker_count; ++iw)
+    {
+        workers_.emplace_back( [this] { run_worker(); } );
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{ mutex_ };
+        stopping_ = true;
+    }
+
+    available_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+uint32_t ThreadPool::default_worker_count(void) noexcept
+{
+    const auto hardware = std::thread::hardware_concurrency();
+
+    return (1 < hardware) ? hardware - 1 : 0;
+}
+
+ThreadPool& ThreadPool::shared(void)
+{
+    static ThreadPool pool;
+
+    return pool;
+}
+
+//===------------------------------------------------------------------------===
+// • Parallel loop
+//===------------------------------------------------------------------------===
+
+void ThreadPool::parallel_for(uint32_t count, const Function& function)
+{
+    if (0 == count)
+    {
+        return;
+    }
+
+    if (1 == count || workers_.empty())
+    {
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            function(index);
+        }
+
+        return;
+    }
+
+    Job job{ .function = &function, .count = count, .next = 0, .completed = 0, .users = 0 };
+
+    {
+        std::lock_guard lock{ mutex_ };
+        jobs_.push_back(&job);
+    }
+
+    available_.notify_all();
+
+    // • Work on this job first
+    //
+    for (auto index = job.next.fetch_add(1); index < count; index = job.next.fetch_add(1))
+    {
+        function(index);
+        job.completed.fetch_add(1, std::memory_order_release);
+    }
+
+    // • Every index is claimed: withdraw the job so no new thread picks it up
+    //
+    {
+        std::lock_guard lock{ mutex_ };
+        jobs_.erase( std::find(jobs_.begin(), jobs_.end(), &job) );
+    }
+
+    // • Help with other jobs until the stragglers have finished this one
+    //
+    while ( count != job.completed.load(std::memory_order_acquire)
+         || 0     != job.users.load(std::memory_order_acquire) )
+    {
+        if ( !run_one() )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Workers
+//===------------------------------------------------------------------------===
+
+bool ThreadPool::run_one(void)
+{
+    Job* job = nullptr;
+
+    {
+        std::lock_guard lock{ mutex_ };
+
+        for (auto candidate : jobs_)
+        {
+            if ( candidate->next.load(std::memory_order_relaxed) < candidate->count )
+            {
+                job = candidate;
+                job->users.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    if (nullptr == job)
+    {
+        return false;
+    }
+
+    const auto index = job->next.fetch_add(1);
+
+    if (index < job->count)
+    {
+        (*job->function)(index);
+        job->completed.fetch_add(1, std::memory_order_release);
+    }
+
+    job->users.fetch_sub(1, std::memory_order_release);
+
+    return true;
+}
+
+void ThreadPool::run_worker(void)
+{
+    for (;;)
+    {
+        if ( run_one() )
+        {
+            continue;
+        }
+
+        std::unique_lock lock{ mutex_ };
+
+        available_.wait( lock, [this] {
+
+            return stopping_ || std::any_of( jobs_.begin(), jobs_.end(), [](const Job* job) {
+                return job->next.load(std::memory_order_relaxed) < job->count;
+            });
+        });
+
+        if (stopping_)
+        {
+            return;
+        }
+    }
+}
+
+} // namespace utilities
@@ -0,0 +1,98 @@
+//
+//  ThreadPool.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace utilities
+//===------------------------------------------------------------------------===
+
+namespace utilities
+{
+
+//===------------------------------------------------------------------------===
+//
+// • ThreadPool (Host only)
+//
+//  Fixed set of worker threads executing index-parallel loops. The calling
+//  thread participates in its own loop and, while waiting for stragglers,
+//  helps with any other queued loop, so parallel_for may be nested (e.g.
+//  frames in parallel, each rendering its tiles in parallel).
+//
+//===------------------------------------------------------------------------===
+
+class ThreadPool
+{
+public:
+
+    using Function = std::function<void (uint32_t)>;
+
+    // • Initialization. `worker_count` excludes the calling thread
+    //
+    explicit ThreadPool(uint32_t worker_count = default_worker_count());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    // • Invoke function(index) for every index in [0, count) and wait
+    //
+    void parallel_for(uint32_t count, const Function& function);
+
+    // • Properties
+    //
+    uint32_t worker_count(void) const noexcept
+    {
+        return static_cast<uint32_t>( workers_.size() );
+    }
+
+    uint32_t concurrency(void) const noexcept
+    {
+        return worker_count() + 1;
+    }
+
+    static uint32_t default_worker_count(void) noexcept;
+
+    // • Process-wide pool
+    //
+    static ThreadPool& shared(void);
+
+private:
+
+    struct Job;
+
+    bool run_one(void);
+    void run_worker(void);
+
+    std::mutex                  mutex_;
+    std::condition_variable     available_;
+    std::vector<Job*>           jobs_;
+    bool                        stopping_;
+
+    std::vector<std::thread>    workers_;
+};
+
+} // namespace utilities
@@ -0,0 +1,507 @@
+//
+//  GoldenReference.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/GoldenReference.hpp>
+#include <Graphics/GamutSlice.hpp>
+#include <Graphics/HueGradient.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Graphics/JzazbzBatch.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    using Matrix = std::array<Triplet, 3>;  // columns, as simd::float3x3
+
+    Triplet multiply(const Matrix& m, const Triplet& v)
+    {
+        auto result = Triplet{};
+
+        for (auto ic = 0; ic < 3; ++ic)
+        {
+            for (auto ir = 0; ir < 3; ++ir)
+            {
+                result[ir] += m[ic][ir] * v[ic];
+            }
+        }
+
+        return result;
+    }
+
+    Triplet mix(const Triplet& x, const Triplet& y, long double t)
+    {
+        return { x[0] + t*(y[0] - x[0]), x[1] + t*(y[1] - x[1]), x[2] + t*(y[2] - x[2]) };
+    }
+
+    Triplet make_triplet(simd::float3 v)
+    {
+        return { v[0], v[1], v[2] };
+    }
+
+    simd::float3 make_float3(const Triplet& v)
+    {
+        return simd::float3{ static_cast<float>(v[0]), static_cast<float>(v[1]), static_cast<float>(v[2]) };
+    }
+
+    Triplet jab_of_linear_display_P3(const Triplet& lrgb)
+    {
+        return reference::from_LMS( reference::linear_display_P3_to_LMS(lrgb) );
+    }
+
+    // • Largest component difference in float ULPs of the largest reference
+    //   component magnitude, at least 2^-6 (outputs near black are tiny)
+    //
+    double ulp_error(simd::float3 fast, const Triplet& exact)
+    {
+        auto magnitude  = 0.015625L;
+        auto difference = 0.0L;
+
+        for (auto ic = 0; ic < 3; ++ic)
+        {
+            magnitude  = std::max( magnitude,  fabsl(exact[ic]) );
+            difference = std::max( difference, fabsl(fast[ic] - exact[ic]) );
+        }
+
+        const auto rounded = static_cast<float>(magnitude);
+        const auto ulp     = nextafterf(rounded, FLT_MAX) - rounded;
+
+        return static_cast<double>(difference / ulp);
+    }
+
+    class Accumulator
+    {
+    public:
+
+        Accumulator(const char* kernel, const ErrorBound& bound)
+            : error_( KernelError{ .kernel = kernel, .sample_count = 0,
+                                   .max_delta_Ez = 0.0, .mean_delta_Ez = 0.0,
+                                   .max_ulp = 0.0, .mean_ulp = 0.0,
+                                   .bound = bound, .passed = false } )
+        {
+        }
+
+        void add(long double delta_Ez, double ulp)
+        {
+            const auto dE = static_cast<double>(delta_Ez);
+
+            error_.max_delta_Ez  = std::max(error_.max_delta_Ez, dE);
+            error_.max_ulp       = std::max(error_.max_ulp, ulp);
+            error_.mean_delta_Ez += dE;
+            error_.mean_ulp      += ulp;
+
+            ++error_.sample_count;
+        }
+
+        KernelError result(void) const
+        {
+            auto error  = error_;
+            const auto n = static_cast<double>( std::max(error.sample_count, uint64_t{ 1 }) );
+
+            error.mean_delta_Ez /= n;
+            error.mean_ulp      /= n;
+            error.passed         = error.max_delta_Ez <= error.bound.delta_Ez && error.max_ulp <= error.bound.ulp;
+
+            return error;
+        }
+
+    private:
+
+        KernelError error_;
+    };
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Reference color math
+//===------------------------------------------------------------------------===
+
+namespace reference
+{
+    constexpr auto d  = -0.56L;
+    constexpr auto d0 =  1.6295499532821566e-11L;
+    constexpr auto c1 =  3424.0L / 4096.0L;
+    constexpr auto c2 =  2413.0L / 128.0L;
+    constexpr auto c3 =  2392.0L / 128.0L;
+    constexpr auto n  =  2610.0L / 16384.0L;
+    constexpr auto p  =  1.7L * 2523.0L / 32.0L;
+
+    constexpr auto white_Jz = 0.16717463103478347L;
+
+    Triplet convert_to_LMS(const Triplet& jab)
+    {
+        const auto M_IzazbzToLMSp = Matrix{
+            Triplet{ 1.0L,                 1.0L,                 1.0L                },
+            Triplet{ 0.138605043271539L,  -0.138605043271539L,  -0.0960192420263189L },
+            Triplet{ 0.0580473161561189L, -0.0580473161561189L, -0.811891896056039L  }
+        };
+
+        constexpr auto minLMSp = 0.0000000000370353L;
+        constexpr auto maxLMSp = 3.227L;
+
+        const auto Jzp  = jab[0] + d0;
+        const auto Iz   = Jzp / (1.0L + d - d*Jzp);
+        const auto LMSp = multiply( M_IzazbzToLMSp, { Iz, jab[1], jab[2] } );
+
+        auto lms = Triplet{};
+
+        for (auto ic = 0; ic < 3; ++ic)
+        {
+            const auto LMSpp1 = powl( std::clamp(LMSp[ic], minLMSp, maxLMSp), 1.0L/p );
+            const auto LMSpp2 = (c1 - LMSpp1) / (c3*LMSpp1 - c2);
+
+            lms[ic] = 100.0L * powl(LMSpp2, 1.0L/n);
+        }
+
+        return lms;
+    }
+
+    Triplet LMS_to_linear_display_P3(const Triplet& lms)
+    {
+        const auto M_LMSToLinearP3 = Matrix{
+            Triplet{  4.4820606379518333L,  -1.9532025238860451L,  -0.0027453573623004834L },
+            Triplet{ -3.6184317541411817L,   3.5217700975984596L,  -0.45182653146288487L   },
+            Triplet{  0.16694496856407345L, -0.54063532522070301L,  1.4822547119502889L    },
+        };
+
+        return multiply(M_LMSToLinearP3, lms);
+    }
+
+    Triplet linear_display_P3_to_LMS(const Triplet& lrgb)
+    {
+        const auto M_LinearP3ToLMS = Matrix{
+            Triplet{ 0.41569922342211657L,  0.24199222690861918L,  0.07453493016949878L  },
+            Triplet{ 0.4417746176493501L,   0.5550591123439756L,   0.17001346708806345L  },
+            Triplet{ 0.11431238432553265L,  0.17519605565166835L,  0.7282635337867523L   },
+        };
+
+        return multiply(M_LinearP3ToLMS, lrgb);
+    }
+
+    Triplet from_LMS(const Triplet& lms)
+    {
+        const auto M_LMSpToIzazbz = Matrix{
+            Triplet{ 0.5L,  3.524000L,  0.199076L },
+            Triplet{ 0.5L, -4.066708L,  1.096799L },
+            Triplet{ 0.0L,  0.542708L, -1.295875L }
+        };
+
+        auto lmsp = Triplet{};
+
+        for (auto ic = 0; ic < 3; ++ic)
+        {
+            const auto valp     = powl( std::max(lms[ic]/100.0L, 0.0L), n );
+            const auto fraction = (c1 + c2*valp) / (1.0L + c3*valp);
+
+            lmsp[ic] = powl(fraction, p);
+        }
+
+        const auto Izazbz = multiply(M_LMSpToIzazbz, lmsp);
+        const auto Jz     = (1.0L + d) * Izazbz[0] / (1.0L + d*Izazbz[0]) - d0;
+
+        return { Jz, Izazbz[1], Izazbz[2] };
+    }
+
+    bool is_in_gamut(const Triplet& jab)
+    {
+        const auto lrgb = LMS_to_linear_display_P3( convert_to_LMS(jab) );
+
+        return std::all_of( lrgb.begin(), lrgb.end(), [](long double v) { return 0.0L <= v && v <= 1.0L; } );
+    }
+
+    Triplet find_max_chroma_color(long double hue)
+    {
+        const auto target_hue     = (hue < 180.0L) ? hue : hue - 360.0L;
+        const auto target_radians = target_hue * 3.141592653589793238462643383279502884L / 180.0L;
+        const auto edges          = jzazbz::find_max_chroma_edge_P3( static_cast<float>(target_hue) );
+
+        auto lower = Triplet{ edges.lower[0], edges.lower[1], edges.lower[2] };
+        auto upper = Triplet{ edges.upper[0], edges.upper[1], edges.upper[2] };
+
+        for (auto i = 0; i < 96; ++i)
+        {
+            const auto middle = mix(lower, upper, 0.5L);
+            const auto jab    = from_LMS(middle);
+
+            (atan2l(jab[2], jab[1]) <= target_radians ? lower : upper) = middle;
+        }
+
+        return from_LMS(lower);
+    }
+
+    SliceBand solve_slice_band(const Triplet& max_c_jab, long double band_t)
+    {
+        const auto neutral = [&](long double Jz) {
+            return mix( Triplet{ white_Jz * Jz, 0.0L, 0.0L }, max_c_jab, band_t );
+        };
+
+        // • Last in-gamut point from `inside` toward `outside`
+        //
+        const auto bisect = [](Triplet inside, Triplet outside, bool is_lower) {
+
+            for (auto i = 0; i < 96; ++i)
+            {
+                const auto middle = mix(inside, outside, 0.5L);
+                const auto is_in  = is_in_gamut(middle) && (!is_lower || 0.0L <= middle[0]);
+
+                (is_in ? inside : outside) = middle;
+            }
+
+            return inside;
+        };
+
+        return {
+            .low  = bisect( neutral(0.25L), neutral(-0.67L), true ),
+            .high = bisect( neutral(0.67L), neutral(1.33L), false )
+        };
+    }
+
+    long double delta_Ez(const Triplet& jab1, const Triplet& jab2)
+    {
+        const auto C1 = hypotl(jab1[1], jab1[2]);
+        const auto C2 = hypotl(jab2[1], jab2[2]);
+        const auto dh = atan2l(jab2[2], jab2[1]) - atan2l(jab1[2], jab1[1]);
+        const auto dJ = jab2[0] - jab1[0];
+        const auto dC = C2 - C1;
+        const auto dH = 2.0L * sqrtl(C1*C2) * sinl(0.5L*dh);
+
+        return sqrtl(dJ*dJ + dC*dC + dH*dH);
+    }
+
+} // namespace reference
+
+//===------------------------------------------------------------------------===
+// • Default bounds
+//
+//  About twice the errors measured with the default grid, so that a fast
+//  path that gets measurably worse fails. `golden-reference` (Tools/) prints
+//  the measured errors beside these bounds
+//===------------------------------------------------------------------------===
+
+const GoldenParameters default_golden_parameters = {
+    .grid_size  = 33,
+    .hue_count  = 90,
+    .band_count = 64,
+    .bounds     = {
+        .convert_to_LMS                 = { .delta_Ez = 5.0e-5, .ulp = 1000.0 },
+        .LMS_to_linear_display_P3       = { .delta_Ez = 1.0e-7, .ulp = 20.0 },
+        .from_LMS                       = { .delta_Ez = 7.0e-5, .ulp = 10000.0 },
+        .convert_to_linear_display_P3   = { .delta_Ez = 5.0e-5, .ulp = 6000.0 },
+        .convert_from_linear_display_P3 = { .delta_Ez = 7.0e-5, .ulp = 10000.0 },
+        .batch_to_linear_display_P3     = { .delta_Ez = 5.0e-5, .ulp = 6000.0 },
+        .batch_from_linear_display_P3   = { .delta_Ez = 7.0e-5, .ulp = 10000.0 },
+        .find_max_chroma_color          = { .delta_Ez = 6.0e-5, .ulp = 7000.0 },
+        .lane_max_chroma_color          = { .delta_Ez = 6.0e-5, .ulp = 6000.0 },
+        .slice_band                     = { .delta_Ez = 7.0e-5, .ulp = 7000.0 }
+    }
+};
+
+//===------------------------------------------------------------------------===
+// • evaluate_golden_reference
+//===------------------------------------------------------------------------===
+
+std::vector<KernelError> evaluate_golden_reference(const GoldenParameters& parameters)
+{
+    const auto& bounds = parameters.bounds;
+
+    auto to_LMS       = Accumulator("convert_to_LMS",                 bounds.convert_to_LMS);
+    auto to_P3        = Accumulator("LMS_to_linear_display_P3",       bounds.LMS_to_linear_display_P3);
+    auto from_LMS     = Accumulator("from_LMS",                       bounds.from_LMS);
+    auto jab_to_P3    = Accumulator("convert_to_linear_display_P3",   bounds.convert_to_linear_display_P3);
+    auto P3_to_jab    = Accumulator("convert_from_linear_display_P3", bounds.convert_from_linear_display_P3);
+    auto batch_to     = Accumulator("batch_to_linear_display_P3",     bounds.batch_to_linear_display_P3);
+    auto batch_from   = Accumulator("batch_from_linear_display_P3",   bounds.batch_from_linear_display_P3);
+    auto max_chroma   = Accumulator("find_max_chroma_color",          bounds.find_max_chroma_color);
+    auto lane_chroma  = Accumulator("lane_max_chroma_color",          bounds.lane_max_chroma_color);
+    auto slice_band   = Accumulator("slice_band",                     bounds.slice_band);
+
+    // • Conversions over the Display P3 cube; fast paths and the reference
+    //   see the same (rounded) inputs
+    //
+    const auto grid_size = std::max(parameters.grid_size, 2u);
+    const auto scale     = 1.0L / static_cast<long double>(grid_size - 1);
+
+    auto jabs   = std::vector<float>{};
+    auto lrgbs  = std::vector<float>{};
+
+    for (uint32_t ib = 0; ib < grid_size; ++ib)
+    {
+        for (uint32_t ig = 0; ig < grid_size; ++ig)
+        {
+            for (uint32_t ir = 0; ir < grid_size; ++ir)
+            {
+                const auto lrgb = make_float3( Triplet{ ir*scale, ig*scale, ib*scale } );
+                const auto lms  = make_float3( reference::linear_display_P3_to_LMS( make_triplet(lrgb) ) );
+                const auto jab  = make_float3( reference::from_LMS( make_triplet(lms) ) );
+
+                // • Jzazbz to LMS
+                //
+                const auto exact_lms = reference::convert_to_LMS( make_triplet(jab) );
+                const auto fast_lms  = jzazbz::convert_to_LMS(jab);
+
+                to_LMS.add( reference::delta_Ez( reference::from_LMS(exact_lms), reference::from_LMS(make_triplet(fast_lms)) ),
+                            ulp_error(fast_lms, exact_lms) );
+
+                // • LMS to linear Display P3
+                //
+                const auto exact_lrgb = reference::LMS_to_linear_display_P3( make_triplet(lms) );
+                const auto fast_lrgb  = jzazbz::LMS_to_linear_display_P3(lms);
+
+                to_P3.add( reference::delta_Ez( jab_of_linear_display_P3(exact_lrgb), jab_of_linear_display_P3(make_triplet(fast_lrgb)) ),
+                           ulp_error(fast_lrgb, exact_lrgb) );
+
+                // • LMS to Jzazbz
+                //
+                const auto exact_jab = reference::from_LMS( make_triplet(lms) );
+                const auto fast_jab  = jzazbz::from_LMS(lms);
+
+                from_LMS.add( reference::delta_Ez(exact_jab, make_triplet(fast_jab)), ulp_error(fast_jab, exact_jab) );
+
+                // • Composites
+                //
+                const auto exact_to   = reference::LMS_to_linear_display_P3( reference::convert_to_LMS( make_triplet(jab) ) );
+                const auto fast_to    = jzazbz::convert_to_linear_display_P3(jab);
+
+                jab_to_P3.add( reference::delta_Ez( jab_of_linear_display_P3(exact_to), jab_of_linear_display_P3(make_triplet(fast_to)) ),
+                               ulp_error(fast_to, exact_to) );
+
+                const auto exact_from = jab_of_linear_display_P3( make_triplet(lrgb) );
+                const auto fast_from  = jzazbz::convert_from_linear_display_P3(lrgb);
+
+                P3_to_jab.add( reference::delta_Ez(exact_from, make_triplet(fast_from)), ulp_error(fast_from, exact_from) );
+
+                jabs.insert( jabs.end(), { jab[0], jab[1], jab[2] } );
+                lrgbs.insert( lrgbs.end(), { lrgb[0], lrgb[1], lrgb[2] } );
+            }
+        }
+    }
+
+    // • Batch conversions
+    //
+    const auto count = jabs.size() / 3;
+
+    auto batch_lrgbs = std::vector<float>( jabs.size() );
+    auto batch_jabs  = std::vector<float>( lrgbs.size() );
+
+    jzazbz::convert_pixels_to_linear_display_P3(jabs.data(), batch_lrgbs.data(), count);
+    jzazbz::convert_pixels_from_linear_display_P3(lrgbs.data(), batch_jabs.data(), count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto jab       = Triplet{ jabs[3*i],  jabs[3*i+1],  jabs[3*i+2] };
+        const auto lrgb      = Triplet{ lrgbs[3*i], lrgbs[3*i+1], lrgbs[3*i+2] };
+        const auto fast_to   = simd::float3{ batch_lrgbs[3*i], batch_lrgbs[3*i+1], batch_lrgbs[3*i+2] };
+        const auto fast_from = simd::float3{ batch_jabs[3*i],  batch_jabs[3*i+1],  batch_jabs[3*i+2] };
+
+        const auto exact_to   = reference::LMS_to_linear_display_P3( reference::convert_to_LMS(jab) );
+        const auto exact_from = jab_of_linear_display_P3(lrgb);
+
+        batch_to.add( reference::delta_Ez( jab_of_linear_display_P3(exact_to), jab_of_linear_display_P3(make_triplet(fast_to)) ),
+                      ulp_error(fast_to, exact_to) );
+        batch_from.add( reference::delta_Ez(exact_from, make_triplet(fast_from)), ulp_error(fast_from, exact_from) );
+    }
+
+    // • Searches over hues and bands at their default accuracy; slices start
+    //   from the reference max-chroma color
+    //
+    const auto hue_count  = std::max(parameters.hue_count, 1u);
+    const auto band_count = std::max(parameters.band_count, 1u);
+
+    const auto slice = jzazbz::SliceParameters{
+        .band_count = band_count,
+        .lane_count = jzazbz::default_slice_parameters.lane_count,
+        .accuracy   = jzazbz::default_slice_parameters.accuracy
+    };
+
+    for (uint32_t ih = 0; ih < hue_count; ++ih)
+    {
+        const auto hue   = -180.0f + 360.0f * (static_cast<float>(ih) + 0.5f) / static_cast<float>(hue_count);
+        const auto exact = reference::find_max_chroma_color(hue);
+
+        const auto fast = jzazbz::find_max_chroma_color(hue);
+        const auto lane = jzazbz::find_max_chroma_color( hue, jzazbz::default_hue_gradient_parameters.lane_count,
+                                                         jzazbz::default_hue_gradient_parameters.accuracy );
+
+        max_chroma.add( reference::delta_Ez(exact, make_triplet(fast)), ulp_error(fast, exact) );
+        lane_chroma.add( reference::delta_Ez(exact, make_triplet(lane)), ulp_error(lane, exact) );
+
+        const auto max_c_jab = make_float3(exact);
+
+        for (uint32_t band = 0; band < band_count; ++band)
+        {
+            const auto band_t      = static_cast<float>(band) / static_cast<float>(band_count);
+            const auto exact_band  = reference::solve_slice_band( make_triplet(max_c_jab), band_t );
+            const auto fast_band   = jzazbz::solve_slice_band(max_c_jab, band_t, slice);
+
+            slice_band.add( reference::delta_Ez(exact_band.low, make_triplet(fast_band.low)),
+                            ulp_error(fast_band.low, exact_band.low) );
+            slice_band.add( reference::delta_Ez(exact_band.high, make_triplet(fast_band.high)),
+                            ulp_error(fast_band.high, exact_band.high) );
+        }
+    }
+
+    return {
+        to_LMS.result(), to_P3.result(), from_LMS.result(), jab_to_P3.result(), P3_to_jab.result(),
+        batch_to.result(), batch_from.result(), max_chroma.result(), lane_chroma.result(), slice_band.result()
+    };
+}
+
+bool all_passed(const std::vector<KernelError>& errors)
+{
+    return std::all_of( errors.begin(), errors.end(), [](const KernelError& error) { return error.passed; } );
+}
+
+std::string format_error_report(const std::vector<KernelError>& errors)
+{
+    auto report = std::string{};
+    char line[256];
+
+    snprintf( line, sizeof(line), "%-32s %10s %12s %12s %12s %12s %12s %12s  %s\n",
+              "kernel", "samples", "max dEz", "mean dEz", "bound dEz", "max ULP", "mean ULP", "bound ULP", "result" );
+
+    report += line;
+
+    for (const auto& error : errors)
+    {
+        snprintf( line, sizeof(line), "%-32s %10llu %12.3e %12.3e %12.3e %12.1f %12.2f %12.1f  %s\n",
+                  error.kernel, static_cast<unsigned long long>(error.sample_count),
+                  error.max_delta_Ez, error.mean_delta_Ez, error.bound.delta_Ez,
+                  error.max_ulp, error.mean_ulp, error.bound.ulp,
+                  error.passed ? "pass" : "FAIL" );
+
+        report += line;
+    }
+
+    return report;
+}
+
+} // namespace validation
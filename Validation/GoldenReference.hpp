@@ -0,0 +1,145 @@
+//
+//  GoldenReference.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Reference color math (long double)
+//
+//  Transcriptions of the Graphics/Jzazbz.hpp kernels, with the same constants
+//  and clamps but no single-precision rounding, and the max-chroma and slice
+//  searches solved by bisection to convergence rather than to an accuracy.
+//
+//===------------------------------------------------------------------------===
+
+using Triplet = std::array<long double, 3>;
+
+namespace reference
+{
+    Triplet convert_to_LMS(const Triplet& jab);
+    Triplet LMS_to_linear_display_P3(const Triplet& lms);
+    Triplet linear_display_P3_to_LMS(const Triplet& lrgb);
+    Triplet from_LMS(const Triplet& lms);
+
+    bool is_in_gamut(const Triplet& jab);
+
+    Triplet find_max_chroma_color(long double hue);
+
+    struct SliceBand
+    {
+        Triplet     low;
+        Triplet     high;
+    };
+
+    // • The boundary points on the `generate_vertices` brackets of the band
+    //   at `band_t` toward `max_c_jab`
+    //
+    SliceBand solve_slice_band(const Triplet& max_c_jab, long double band_t);
+
+    // • Jzazbz color difference (Safdar et al. 2017)
+    //
+    long double delta_Ez(const Triplet& jab1, const Triplet& jab2);
+
+} // namespace reference
+
+//===------------------------------------------------------------------------===
+//
+// • Golden reference evaluation
+//
+//  Runs every single-precision fast path (the Jzazbz kernels, the batch
+//  conversions and the bracket searches at their default accuracy) over a
+//  dense grid and reports the max and mean ΔEz and ULP error against the
+//  reference, each checked against an allowed bound. Inputs are a grid over
+//  the Display P3 cube for the conversions, and hues × bands for the
+//  searches.
+//
+//  ΔEz compares both outputs after mapping them to Jzazbz with the
+//  reference. ULP error is the largest component difference in units of
+//  the float ULP of the reference's largest component magnitude (at least
+//  2^-6), which keeps near-zero outputs (neutral az, bz; black) from
+//  dominating.
+//
+//===------------------------------------------------------------------------===
+
+struct ErrorBound
+{
+    double      delta_Ez;
+    double      ulp;
+};
+
+struct GoldenBounds
+{
+    ErrorBound  convert_to_LMS;
+    ErrorBound  LMS_to_linear_display_P3;
+    ErrorBound  from_LMS;
+    ErrorBound  convert_to_linear_display_P3;
+    ErrorBound  convert_from_linear_display_P3;
+    ErrorBound  batch_to_linear_display_P3;
+    ErrorBound  batch_from_linear_display_P3;
+    ErrorBound  find_max_chroma_color;
+    ErrorBound  lane_max_chroma_color;
+    ErrorBound  slice_band;
+};
+
+struct GoldenParameters
+{
+    uint32_t        grid_size;      // samples per Display P3 axis
+    uint32_t        hue_count;
+    uint32_t        band_count;
+    GoldenBounds    bounds;
+};
+
+extern const GoldenParameters default_golden_parameters;
+
+struct KernelError
+{
+    const char* kernel;
+    uint64_t    sample_count;
+
+    double      max_delta_Ez;
+    double      mean_delta_Ez;
+    double      max_ulp;
+    double      mean_ulp;
+
+    ErrorBound  bound;
+    bool        passed;
+};
+
+std::vector<KernelError> evaluate_golden_reference(const GoldenParameters& parameters = default_golden_parameters);
+
+bool all_passed(const std::vector<KernelError>& errors);
+
+// • One line per kernel: measured errors, bounds and result
+//
+std::string format_error_report(const std::vector<KernelError>& errors);
+
+} // namespace validation
@@ -0,0 +1,209 @@
+//
+//  HueSweepAnalysis.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/HueSweepAnalysis.hpp>
+#include <Graphics/GamutSlice.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    // • (Cz, Jz)
+    //
+    simd::float2 slice_plane(simd::float4 vertex)
+    {
+        return simd::float2{ sqrtf(vertex[1]*vertex[1] + vertex[2]*vertex[2]), vertex[0] };
+    }
+
+    // • Area, Jz extent and centroid of the slice polygon: the low boundary
+    //   from neutral out to the cusp, then the high boundary back
+    //
+    void measure_slice(const simd::float4* vertices, uint32_t band_count, HueSweepRecord& record)
+    {
+        const auto apex  = 2*band_count;
+        const auto point = [&](uint32_t i) {
+            return slice_plane( vertices[ (i < band_count) ? 2*i
+                                        : (i == band_count) ? apex
+                                        : 2*(2*band_count - i) + 1 ] );
+        };
+
+        const auto count = 2*band_count + 1;
+
+        auto area     = 0.0;
+        auto moment   = simd::double2{ 0.0, 0.0 };
+        auto min_Jz   = vertices[0][0];
+        auto max_Jz   = vertices[0][0];
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto p     = point(i);
+            const auto q     = point( (i + 1) % count );
+            const auto cross = static_cast<double>(p.x) * q.y - static_cast<double>(q.x) * p.y;
+
+            area     += cross;
+            moment.x += (static_cast<double>(p.x) + q.x) * cross;
+            moment.y += (static_cast<double>(p.y) + q.y) * cross;
+
+            min_Jz = std::min(min_Jz, p.y);
+            max_Jz = std::max(max_Jz, p.y);
+        }
+
+        area *= 0.5;
+
+        record.slice_area        = static_cast<float>( fabs(area) );
+        record.slice_min_Jz      = min_Jz;
+        record.slice_max_Jz      = max_Jz;
+        record.slice_centroid_Cz = (0.0 != area) ? static_cast<float>( moment.x / (6.0 * area) ) : 0.0f;
+        record.slice_centroid_Jz = (0.0 != area) ? static_cast<float>( moment.y / (6.0 * area) ) : 0.0f;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • Analysis
+//===------------------------------------------------------------------------===
+
+HueSweepRecord analyze_hue(float hue, const HueSweepParameters& parameters, simd::float4* vertices)
+{
+    const auto reduced   = fmodf(hue, 360.0f);
+    const auto max_c_jab = jzazbz::find_max_chroma_color( (reduced < 0.0f) ? reduced + 360.0f : reduced,
+                                                          parameters.accuracy );
+    const auto max_c_rgb = jzazbz::convert_to_linear_display_P3(max_c_jab);
+
+    auto record = HueSweepRecord{
+        .hue               = hue,
+        .max_c_Jz          = max_c_jab[0],
+        .max_c_az          = max_c_jab[1],
+        .max_c_bz          = max_c_jab[2],
+        .cusp_Jz           = max_c_jab[0],
+        .cusp_Cz           = sqrtf(max_c_jab[1]*max_c_jab[1] + max_c_jab[2]*max_c_jab[2]),
+        .max_c_red         = max_c_rgb[0],
+        .max_c_green       = max_c_rgb[1],
+        .max_c_blue        = max_c_rgb[2],
+        .slice_area        = 0.0f,
+        .slice_min_Jz      = 0.0f,
+        .slice_max_Jz      = 0.0f,
+        .slice_centroid_Cz = 0.0f,
+        .slice_centroid_Jz = 0.0f
+    };
+
+    if (0 < parameters.band_count)
+    {
+        const auto slice = jzazbz::SliceParameters{
+            .band_count = parameters.band_count,
+            .lane_count = parameters.lane_count,
+            .accuracy   = parameters.accuracy
+        };
+
+        jzazbz::generate_slice_vertices(max_c_jab, vertices, slice);
+
+        measure_slice(vertices, parameters.band_count, record);
+    }
+
+    return record;
+}
+
+void run_hue_sweep(const HueSweepParameters& parameters,
+                   const HueSweepHandler&    handler,
+                   utilities::ThreadPool&    pool)
+{
+    const auto block_size   = std::max(parameters.block_size, 1u);
+    const auto batch_size   = block_size * pool.concurrency() * 4;
+    const auto vertex_count = jzazbz::slice_vertex_count(parameters.band_count);
+
+    auto records = std::vector<HueSweepRecord>( std::min(batch_size, parameters.hue_count) );
+
+    for (uint32_t first = 0; first < parameters.hue_count; first += batch_size)
+    {
+        const auto count       = std::min(batch_size, parameters.hue_count - first);
+        const auto block_count = (count + block_size - 1) / block_size;
+
+        pool.parallel_for( block_count, [&](uint32_t ib) {
+
+            auto       vertices = std::vector<simd::float4>(vertex_count);
+            const auto begin    = ib * block_size;
+            const auto end      = std::min(begin + block_size, count);
+
+            for (auto i = begin; i < end; ++i)
+            {
+                records[i] = analyze_hue( hue_sweep_hue(parameters, first + i), parameters, vertices.data() );
+            }
+        });
+
+        handler(first, records.data(), count);
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • Output
+//===------------------------------------------------------------------------===
+
+HueSweepFileHeader make_hue_sweep_file_header(const HueSweepParameters& parameters) noexcept
+{
+    return {
+        .magic       = { 'H', 'S', 'W', 'P' },
+        .version     = 1,
+        .record_size = sizeof(HueSweepRecord),
+        .hue_count   = parameters.hue_count,
+        .first_hue   = parameters.first_hue,
+        .band_count  = parameters.band_count,
+        .lane_count  = parameters.lane_count,
+        .accuracy    = parameters.accuracy
+    };
+}
+
+const char* const hue_sweep_csv_header =
+    "hue,max_c_Jz,max_c_az,max_c_bz,cusp_Jz,cusp_Cz,max_c_red,max_c_green,max_c_blue,"
+    "slice_area,slice_min_Jz,slice_max_Jz,slice_centroid_Cz,slice_centroid_Jz\n";
+
+void append_hue_sweep_csv(std::string& text, const HueSweepRecord* records, uint32_t count)
+{
+    char line[320];
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const auto& r = records[i];
+
+        // • %.9g round-trips a float
+        //
+        snprintf(line, sizeof(line),
+                 "%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+                 r.hue, r.max_c_Jz, r.max_c_az, r.max_c_bz, r.cusp_Jz, r.cusp_Cz,
+                 r.max_c_red, r.max_c_green, r.max_c_blue,
+                 r.slice_area, r.slice_min_Jz, r.slice_max_Jz, r.slice_centroid_Cz, r.slice_centroid_Jz);
+
+        text += line;
+    }
+}
+
+} // namespace validation
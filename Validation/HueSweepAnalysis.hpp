@@ -0,0 +1,137 @@
+//
+//  HueSweepAnalysis.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Graphics/Jzazbz.hpp>
+#include <Utilities/ThreadPool.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Hue sweep analysis
+//
+//  Max chroma color, cusp and gamut slice statistics at `hue_count` evenly
+//  spaced hues from `first_hue` around the circle. Hues are solved in blocks
+//  of `block_size`, a pool's worth of blocks at a time, and handed over in
+//  order so that memory stays bounded for any resolution. A band_count of 0
+//  skips the slices.
+//
+//  On the CPU each lane costs a full evaluation, so a few lanes (more,
+//  cheaper iterations) solve slices several times faster than the 32 of the
+//  GPU kernel at the same accuracy.
+//
+//===------------------------------------------------------------------------===
+
+struct HueSweepParameters
+{
+    uint32_t    hue_count;
+    float       first_hue;          // degrees
+    uint32_t    band_count;         // slice bands, 0 for max chroma only
+    uint32_t    lane_count;         // slice search lanes, at least 2
+    float       accuracy;           // both searches, Jzazbz units
+    uint32_t    block_size;         // hues per parallel task
+};
+
+constexpr HueSweepParameters default_hue_sweep_parameters = {
+    .hue_count  = 1'000'000,
+    .first_hue  = 0.0f,
+    .band_count = 16,
+    .lane_count = 4,
+    .accuracy   = jzazbz::default_search_accuracy,
+    .block_size = 256
+};
+
+// • One hue. Slice statistics are in the (Cz, Jz) plane of the slice
+//   polygon (bands from neutral to the cusp, as `generate_vertices`)
+//
+struct HueSweepRecord
+{
+    float       hue;                // degrees
+    float       max_c_Jz;           // max chroma color, Jzazbz
+    float       max_c_az;
+    float       max_c_bz;
+    float       cusp_Jz;            // = max_c_Jz
+    float       cusp_Cz;
+    float       max_c_red;          // max chroma color, linear Display P3
+    float       max_c_green;
+    float       max_c_blue;
+    float       slice_area;         // Jz × Cz
+    float       slice_min_Jz;
+    float       slice_max_Jz;
+    float       slice_centroid_Cz;
+    float       slice_centroid_Jz;
+};
+
+static_assert( sizeof(HueSweepRecord) == 14 * sizeof(float), "Unexpected layout" );
+
+constexpr float hue_sweep_hue(const HueSweepParameters& parameters, uint32_t index) noexcept
+{
+    return static_cast<float>( parameters.first_hue + (360.0 * index) / parameters.hue_count );
+}
+
+HueSweepRecord analyze_hue(float hue, const HueSweepParameters& parameters, simd::float4* vertices);
+
+// • Records [first, first + count) in order, on the calling thread; the
+//   pointer is only valid during the call
+//
+using HueSweepHandler = std::function<void (uint32_t first, const HueSweepRecord* records, uint32_t count)>;
+
+void run_hue_sweep(const HueSweepParameters& parameters,
+                   const HueSweepHandler&    handler,
+                   utilities::ThreadPool&    pool = utilities::ThreadPool::shared());
+
+//===------------------------------------------------------------------------===
+//
+// • Output
+//
+//  CSV with a header line, or a binary file: HueSweepFileHeader followed by
+//  hue_count packed little-endian HueSweepRecords.
+//
+//===------------------------------------------------------------------------===
+
+struct HueSweepFileHeader
+{
+    char        magic[4];           // "HSWP"
+    uint32_t    version;            // 1
+    uint32_t    record_size;        // bytes
+    uint32_t    hue_count;
+    float       first_hue;
+    uint32_t    band_count;
+    uint32_t    lane_count;
+    float       accuracy;
+};
+
+HueSweepFileHeader make_hue_sweep_file_header(const HueSweepParameters& parameters) noexcept;
+
+extern const char* const hue_sweep_csv_header;
+
+void append_hue_sweep_csv(std::string& text, const HueSweepRecord* records, uint32_t count);
+
+} // namespace validation
@@ -0,0 +1,435 @@
+//
+//  RoundTripFuzzer.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/RoundTripFuzzer.hpp>
+#include <Graphics/Jzazbz.hpp>
+#include <Graphics/JzazbzBatch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    using Clock   = std::chrono::steady_clock;
+    using Regions = std::array<FuzzRegionReport, static_cast<size_t>(FuzzRegion::count)>;
+
+    // • LMS' range of convert_to_LMS
+    //
+    constexpr auto minLMSp = jzazbz::min_LMSp();
+    constexpr auto maxLMSp = jzazbz::max_LMSp();
+
+    // • splitmix64
+    //
+    class Random
+    {
+    public:
+
+        explicit Random(uint64_t seed) : state_( seed ) {}
+
+        uint64_t next(void) noexcept
+        {
+            auto z = (state_ += 0x9e3779b97f4a7c15ull);
+
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+            return z ^ (z >> 31);
+        }
+
+        float uniform(float lower, float upper) noexcept
+        {
+            return lower + (upper - lower) * static_cast<float>(next() >> 40) * 0x1.0p-24f;
+        }
+
+    private:
+
+        uint64_t state_;
+    };
+
+    // • One LMS' component: around minLMSp (both sides), around maxLMSp,
+    //   log-uniform down to the scale of d0, or uniform
+    //
+    float make_LMSp_component(Random& random)
+    {
+        switch ( random.next() & 3 )
+        {
+            case 0:  return minLMSp * random.uniform(-1.0f, 3.0f);
+            case 1:  return maxLMSp * random.uniform(0.98f, 1.02f);
+            case 2:  return exp2f( random.uniform(-36.0f, 0.0f) );
+            default: return random.uniform(0.0f, maxLMSp);
+        }
+    }
+
+    // • Iz = (L' + M') / 2 at most 1, i.e. Jz within [0, 1]: the PQ range, and
+    //   well short of the pole of Jz at Iz = 1 / 0.56
+    //
+    simd::float3 make_LMSp(Random& random)
+    {
+        for (;;)
+        {
+            const auto lmsp = simd::float3{ make_LMSp_component(random),
+                                            make_LMSp_component(random),
+                                            make_LMSp_component(random) };
+
+            if (lmsp[0] + lmsp[1] <= 2.0f)
+            {
+                return lmsp;
+            }
+        }
+    }
+
+    // • In the cube, on or next to its faces, or beyond it
+    //
+    simd::float3 make_lrgb(Random& random)
+    {
+        auto lrgb = simd::float3{};
+
+        switch ( random.next() % 3 )
+        {
+            case 0:
+                for (auto ic = 0; ic < 3; ++ic)
+                {
+                    lrgb[ic] = random.uniform(0.0f, 1.0f);
+                }
+                break;
+
+            case 1:
+                for (auto ic = 0; ic < 3; ++ic)
+                {
+                    const auto face = static_cast<float>( random.next() & 1 );
+
+                    lrgb[ic] = (0 == (random.next() & 1)) ? face + random.uniform(-1.0e-4f, 1.0e-4f)
+                                                          : random.uniform(0.0f, 1.0f);
+                }
+                break;
+
+            default:
+                for (auto ic = 0; ic < 3; ++ic)
+                {
+                    lrgb[ic] = random.uniform(-0.25f, 1.5f);
+                }
+                break;
+        }
+
+        return lrgb;
+    }
+
+    FuzzRegion classify_jab(simd::float3 jab)
+    {
+        const auto lmsp = jzazbz::LMSp_of_jab(jab);
+
+        if ( simd::any(lmsp < simd::float3(minLMSp)) )
+        {
+            return FuzzRegion::jab_clamped_low;
+        }
+
+        if ( simd::any(simd::float3(maxLMSp) < lmsp) )
+        {
+            return FuzzRegion::jab_clamped_high;
+        }
+
+        return (fabsf(jab[0]) < 1.0e-6f) ? FuzzRegion::jab_near_black : FuzzRegion::jab_interior;
+    }
+
+    FuzzRegion classify_lrgb(simd::float3 lrgb)
+    {
+        const auto lms = jzazbz::linear_display_P3_to_LMS(lrgb);
+
+        if ( simd::any(lms < simd::float3(0.0f)) )
+        {
+            return FuzzRegion::lrgb_negative_LMS;
+        }
+
+        if ( simd::any(lrgb < simd::float3(0.0f)) || simd::any(simd::float3(1.0f) < lrgb) )
+        {
+            return FuzzRegion::lrgb_extended;
+        }
+
+        const auto to_face = simd::min( lrgb, simd::float3(1.0f) - lrgb );
+
+        return simd::any(to_face < simd::float3(1.0e-3f)) ? FuzzRegion::lrgb_edge : FuzzRegion::lrgb_interior;
+    }
+
+    bool is_finite(simd::float3 v)
+    {
+        return std::isfinite(v[0]) && std::isfinite(v[1]) && std::isfinite(v[2]);
+    }
+
+    float max_difference(simd::float3 lhs, simd::float3 rhs)
+    {
+        return simd::reduce_max( simd::abs(lhs - rhs) );
+    }
+
+    // • Round trips of interleaved triplets in place, through the batch kernels
+    //
+    void jab_round_trip(float* triplets, size_t count)
+    {
+        jzazbz::convert_pixels_to_LMS(triplets, triplets, count);
+        jzazbz::convert_pixels_from_LMS(triplets, triplets, count);
+    }
+
+    void lrgb_round_trip(float* triplets, size_t count)
+    {
+        jzazbz::convert_pixels_from_linear_display_P3(triplets, triplets, count);
+        jzazbz::convert_pixels_to_linear_display_P3(triplets, triplets, count);
+    }
+
+    simd::float3 triplet(const std::vector<float>& triplets, size_t i)
+    {
+        return { triplets[3*i], triplets[3*i + 1], triplets[3*i + 2] };
+    }
+
+    void record(Regions& regions, FuzzRegion region, simd::float3 input, bool is_finite, float error, float tolerance)
+    {
+        auto& report = regions[ static_cast<size_t>(region) ];
+
+        ++report.sample_count;
+
+        if ( !is_finite || tolerance < error )
+        {
+            ++report.failure_count;
+        }
+
+        if ( is_finite && report.max_error < error )
+        {
+            report.max_error   = error;
+            report.worst_input = input;
+        }
+    }
+
+    // • Round-trip `inputs` in one batch, and the results of samples in
+    //   projecting regions a second time in another, then check each sample
+    //   against its region's property
+    //
+    template <typename RoundTrip_, typename Classify_, typename IsProjecting_>
+    void check_round_trips(const std::vector<simd::float3>& inputs,
+                           RoundTrip_                       round_trip,
+                           Classify_                        classify,
+                           IsProjecting_                    is_projecting,
+                           float                            tolerance,
+                           Regions&                         regions)
+    {
+        const auto count = inputs.size();
+
+        auto sample_regions = std::vector<FuzzRegion>(count);
+        auto once           = std::vector<float>(3 * count);
+        auto twice          = std::vector<float>{};
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            sample_regions[i] = classify(inputs[i]);
+
+            std::copy_n( &inputs[i][0], 3, once.data() + 3*i );
+        }
+
+        round_trip(once.data(), count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if ( is_projecting(sample_regions[i]) )
+            {
+                twice.insert( twice.end(), once.begin() + 3*i, once.begin() + 3*i + 3 );
+            }
+        }
+
+        round_trip( twice.data(), twice.size() / 3 );
+
+        auto projected = size_t{ 0 };
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto input  = inputs[i];
+            const auto region = sample_regions[i];
+            const auto first  = triplet(once, i);
+
+            if ( is_projecting(region) )
+            {
+                const auto second = triplet(twice, projected++);
+
+                record( regions, region, input, is_finite(first) && is_finite(second),
+                        max_difference(second, first), tolerance );
+            }
+            else
+            {
+                const auto scale = std::max( 1.0f, simd::reduce_max( simd::abs(input) ) );
+
+                record( regions, region, input, is_finite(first), max_difference(first, input) / scale, tolerance );
+            }
+        }
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • fuzz_region_name
+//===------------------------------------------------------------------------===
+
+const char* fuzz_region_name(FuzzRegion region)
+{
+    switch (region)
+    {
+        case FuzzRegion::jab_interior:      return "jab interior";
+        case FuzzRegion::jab_near_black:    return "jab near black (d0)";
+        case FuzzRegion::jab_clamped_low:   return "jab clamped at minLMSp";
+        case FuzzRegion::jab_clamped_high:  return "jab clamped at maxLMSp";
+        case FuzzRegion::lrgb_interior:     return "P3 interior";
+        case FuzzRegion::lrgb_edge:         return "P3 cube faces";
+        case FuzzRegion::lrgb_extended:     return "P3 extended, LMS > 0";
+        case FuzzRegion::lrgb_negative_LMS: return "P3 extended, LMS < 0";
+        default:                            return "";
+    }
+}
+
+//===------------------------------------------------------------------------===
+// • run_round_trip_fuzzer
+//===------------------------------------------------------------------------===
+
+FuzzReport run_round_trip_fuzzer(const FuzzParameters& parameters, utilities::ThreadPool& pool)
+{
+    const auto block_size  = std::max(parameters.block_size, 2u);
+    const auto block_count = static_cast<uint32_t>( (parameters.sample_count + block_size - 1) / block_size );
+
+    // • Per-block results, merged afterwards
+    //
+    auto block_regions = std::vector<Regions>( block_count, Regions{} );
+
+    const auto start = Clock::now();
+
+    pool.parallel_for( block_count, [&](uint32_t ib) {
+
+        auto& regions = block_regions[ib];
+        auto  random  = Random( parameters.seed ^ (uint64_t{ ib } * 0xd1b54a32d192ed03ull) );
+
+        const auto first  = uint64_t{ ib } * block_size;
+        const auto count  = std::min<uint64_t>(block_size, parameters.sample_count - first);
+        const auto half   = static_cast<size_t>(count / 2);
+
+        // • Jzazbz half (drawn in LMS') and linear Display P3 half, each
+        //   round-tripped through the batch kernels
+        //
+        auto jabs  = std::vector<simd::float3>(half);
+        auto lrgbs = std::vector<simd::float3>( static_cast<size_t>(count) - half );
+
+        for (auto& jab : jabs)
+        {
+            jab = jzazbz::jab_of_LMSp( make_LMSp(random) );
+        }
+
+        for (auto& lrgb : lrgbs)
+        {
+            lrgb = make_lrgb(random);
+        }
+
+        check_round_trips( jabs, jab_round_trip, classify_jab, [](FuzzRegion region) {
+            return FuzzRegion::jab_clamped_low == region || FuzzRegion::jab_clamped_high == region;
+        }, parameters.jab_tolerance, regions );
+
+        check_round_trips( lrgbs, lrgb_round_trip, classify_lrgb, [](FuzzRegion region) {
+            return FuzzRegion::lrgb_negative_LMS == region;
+        }, parameters.lrgb_tolerance, regions );
+    });
+
+    auto report = FuzzReport{
+        .regions            = {},
+        .sample_count       = 0,
+        .failure_count      = 0,
+        .seconds            = std::chrono::duration<double>(Clock::now() - start).count(),
+        .samples_per_second = 0.0
+    };
+
+    for (const auto& regions : block_regions)
+    {
+        for (size_t ir = 0; ir < regions.size(); ++ir)
+        {
+            auto&       merged = report.regions[ir];
+            const auto& block  = regions[ir];
+
+            merged.sample_count  += block.sample_count;
+            merged.failure_count += block.failure_count;
+
+            if (merged.max_error < block.max_error)
+            {
+                merged.max_error   = block.max_error;
+                merged.worst_input = block.worst_input;
+            }
+
+            report.sample_count  += block.sample_count;
+            report.failure_count += block.failure_count;
+        }
+    }
+
+    report.samples_per_second = static_cast<double>(report.sample_count) / std::max(report.seconds, 1.0e-9);
+
+    return report;
+}
+
+//===------------------------------------------------------------------------===
+// • format_fuzz_report
+//===------------------------------------------------------------------------===
+
+std::string format_fuzz_report(const FuzzReport& report)
+{
+    auto text = std::string{};
+    char line[256];
+
+    snprintf( line, sizeof(line), "%-26s %12s %8s %10s %12s  %s\n",
+              "region", "samples", "share", "failures", "max error", "worst input" );
+
+    text += line;
+
+    for (size_t ir = 0; ir < report.regions.size(); ++ir)
+    {
+        const auto& region = report.regions[ir];
+        const auto  share  = 100.0 * static_cast<double>(region.sample_count)
+                                   / static_cast<double>( std::max(report.sample_count, uint64_t{ 1 }) );
+
+        snprintf( line, sizeof(line), "%-26s %12llu %7.2f%% %10llu %12.3e  (%.9g, %.9g, %.9g)\n",
+                  fuzz_region_name( static_cast<FuzzRegion>(ir) ),
+                  static_cast<unsigned long long>(region.sample_count), share,
+                  static_cast<unsigned long long>(region.failure_count), region.max_error,
+                  region.worst_input[0], region.worst_input[1], region.worst_input[2] );
+
+        text += line;
+    }
+
+    snprintf( line, sizeof(line), "%llu samples, %llu failures in %.3f s (%.2f M samples/s)\n",
+              static_cast<unsigned long long>(report.sample_count),
+              static_cast<unsigned long long>(report.failure_count),
+              report.seconds, report.samples_per_second * 1.0e-6 );
+
+    text += line;
+
+    return text;
+}
+
+} // namespace validation
@@ -0,0 +1,125 @@
+//
+//  RoundTripFuzzer.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <Utilities/ThreadPool.hpp>
+#include <simd/simd.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Round-trip property fuzzer
+//
+//  Random samples in blocks, run in parallel and pushed through the batch
+//  kernels a block at a time. Each sample is classified by domain region and
+//  checked against that region's property:
+//
+//  - Jzazbz whose LMS' lies inside [minLMSp, maxLMSp], including Jz within
+//    a few d0 of zero: from_LMS(convert_to_LMS(x)) is within jab_tolerance
+//    of x (relative above 1; az and bz reach 6 at the clamp edges).
+//  - Jzazbz clamped at minLMSp or maxLMSp: the round trip projects, so it
+//    must be finite and idempotent (a second trip moves it by no more than
+//    jab_tolerance).
+//  - Linear Display P3 in the cube, on its faces and beyond it while LMS
+//    stays positive: the round trip through Jzazbz is within lrgb_tolerance
+//    (relative above 1).
+//  - Linear Display P3 with a negative LMS component (clipped by from_LMS):
+//    finite and idempotent.
+//
+//  Jzazbz inputs are drawn in LMS' space, with components concentrated at
+//  the clamp edges and near zero, so the clamps and the d0 offset are hit
+//  directly, and limited to Iz <= 1 (Jz <= 1, the PQ range). Failures are
+//  counted per region along with the worst input.
+//
+//===------------------------------------------------------------------------===
+
+enum class FuzzRegion : uint32_t
+{
+    jab_interior,
+    jab_near_black,
+    jab_clamped_low,
+    jab_clamped_high,
+    lrgb_interior,
+    lrgb_edge,
+    lrgb_extended,
+    lrgb_negative_LMS,
+    count
+};
+
+const char* fuzz_region_name(FuzzRegion region);
+
+struct FuzzParameters
+{
+    uint64_t    sample_count;
+    uint64_t    seed;
+    uint32_t    block_size;     // samples per task
+    float       jab_tolerance;  // Jzazbz units
+    float       lrgb_tolerance;
+};
+
+constexpr FuzzParameters default_fuzz_parameters = {
+    .sample_count   = 1 << 24,
+    .seed           = 0x9e3779b97f4a7c15ull,
+    .block_size     = 1 << 14,
+    .jab_tolerance  = 2.0e-4f,
+    .lrgb_tolerance = 2.0e-3f
+};
+
+struct FuzzRegionReport
+{
+    uint64_t        sample_count;
+    uint64_t        failure_count;
+    float           max_error;      // finite samples only
+    simd::float3    worst_input;
+};
+
+struct FuzzReport
+{
+    std::array<FuzzRegionReport, static_cast<size_t>(FuzzRegion::count)> regions;
+
+    uint64_t    sample_count;
+    uint64_t    failure_count;
+    double      seconds;
+    double      samples_per_second;
+
+    bool passed(void) const noexcept
+    {
+        return 0 == failure_count;
+    }
+};
+
+FuzzReport run_round_trip_fuzzer(const FuzzParameters&  parameters = default_fuzz_parameters,
+                                 utilities::ThreadPool& pool       = utilities::ThreadPool::shared());
+
+// • Coverage (samples per region), failures and throughput, one line per region
+//
+std::string format_fuzz_report(const FuzzReport& report);
+
+} // namespace validation
@@ -0,0 +1,156 @@
+//
+//  SearchBenchmark.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <Validation/SearchBenchmark.hpp>
+#include <Graphics/GamutSlice.hpp>
+#include <Graphics/HueGradient.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    float hue_at(uint32_t index, uint32_t hue_count)
+    {
+        return -180.0f + 360.0f * (static_cast<float>(index) + 0.5f) / static_cast<float>(hue_count);
+    }
+
+    // • Fastest of `repeat_count` runs of `function`, in seconds
+    //
+    template <class Function_>
+    double time_fastest(uint32_t repeat_count, Function_&& function)
+    {
+        auto fastest = std::numeric_limits<double>::max();
+
+        for (uint32_t i = 0; i < std::max(repeat_count, 1u); ++i)
+        {
+            const auto start = Clock::now();
+
+            function();
+
+            fastest = std::min( fastest, std::chrono::duration<double>(Clock::now() - start).count() );
+        }
+
+        return fastest;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • benchmark_search_accuracy
+//===------------------------------------------------------------------------===
+
+std::vector<SearchBenchmarkResult> benchmark_search_accuracy(const std::vector<float>&        accuracies,
+                                                             const SearchBenchmarkParameters& parameters)
+{
+    const auto hue_count    = std::max(parameters.hue_count, 1u);
+    const auto vertex_count = jzazbz::slice_vertex_count(parameters.band_count);
+
+    const auto slice_parameters = [&](float accuracy) {
+
+        return jzazbz::SliceParameters{
+            .band_count = parameters.band_count,
+            .lane_count = parameters.lane_count,
+            .accuracy   = accuracy
+        };
+    };
+
+    // • Reference solutions; slices share the reference max-chroma colors so
+    //   that only the slice search differs
+    //
+    auto reference_colors   = std::vector<simd::float3>(hue_count);
+    auto reference_vertices = std::vector<simd::float4>(hue_count * vertex_count);
+
+    for (uint32_t ih = 0; ih < hue_count; ++ih)
+    {
+        reference_colors[ih] = jzazbz::find_max_chroma_color( hue_at(ih, hue_count), parameters.lane_count,
+                                                              parameters.reference_accuracy );
+
+        jzazbz::generate_slice_vertices( reference_colors[ih], reference_vertices.data() + ih*vertex_count,
+                                         slice_parameters(parameters.reference_accuracy) );
+    }
+
+    // • Sweep
+    //
+    auto results  = std::vector<SearchBenchmarkResult>{};
+    auto colors   = std::vector<simd::float3>(hue_count);
+    auto vertices = std::vector<simd::float4>(hue_count * vertex_count);
+
+    for (const auto accuracy : accuracies)
+    {
+        auto result = SearchBenchmarkResult{
+            .accuracy                   = accuracy,
+            .slice_iteration_count      = jzazbz::slice_iteration_count(accuracy, parameters.lane_count),
+            .slice_seconds              = 0.0,
+            .slice_error                = 0.0f,
+            .max_chroma_iteration_count = jzazbz::max_chroma_iteration_count(accuracy, parameters.lane_count),
+            .max_chroma_seconds         = 0.0,
+            .max_chroma_error           = 0.0f
+        };
+
+        result.max_chroma_seconds = time_fastest( parameters.repeat_count, [&] {
+
+            for (uint32_t ih = 0; ih < hue_count; ++ih)
+            {
+                colors[ih] = jzazbz::find_max_chroma_color( hue_at(ih, hue_count), parameters.lane_count, accuracy );
+            }
+        });
+
+        result.slice_seconds = time_fastest( parameters.repeat_count, [&] {
+
+            for (uint32_t ih = 0; ih < hue_count; ++ih)
+            {
+                jzazbz::generate_slice_vertices( reference_colors[ih], vertices.data() + ih*vertex_count,
+                                                 slice_parameters(accuracy) );
+            }
+        });
+
+        for (uint32_t ih = 0; ih < hue_count; ++ih)
+        {
+            result.max_chroma_error = std::max( result.max_chroma_error,
+                                                simd::length(colors[ih] - reference_colors[ih]) );
+        }
+
+        for (size_t iv = 0; iv < vertices.size(); ++iv)
+        {
+            result.slice_error = std::max( result.slice_error,
+                                           simd::length(vertices[iv] - reference_vertices[iv]) );
+        }
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+} // namespace validation
@@ -0,0 +1,78 @@
+//
+//  SearchBenchmark.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Bracket search accuracy benchmark
+//
+//  Sweeps the target accuracy of the lane-parallel searches against time:
+//  for each accuracy, slices (generate_slice_vertices) and max-chroma colors
+//  (find_max_chroma_color, lane-parallel) are solved at `hue_count` hues on
+//  the calling thread. Errors are the largest Jzazbz distance from a
+//  reference solved at `reference_accuracy`.
+//
+//===------------------------------------------------------------------------===
+
+struct SearchBenchmarkParameters
+{
+    uint32_t    hue_count;
+    uint32_t    band_count;
+    uint32_t    lane_count;
+    uint32_t    repeat_count;       // timings are the fastest of repeats
+    float       reference_accuracy;
+};
+
+constexpr SearchBenchmarkParameters default_search_benchmark_parameters = {
+    .hue_count          = 90,
+    .band_count         = 64,
+    .lane_count         = 32,
+    .repeat_count       = 3,
+    .reference_accuracy = 1.0e-8f
+};
+
+struct SearchBenchmarkResult
+{
+    float       accuracy;
+
+    uint32_t    slice_iteration_count;
+    double      slice_seconds;      // all hues
+    float       slice_error;
+
+    uint32_t    max_chroma_iteration_count;
+    double      max_chroma_seconds; // all hues
+    float       max_chroma_error;
+};
+
+std::vector<SearchBenchmarkResult> benchmark_search_accuracy(
+                                        const std::vector<float>&        accuracies,
+                                        const SearchBenchmarkParameters& parameters = default_search_benchmark_parameters);
+
+} // namespace validation
@@ -0,0 +1,240 @@
+//
+//  SliceBenchmark.cpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#include <Validation/SliceBenchmark.hpp>
+#include <Graphics/GamutSlice.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+// • Local functions
+//===------------------------------------------------------------------------===
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    float hue_at(uint32_t index, uint32_t hue_count)
+    {
+        return -180.0f + 360.0f * (static_cast<float>(index) + 0.5f) / static_cast<float>(hue_count);
+    }
+
+    // • Point of the plane of Jz and chroma in which the slice is drawn
+    //
+    simd::float2 plane(simd::float4 vertex)
+    {
+        return simd::float2{ vertex[0], sqrtf(vertex[1]*vertex[1] + vertex[2]*vertex[2]) };
+    }
+
+    // • One boundary of a strip of `vertex_count` vertices: every other
+    //   vertex from `first` (0 lower, 1 upper), then the cusp
+    //
+    std::vector<simd::float2> boundary(const simd::float4* vertices, uint32_t vertex_count, uint32_t first)
+    {
+        auto points = std::vector<simd::float2>{};
+
+        for (uint32_t iv = first; iv + 1 < vertex_count; iv += 2)
+        {
+            points.push_back( plane(vertices[iv]) );
+        }
+
+        points.push_back( plane(vertices[vertex_count - 1]) );
+
+        return points;
+    }
+
+    float segment_distance(simd::float2 point, simd::float2 a, simd::float2 b)
+    {
+        const auto ab = b - a;
+        const auto dd = simd::dot(ab, ab);
+        const auto t  = (0.0f < dd) ? std::clamp(simd::dot(point - a, ab) / dd, 0.0f, 1.0f) : 0.0f;
+
+        return simd::length( point - (a + t*ab) );
+    }
+
+    // • Largest distance from the points of `reference` to the polyline
+    //   through `points`
+    //
+    float polyline_error(const std::vector<simd::float2>& reference, const std::vector<simd::float2>& points)
+    {
+        auto error = 0.0f;
+
+        for (const auto point : reference)
+        {
+            auto nearest = std::numeric_limits<float>::max();
+
+            for (size_t is = 0; is + 1 < points.size(); ++is)
+            {
+                nearest = std::min( nearest, segment_distance(point, points[is], points[is + 1]) );
+            }
+
+            error = std::max(error, nearest);
+        }
+
+        return error;
+    }
+
+} // namespace <anonymous>
+
+//===------------------------------------------------------------------------===
+// • benchmark_slice_bands
+//===------------------------------------------------------------------------===
+
+std::vector<SliceBenchmarkResult> benchmark_slice_bands(const std::vector<uint32_t>&    band_counts,
+                                                        const std::vector<float>&       error_budgets,
+                                                        const SliceBenchmarkParameters& parameters)
+{
+    const auto hue_count = std::max(parameters.hue_count, 1u);
+
+    // • Reference boundaries, from the colors every strip shares
+    //
+    const auto reference_slice = jzazbz::SliceParameters{
+        .band_count = std::max(parameters.reference_band_count, 1u),
+        .lane_count = jzazbz::default_slice_parameters.lane_count,
+        .accuracy   = jzazbz::default_slice_parameters.accuracy
+    };
+
+    const auto reference_vertex_count = jzazbz::slice_vertex_count(reference_slice);
+
+    auto colors    = std::vector<simd::float3>(hue_count);
+    auto lowers    = std::vector<std::vector<simd::float2>>(hue_count);
+    auto uppers    = std::vector<std::vector<simd::float2>>(hue_count);
+    auto reference = std::vector<simd::float4>(reference_vertex_count);
+
+    for (uint32_t ih = 0; ih < hue_count; ++ih)
+    {
+        colors[ih] = jzazbz::find_max_chroma_color( hue_at(ih, hue_count) );
+
+        jzazbz::generate_slice_vertices(colors[ih], reference.data(), reference_slice);
+
+        lowers[ih] = boundary(reference.data(), reference_vertex_count, 0);
+        uppers[ih] = boundary(reference.data(), reference_vertex_count, 1);
+    }
+
+    // • One configuration: `generate` writes the strip of a hue and returns
+    //   its vertex count
+    //
+    const auto max_band_count = std::max( parameters.max_band_count,
+                                          band_counts.empty() ? 1u : *std::max_element(band_counts.begin(), band_counts.end()) );
+
+    auto vertices = std::vector<simd::float4>( jzazbz::slice_vertex_count(max_band_count) );
+
+    const auto measure = [&](SliceBenchmarkResult result, auto&& generate) {
+
+        auto vertex_total = 0.0;
+        auto error_total  = 0.0;
+        auto counts       = std::vector<uint32_t>(hue_count);
+
+        const auto start = Clock::now();
+
+        for (uint32_t ih = 0; ih < hue_count; ++ih)
+        {
+            counts[ih] = generate(colors[ih]);
+        }
+
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (uint32_t ih = 0; ih < hue_count; ++ih)
+        {
+            const auto vertex_count = generate(colors[ih]);
+            const auto error        = std::max( polyline_error( lowers[ih], boundary(vertices.data(), vertex_count, 0) ),
+                                                polyline_error( uppers[ih], boundary(vertices.data(), vertex_count, 1) ) );
+
+            vertex_total += vertex_count;
+            error_total  += error;
+
+            result.max_vertex_count = std::max(result.max_vertex_count, vertex_count);
+            result.max_error        = std::max(result.max_error, error);
+        }
+
+        result.mean_vertex_count = static_cast<float>( vertex_total / hue_count );
+        result.mean_error        = static_cast<float>( error_total / hue_count );
+
+        return result;
+    };
+
+    auto results = std::vector<SliceBenchmarkResult>{};
+
+    for (const auto band_count : band_counts)
+    {
+        const auto slice = jzazbz::SliceParameters{
+            .band_count = std::max(band_count, 1u),
+            .lane_count = jzazbz::default_slice_parameters.lane_count,
+            .accuracy   = jzazbz::default_slice_parameters.accuracy
+        };
+
+        const auto result = SliceBenchmarkResult{
+            .is_adaptive       = false,
+            .band_count        = slice.band_count,
+            .error_budget      = 0.0f,
+            .mean_vertex_count = 0.0f,
+            .max_vertex_count  = 0,
+            .mean_error        = 0.0f,
+            .max_error         = 0.0f,
+            .seconds           = 0.0
+        };
+
+        results.push_back( measure( result, [&](simd::float3 color) {
+
+            jzazbz::generate_slice_vertices(color, vertices.data(), slice);
+
+            return jzazbz::slice_vertex_count(slice);
+        }));
+    }
+
+    for (const auto error_budget : error_budgets)
+    {
+        const auto adaptive = jzazbz::AdaptiveSliceParameters{
+            .error_budget       = error_budget,
+            .initial_band_count = parameters.initial_band_count,
+            .max_band_count     = max_band_count
+        };
+
+        const auto result = SliceBenchmarkResult{
+            .is_adaptive       = true,
+            .band_count        = 0,
+            .error_budget      = error_budget,
+            .mean_vertex_count = 0.0f,
+            .max_vertex_count  = 0,
+            .mean_error        = 0.0f,
+            .max_error         = 0.0f,
+            .seconds           = 0.0
+        };
+
+        results.push_back( measure( result, [&](simd::float3 color) {
+
+            return jzazbz::generate_adaptive_slice_vertices(color, vertices.data(), adaptive);
+        }));
+    }
+
+    return results;
+}
+
+} // namespace validation
@@ -0,0 +1,80 @@
+//
+//  SliceBenchmark.hpp
+//
+//  Copyright © 2024 Robert Guequierre
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//===------------------------------------------------------------------------===
+// • namespace validation
+//===------------------------------------------------------------------------===
+
+namespace validation
+{
+
+//===------------------------------------------------------------------------===
+//
+// • Slice band placement benchmark
+//
+//  Vertex count against error of the gamut slice strip: uniform bands
+//  (generate_slice_vertices, as the `generate_vertices` kernel) at each band
+//  count, and adaptive bands (generate_adaptive_slice_vertices, host only)
+//  at each error budget, over `hue_count` hues. The error of a strip is the
+//  largest distance, in the Jz/Cz plane, from the boundary of a reference
+//  strip of `reference_band_count` uniform bands to the matching boundary
+//  (lower or upper polyline, ending at the cusp) of the strip.
+//
+//===------------------------------------------------------------------------===
+
+struct SliceBenchmarkParameters
+{
+    uint32_t    hue_count;
+    uint32_t    reference_band_count;
+    uint32_t    initial_band_count;     // adaptive
+    uint32_t    max_band_count;         // adaptive
+};
+
+constexpr SliceBenchmarkParameters default_slice_benchmark_parameters = {
+    .hue_count            = 90,
+    .reference_band_count = 1024,
+    .initial_band_count   = 8,
+    .max_band_count       = 256
+};
+
+struct SliceBenchmarkResult
+{
+    bool        is_adaptive;
+    uint32_t    band_count;             // uniform; 0 when adaptive
+    float       error_budget;           // adaptive; 0 when uniform
+
+    float       mean_vertex_count;      // over hues
+    uint32_t    max_vertex_count;
+    float       mean_error;             // mean over hues of each strip's error
+    float       max_error;
+    double      seconds;                // all hues
+};
+
+std::vector<SliceBenchmarkResult> benchmark_slice_bands(
+                                        const std::vector<uint32_t>&    band_counts,
+                                        const std::vector<float>&       error_budgets,
+                                        const SliceBenchmarkParameters& parameters = default_slice_benchmark_parameters);
+
+} // namespace validation